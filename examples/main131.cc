@@ -0,0 +1,64 @@
+// main131.cc is a part of the PYTHIA event generator.
+// Copyright (C) 2020 Torbjorn Sjostrand.
+// PYTHIA is licenced under the GNU GPL v2 or later, see COPYING for details.
+// Please respect the MCnet Guidelines, see GUIDELINES for details.
+
+// Example how to generate events on several threads with PythiaParallel.
+// The XML database is read only once, and copied to all workers.
+// The charged multiplicity is first collected with a callback,
+// and then once more with the bounded event queue.
+
+#include "Pythia8/Pythia.h"
+#include "Pythia8Plugins/PythiaParallel.h"
+using namespace Pythia8;
+
+int main() {
+
+  // Number of events and threads.
+  int nEvent = 400;
+
+  // Common setup for all workers.
+  PythiaParallel pythia;
+  pythia.readString("Beams:eCM = 13000.");
+  pythia.readString("HardQCD:all = on");
+  pythia.readString("PhaseSpace:pTHatMin = 20.");
+  pythia.readString("Parallelism:numThreads = 4");
+  pythia.readString("Random:setSeed = on");
+  pythia.readString("Random:seed = 4711");
+  if (!pythia.init()) return 1;
+
+  // Histograms.
+  Hist multCallback("charged multiplicity, callback", 100, -0.5, 799.5);
+  Hist multQueue("charged multiplicity, queue", 100, -0.5, 799.5);
+
+  // Run with a callback. It is only called by one thread at a time.
+  pythia.run( nEvent, [&multCallback](Pythia& pythiaNow) {
+    int nCharged = 0;
+    for (int i = 0; i < pythiaNow.event.size(); ++i)
+      if (pythiaNow.event[i].isFinal() && pythiaNow.event[i].isCharged())
+        ++nCharged;
+    multCallback.fill( nCharged );
+  } );
+
+  // Run again, now picking up events from the queue in this thread.
+  pythia.startRun( nEvent, 20);
+  ParallelEvent parEvent;
+  while (pythia.nextEvent(parEvent)) {
+    int nCharged = 0;
+    for (int i = 0; i < parEvent.event.size(); ++i)
+      if (parEvent.event[i].isFinal() && parEvent.event[i].isCharged())
+        ++nCharged;
+    multQueue.fill( nCharged, parEvent.weight);
+  }
+
+  // Merged statistics and histograms.
+  pythia.stat();
+  cout << " Merged sigmaGen = " << scientific << setprecision(4)
+       << pythia.sigmaGen() << " +- " << pythia.sigmaErr() << " mb from "
+       << pythia.nAccepted() << " events on " << pythia.nWorkers()
+       << " threads" << endl;
+  cout << multCallback << multQueue;
+
+  // Done.
+  return 0;
+}
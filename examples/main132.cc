@@ -0,0 +1,86 @@
+// main132.cc is a part of the PYTHIA event generator.
+// Copyright (C) 2020 Torbjorn Sjostrand.
+// PYTHIA is licenced under the GNU GPL v2 or later, see COPYING for details.
+// Please respect the MCnet Guidelines, see GUIDELINES for details.
+
+// Benchmark of the number of memory allocations per event, for a
+// standard LHC minimum-bias run. The global operator new is replaced
+// by a version that counts the calls. The first events fill up the
+// event records and other containers, after which the number should
+// settle at a lower level, which is what matters for long runs.
+// Compare with an older PYTHIA version by linking to that library.
+
+#include "Pythia8/Pythia.h"
+#include <cstdlib>
+#include <new>
+using namespace Pythia8;
+
+// Counter of allocations, and replacement new and delete operators.
+static long nAlloc = 0;
+
+void* operator new(std::size_t size) {
+  ++nAlloc;
+  void* ptr = std::malloc(size > 0 ? size : 1);
+  if (ptr == 0) throw std::bad_alloc();
+  return ptr;
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+//==========================================================================
+
+int main() {
+
+  // Number of events, and number of first events listed separately.
+  int nEvent = 2000;
+  int nFirst = 10;
+
+  // Minimum-bias events at the LHC.
+  Pythia pythia;
+  pythia.readString("Beams:eCM = 13000.");
+  pythia.readString("SoftQCD:nonDiffractive = on");
+  pythia.readString("Next:numberCount = 0");
+  long nAllocInit = nAlloc;
+  if (!pythia.init()) return 1;
+  nAllocInit = nAlloc - nAllocInit;
+
+  // Histograms of allocations per event and event size.
+  Hist allocs("allocations per event, after warm-up", 100, 0., 20000.);
+  Hist sizes("event record size, after warm-up", 100, 0., 4000.);
+
+  // Begin event loop. Count allocations in each event.
+  long nAllocFirst = 0, nAllocRest = 0;
+  for (int iEvent = 0; iEvent < nEvent; ++iEvent) {
+    long nAllocBefore = nAlloc;
+    if (!pythia.next()) continue;
+    long nAllocNow = nAlloc - nAllocBefore;
+
+    // Warm-up events listed one by one, the rest histogrammed.
+    if (iEvent < nFirst) {
+      nAllocFirst += nAllocNow;
+      cout << " Event " << setw(3) << iEvent << " : " << setw(6)
+           << pythia.event.size() << " entries, " << setw(8) << nAllocNow
+           << " allocations" << endl;
+    } else {
+      nAllocRest += nAllocNow;
+      allocs.fill( nAllocNow);
+      sizes.fill( pythia.event.size());
+    }
+  }
+
+  // Statistics and summary.
+  pythia.stat();
+  cout << allocs << sizes;
+  cout << fixed << setprecision(1)
+       << "\n Allocations during initialization  : " << setw(10)
+       << double(nAllocInit)
+       << "\n Allocations per event, first events: " << setw(10)
+       << double(nAllocFirst) / nFirst
+       << "\n Allocations per event, after these : " << setw(10)
+       << double(nAllocRest) / (nEvent - nFirst)
+       << "\n Capacity of the event record       : " << setw(8)
+       << pythia.event.capacity() << endl;
+
+  // Done.
+  return 0;
+}
@@ -0,0 +1,120 @@
+// main133.cc is a part of the PYTHIA event generator.
+// Copyright (C) 2020 Torbjorn Sjostrand.
+// PYTHIA is licenced under the GNU GPL v2 or later, see COPYING for details.
+// Please respect the MCnet Guidelines, see GUIDELINES for details.
+
+// Microbenchmark of the batched PDF evaluation xfBatch, compared with
+// calling xf point by point, for some of the internal PDF classes.
+// Two access patterns are tested: a single random flavour at each
+// (x, Q2) point, as in MPI and ISR trials, and all flavours at each
+// point, as in a sum over incoming partons. Results should agree exactly.
+
+#include "Pythia8/Pythia.h"
+#include <ctime>
+using namespace Pythia8;
+
+//==========================================================================
+
+// Time the scalar and batched evaluation for one PDF and access pattern.
+
+void timePDF(PDF* pdfPtr, string name, string pattern,
+  const vector<int>& ids, const vector<double>& xs,
+  const vector<double>& Q2s, int nRepeat) {
+
+  // Scalar evaluation, one point at a time.
+  vector<double> xfScalar(ids.size()), xfBatched;
+  clock_t start = clock();
+  for (int iRep = 0; iRep < nRepeat; ++iRep)
+  for (int i = 0; i < int(ids.size()); ++i)
+    xfScalar[i] = pdfPtr->xf( ids[i], xs[i], Q2s[i]);
+  double tScalar = double(clock() - start) / CLOCKS_PER_SEC;
+
+  // Batched evaluation.
+  start = clock();
+  for (int iRep = 0; iRep < nRepeat; ++iRep)
+    pdfPtr->xfBatch( ids, xs, Q2s, xfBatched);
+  double tBatch = double(clock() - start) / CLOCKS_PER_SEC;
+
+  // Count differences.
+  int nDiff = 0;
+  for (int i = 0; i < int(ids.size()); ++i)
+    if (xfBatched[i] != xfScalar[i]) ++nDiff;
+
+  // Throughput in million evaluations per second.
+  double nEval = double(nRepeat) * ids.size();
+  cout << " | " << left << setw(10) << name << setw(14) << pattern
+       << right << fixed << setprecision(2) << setw(10)
+       << 1e-6 * nEval / max(1e-6, tScalar) << setw(10)
+       << 1e-6 * nEval / max(1e-6, tBatch) << setw(9)
+       << tScalar / max(1e-6, tBatch) << setw(8) << nDiff << " |\n";
+
+}
+
+//==========================================================================
+
+int main() {
+
+  // Number of points and repetitions.
+  int nPoint  = 100000;
+  int nRepeat = 5;
+
+  // Random number generator, and location of the PDF grids.
+  Rndm rndm(4711);
+  string xmlPath = "../share/Pythia8/xmldoc/";
+  Info info;
+
+  // The PDF classes to compare.
+  vector<PDF*>   pdfs;
+  vector<string> names;
+  pdfs.push_back( new LHAGrid1( 2212, "17", xmlPath, &info));
+  names.push_back( "LHAGrid1");
+  pdfs.push_back( new MSTWpdf( 2212, 3, xmlPath, &info));
+  names.push_back( "MSTWpdf");
+  pdfs.push_back( new CTEQ6pdf( 2212, 1, 1., xmlPath, &info));
+  names.push_back( "CTEQ6pdf");
+  pdfs.push_back( new CTEQ5L( 2212));
+  names.push_back( "CTEQ5L");
+
+  // Random (x, Q2) points, logarithmic in x and Q2.
+  int idList[13] = { 21, 1, -1, 2, -2, 3, -3, 4, -4, 5, -5, 22, 11};
+  vector<int>    idsOne, idsAll;
+  vector<double> xsOne, Q2sOne, xsAll, Q2sAll;
+  for (int i = 0; i < nPoint; ++i) {
+    double x  = pow( 1e-6, rndm.flat());
+    double Q2 = pow( 1e6, rndm.flat());
+    idsOne.push_back( idList[ min( 12, int(13. * rndm.flat())) ]);
+    xsOne.push_back( x);
+    Q2sOne.push_back( Q2);
+    if (i % 13 == 0) for (int j = 0; j < 13; ++j) {
+      idsAll.push_back( idList[j]);
+      xsAll.push_back( x);
+      Q2sAll.push_back( Q2);
+    }
+  }
+
+  // Header of table.
+  cout << "\n *-------  PYTHIA Batched PDF Evaluation Benchmark  "
+       << "-------------*\n"
+       << " |                                   "
+       << "                            |\n"
+       << " | PDF       pattern           scalar   batched"
+       << "  speedup    diff |\n"
+       << " |                              (M/s)     (M/s)"
+       << "                  |\n";
+
+  // Loop over PDFs and access patterns.
+  for (int iPDF = 0; iPDF < int(pdfs.size()); ++iPDF) {
+    timePDF( pdfs[iPDF], names[iPDF], "one flavour", idsOne, xsOne, Q2sOne,
+      nRepeat);
+    timePDF( pdfs[iPDF], names[iPDF], "all flavours", idsAll, xsAll, Q2sAll,
+      nRepeat);
+  }
+  cout << " |                                   "
+       << "                            |\n"
+       << " *-------  End PYTHIA Batched PDF Evaluation Benchmark  "
+       << "---------*" << endl;
+
+  // Done.
+  for (int iPDF = 0; iPDF < int(pdfs.size()); ++iPDF) delete pdfs[iPDF];
+  return 0;
+}
@@ -0,0 +1,98 @@
+// main134.cc is a part of the PYTHIA event generator.
+// Copyright (C) 2020 Torbjorn Sjostrand.
+// PYTHIA is licenced under the GNU GPL v2 or later, see COPYING for details.
+// Please respect the MCnet Guidelines, see GUIDELINES for details.
+
+// Example how to generate the sub-events of Angantyr heavy ion events
+// on several threads with AngantyrParallel. The same PbPb events are
+// first generated sequentially and then in parallel. Since each
+// non-diffractive sub-event has its own random number seed, the two
+// runs should give identical events, and only differ in timing.
+
+#include "Pythia8/Pythia.h"
+#include "Pythia8Plugins/AngantyrParallel.h"
+#include <chrono>
+using namespace Pythia8;
+
+//==========================================================================
+
+// Generate nEvent PbPb events with the given number of threads, where
+// zero means the default Angantyr object. Returns the charged
+// multiplicity of each event and the time spent in the event loop.
+
+double runPbPb(int nThreads, int nEvent, vector<int>& nCharged) {
+
+  // Setup of PbPb collisions, with a fixed sub-collision model to
+  // keep the initialization short.
+  Pythia pythia;
+  pythia.readString("Beams:idA = 1000822080");
+  pythia.readString("Beams:idB = 1000822080");
+  pythia.readString("Beams:eCM = 5020.");
+  pythia.readString("Beams:frameType = 1");
+  pythia.readString("HeavyIon:SigFitNGen = 0");
+  pythia.readString("HeavyIon:SigFitDefPar = 13.91,1.78,0.22,0.0,0.0,"
+                    "0.0,0.0,0.0");
+  pythia.readString("HeavyIon:bWidth = 3.");
+  pythia.readString("Angantyr:seedSubEvents = on");
+  pythia.readString("Next:numberCount = 0");
+  pythia.readString("Random:setSeed = on");
+  pythia.readString("Random:seed = 4711");
+
+  // Optionally hand in the parallel version of the Angantyr model.
+  AngantyrParallel* angantyrPtr = 0;
+  if (nThreads > 0) {
+    angantyrPtr = new AngantyrParallel(pythia, nThreads);
+    pythia.setHeavyIonsPtr(angantyrPtr);
+  }
+  if (!pythia.init()) return -1.;
+
+  // Event loop, with timing.
+  nCharged.clear();
+  auto start = std::chrono::steady_clock::now();
+  for (int iEvent = 0; iEvent < nEvent; ++iEvent) {
+    if (!pythia.next()) continue;
+    int nCh = 0;
+    for (int i = 0; i < pythia.event.size(); ++i)
+      if (pythia.event[i].isFinal() && pythia.event[i].isCharged()) ++nCh;
+    nCharged.push_back(nCh);
+  }
+  auto stop = std::chrono::steady_clock::now();
+
+  // Done.
+  pythia.stat();
+  delete angantyrPtr;
+  return std::chrono::duration<double>(stop - start).count();
+
+}
+
+//==========================================================================
+
+int main() {
+
+  // Number of events and threads.
+  int nEvent   = 5;
+  int nThreads = 4;
+
+  // Sequential and parallel runs.
+  vector<int> nChSeq, nChPar;
+  double tSeq = runPbPb(0, nEvent, nChSeq);
+  double tPar = runPbPb(nThreads, nEvent, nChPar);
+  if (tSeq < 0. || tPar < 0.) return 1;
+
+  // Compare the events and the timing.
+  cout << "\n   Event   nCharged (1 thread)   nCharged (" << nThreads
+       << " threads)\n";
+  int nDiff = 0;
+  for (int i = 0; i < int(max(nChSeq.size(), nChPar.size())); ++i) {
+    int nSeq = (i < int(nChSeq.size())) ? nChSeq[i] : -1;
+    int nPar = (i < int(nChPar.size())) ? nChPar[i] : -1;
+    if (nSeq != nPar) ++nDiff;
+    cout << setw(8) << i << setw(21) << nSeq << setw(22) << nPar << "\n";
+  }
+  cout << fixed << setprecision(2) << "\n Time sequential: " << tSeq
+       << " s, parallel: " << tPar << " s, speedup: " << tSeq / tPar
+       << "\n Events that differ: " << nDiff << endl;
+
+  // Done.
+  return 0;
+}
@@ -0,0 +1,90 @@
+// main135.cc is a part of the PYTHIA event generator.
+// Copyright (C) 2020 Torbjorn Sjostrand.
+// PYTHIA is licenced under the GNU GPL v2 or later, see COPYING for details.
+// Please respect the MCnet Guidelines, see GUIDELINES for details.
+
+// Benchmark of the Glauber step of the Angantyr model, i.e. the
+// generation of nuclei, impact parameter and nucleon-nucleon
+// sub-collisions, using Angantyr:GlauberOnly = on for PbPb collisions.
+// The throughput is given for each of the internal sub-collision
+// models, together with the average number of sub-collisions.
+// Compare with an older PYTHIA version by linking to that library.
+
+#include "Pythia8/Pythia.h"
+#include "Pythia8/HeavyIons.h"
+#include <ctime>
+using namespace Pythia8;
+
+//==========================================================================
+
+int main() {
+
+  // Number of events per model.
+  int nEvent = 2000;
+
+  // The sub-collision models to compare.
+  int    models[4] = { 0, 1, 2, 3};
+  string names[4]  = { "Naive", "DoubleStrikman", "DoubleStrikman(1)",
+                       "Black"};
+
+  // Header of table.
+  cout << "\n *-------  PYTHIA Angantyr Glauber-only Benchmark  "
+       << "----------------*\n"
+       << " |                                   "
+       << "                            |\n"
+       << " | Model                    events/s   sub-coll.     absorptive |\n"
+       << " |                                   "
+       << "                            |\n";
+
+  for (int iModel = 0; iModel < 4; ++iModel) {
+
+    // PbPb collisions with a fixed sub-collision model, to keep the
+    // initialization short.
+    Pythia pythia("../share/Pythia8/xmldoc", false);
+    pythia.readString("Beams:idA = 1000822080");
+    pythia.readString("Beams:idB = 1000822080");
+    pythia.readString("Beams:eCM = 5020.");
+    pythia.readString("Beams:frameType = 1");
+    pythia.readString("HeavyIon:SigFitNGen = 0");
+    pythia.readString("HeavyIon:SigFitDefPar = 13.91,1.78,0.22,0.0,0.0,"
+                      "0.0,0.0,0.0");
+    pythia.readString("HeavyIon:SigFitPrint = off");
+    pythia.readString("HeavyIon:showInit = off");
+    pythia.readString("Angantyr:GlauberOnly = on");
+    pythia.settings.mode("Angantyr:CollisionModel", models[iModel]);
+    pythia.readString("PartonLevel:all = off");
+    pythia.readString("Next:numberCount = 0");
+    pythia.readString("Init:showProcesses = off");
+    pythia.readString("Init:showMultipartonInteractions = off");
+    pythia.readString("Init:showChangedSettings = off");
+    pythia.readString("Init:showChangedParticleData = off");
+    if (!pythia.init()) return 1;
+
+    // Event loop, counting the sub-collisions.
+    double nColl = 0., nAbs = 0.;
+    clock_t start = clock();
+    for (int iEvent = 0; iEvent < nEvent; ++iEvent) {
+      pythia.next();
+      const vector<SubCollision>& subColls
+        = *pythia.info.hiinfo->subCollisionsPtr();
+      nColl += subColls.size();
+      for (int i = 0; i < int(subColls.size()); ++i)
+        if (subColls[i].type == SubCollision::ABS) ++nAbs;
+    }
+    double t = double(clock() - start) / CLOCKS_PER_SEC;
+
+    // One line per model.
+    cout << " | " << left << setw(22) << names[iModel] << right << fixed
+         << setprecision(0) << setw(11) << nEvent / max(1e-6, t)
+         << setprecision(1) << setw(12) << nColl / nEvent << setw(15)
+         << nAbs / nEvent << " |\n";
+  }
+
+  cout << " |                                   "
+       << "                            |\n"
+       << " *-------  End PYTHIA Angantyr Glauber-only Benchmark  "
+       << "-----------*" << endl;
+
+  // Done.
+  return 0;
+}
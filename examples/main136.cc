@@ -0,0 +1,102 @@
+// main136.cc is a part of the PYTHIA event generator.
+// Copyright (C) 2020 Torbjorn Sjostrand.
+// PYTHIA is licenced under the GNU GPL v2 or later, see COPYING for details.
+// Please respect the MCnet Guidelines, see GUIDELINES for details.
+
+// Example how to store events in the compact binary format of
+// EventColumns.h, and to rerun an analysis on the stored events.
+// The analysis, the multiplicity and summed pT of final particles, is
+// done on the generated events, and then again on the columns read
+// back from file, without the construction of Particle objects.
+// The first event is also converted back to an Event and compared.
+// If PYTHIA is configured with gzip support, blocks are compressed.
+
+#include "Pythia8/Pythia.h"
+#include "Pythia8Plugins/EventColumns.h"
+#include <ctime>
+using namespace Pythia8;
+
+//==========================================================================
+
+int main() {
+
+  // Number of events, and name of the file.
+  int    nEvent   = 1000;
+  string fileName = "main136.dat";
+  bool   compress = true;
+
+  // Minimum-bias events at the LHC.
+  Pythia pythia;
+  pythia.readString("Beams:eCM = 13000.");
+  pythia.readString("SoftQCD:nonDiffractive = on");
+  pythia.readString("Next:numberCount = 0");
+  if (!pythia.init()) return 1;
+
+  // Generate the events, analyze and write them to file.
+  EventColumnsWriter writer(fileName, 500, compress);
+  Event firstEvent;
+  long   nFinalGen = 0;
+  double sumPTGen  = 0.;
+  double tWrite    = 0.;
+  for (int iEvent = 0; iEvent < nEvent; ++iEvent) {
+    if (!pythia.next()) continue;
+    for (int i = 0; i < pythia.event.size(); ++i)
+    if (pythia.event[i].isFinal()) {
+      ++nFinalGen;
+      sumPTGen += pythia.event[i].pT();
+    }
+    if (iEvent == 0) firstEvent = pythia.event;
+    clock_t start = clock();
+    writer.writeEvent(pythia);
+    tWrite += double(clock() - start) / CLOCKS_PER_SEC;
+  }
+  writer.close();
+  pythia.stat();
+
+  // Read the events back, and repeat the analysis on the columns.
+  clock_t start = clock();
+  EventColumnsReader reader(fileName);
+  if (!reader.isOpen()) return 1;
+  long   nFinalRead = 0;
+  double sumPTRead  = 0.;
+  while (reader.next()) {
+    const int*    status = reader.column(EventColumnsReader::STATUS);
+    const double* px     = reader.column(EventColumnsReader::PX);
+    const double* py     = reader.column(EventColumnsReader::PY);
+    for (int i = 0; i < reader.size(); ++i) if (status[i] > 0) {
+      ++nFinalRead;
+      sumPTRead += sqrt(px[i] * px[i] + py[i] * py[i]);
+    }
+  }
+  double tRead = double(clock() - start) / CLOCKS_PER_SEC;
+
+  // Convert the first event back to an event record, and compare.
+  Event event;
+  event.init("(read back from file)", &pythia.particleData);
+  reader.goToEvent(0);
+  reader.fillEvent(event);
+  int nDiff = (event.size() == firstEvent.size()) ? 0 : 1;
+  for (int i = 0; i < min(event.size(), firstEvent.size()); ++i)
+    if (event[i].id() != firstEvent[i].id()
+      || event[i].mother1() != firstEvent[i].mother1()
+      || event[i].px() != firstEvent[i].px()
+      || event[i].e() != firstEvent[i].e()) ++nDiff;
+  event.list();
+
+  // Summary.
+  ifstream is(fileName.c_str(), ios::binary | ios::ate);
+  double fileSize = is.tellg();
+  cout << fixed << setprecision(3)
+       << "\n Events stored           : " << setw(12) << reader.nEvent()
+       << "\n File size per event (kB): " << setw(12)
+       << 1e-3 * fileSize / max(1L, reader.nEvent())
+       << "\n Write time (s)          : " << setw(12) << tWrite
+       << "\n Read and analyze (s)    : " << setw(12) << tRead
+       << "\n Final particles, generated: " << nFinalGen << ", read: "
+       << nFinalRead << "\n Summed pT, generated: " << sumPTGen
+       << ", read: " << sumPTRead
+       << "\n Differences in first event: " << nDiff << endl;
+
+  // Done.
+  return 0;
+}
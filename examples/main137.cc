@@ -0,0 +1,91 @@
+// main137.cc is a part of the PYTHIA event generator.
+// Copyright (C) 2020 Torbjorn Sjostrand.
+// PYTHIA is licenced under the GNU GPL v2 or later, see COPYING for details.
+// Please respect the MCnet Guidelines, see GUIDELINES for details.
+
+// Example how to read Les Houches Event Files on a background thread
+// with LHAupLHEFPrefetch. The same file, with many reweighting weights
+// per event, is first processed with the standard reader and then with
+// the prefetching one. The events and weights should be identical, and
+// only the time spent waiting for the file should differ.
+
+#include "Pythia8/Pythia.h"
+#include "Pythia8Plugins/LHAupLHEFPrefetch.h"
+#include <chrono>
+using namespace Pythia8;
+
+//==========================================================================
+
+// Process the file, optionally with the prefetching reader. Returns the
+// time spent, and fills the charged multiplicity and summed weights.
+
+double runLHEF(bool prefetch, vector<int>& nCharged, vector<double>& wSum) {
+
+  // Setup: read the file, skipping the first events.
+  Pythia pythia;
+  pythia.readString("Beams:frameType = 4");
+  pythia.readString("Beams:LHEF = wbj_lhef3.lhe");
+  pythia.readString("Beams:nSkipLHEFatInit = 5");
+  pythia.readString("Next:numberCount = 0");
+  pythia.readString("Random:setSeed = on");
+  pythia.readString("Random:seed = 4711");
+
+  // Optionally hand in the prefetching reader, with 32 buffered events.
+  LHAupLHEFPrefetch* lhaPtr = 0;
+  if (prefetch) {
+    lhaPtr = new LHAupLHEFPrefetch(&pythia.info, "wbj_lhef3.lhe", 32);
+    pythia.readString("Beams:frameType = 5");
+    pythia.setLHAupPtr(lhaPtr);
+  }
+  if (!pythia.init()) return -1.;
+
+  // Event loop until the end of the file, with timing.
+  nCharged.clear();
+  wSum.clear();
+  auto start = std::chrono::steady_clock::now();
+  while (true) {
+    if (!pythia.next()) {
+      if (pythia.info.atEndOfFile()) break;
+      continue;
+    }
+    int nCh = 0;
+    for (int i = 0; i < pythia.event.size(); ++i)
+      if (pythia.event[i].isFinal() && pythia.event[i].isCharged()) ++nCh;
+    nCharged.push_back(nCh);
+    double w = 0.;
+    for (int i = 0; i < int(pythia.info.weights_detailed_vector.size()); ++i)
+      w += pythia.info.weights_detailed_vector[i];
+    wSum.push_back(w);
+  }
+  auto stop = std::chrono::steady_clock::now();
+
+  // Done.
+  pythia.stat();
+  delete lhaPtr;
+  return std::chrono::duration<double>(stop - start).count();
+
+}
+
+//==========================================================================
+
+int main() {
+
+  // Standard and prefetching runs.
+  vector<int>    nChStd, nChPre;
+  vector<double> wStd, wPre;
+  double tStd = runLHEF(false, nChStd, wStd);
+  double tPre = runLHEF(true, nChPre, wPre);
+  if (tStd < 0. || tPre < 0.) return 1;
+
+  // Compare the events and the timing.
+  int nDiff = (nChStd.size() == nChPre.size()) ? 0 : 1;
+  for (int i = 0; i < int(min(nChStd.size(), nChPre.size())); ++i)
+    if (nChStd[i] != nChPre[i] || wStd[i] != wPre[i]) ++nDiff;
+  cout << fixed << setprecision(3) << "\n Events read: standard "
+       << nChStd.size() << ", prefetch " << nChPre.size()
+       << "\n Time standard: " << tStd << " s, prefetch: " << tPre
+       << " s\n Events that differ: " << nDiff << endl;
+
+  // Done.
+  return 0;
+}
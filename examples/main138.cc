@@ -0,0 +1,180 @@
+// main138.cc is a part of the PYTHIA event generator.
+// Copyright (C) 2020 Torbjorn Sjostrand.
+// PYTHIA is licenced under the GNU GPL v2 or later, see COPYING for details.
+// Please respect the MCnet Guidelines, see GUIDELINES for details.
+
+// Microbenchmark of the batch kernels for rotations and boosts.
+// Whole events are transformed one particle at a time, with
+// Particle::rotbst and Particle::bst, and then in one go with
+// Event::rotbst and Event::bst. The same comparison is made for an
+// array of Vec4, with Vec4::rotbst and Vec4::bst for each four-vector
+// against RotBstMatrix::apply and the array version of Vec4::bst.
+// The results of the two methods should agree exactly, and the
+// throughput is given in millions of four-vectors per second.
+
+#include "Pythia8/Pythia.h"
+#include <ctime>
+using namespace Pythia8;
+
+//==========================================================================
+
+// Time in seconds since start.
+
+double secondsSince(clock_t start) {
+  return double(clock() - start) / CLOCKS_PER_SEC;
+}
+
+//==========================================================================
+
+int main() {
+
+  // Number of stored events and of passes over them. The events are
+  // few enough to stay in the cache, as in the generation itself.
+  int nEvent = 10;
+  int nPass  = 2000;
+
+  // Minimum-bias events at the LHC, with production vertices.
+  Pythia pythia;
+  pythia.readString("Beams:eCM = 13000.");
+  pythia.readString("SoftQCD:nonDiffractive = on");
+  pythia.readString("Fragmentation:setVertices = on");
+  pythia.readString("Next:numberCount = 0");
+  if (!pythia.init()) return 1;
+  vector<Event> events;
+  vector<Vec4>  vecs;
+  long nVec = 0;
+  for (int iEvent = 0; iEvent < nEvent; ++iEvent) {
+    if (!pythia.next()) continue;
+    events.push_back(pythia.event);
+    nVec += pythia.event.size();
+    for (int i = 0; i < pythia.event.size(); ++i) {
+      if (pythia.event[i].hasVertex()) ++nVec;
+      vecs.push_back(pythia.event[i].p());
+    }
+  }
+  pythia.stat();
+
+  // A rotation followed by a boost, and its inverse. A pure boost.
+  RotBstMatrix M;
+  M.rot(0.7, 1.9);
+  M.bst(0.1, -0.2, 0.6);
+  RotBstMatrix Minv = M.inverse();
+  double betaX = 0.3, betaY = 0.1, betaZ = -0.5;
+  double gamma = 1. / sqrt(1. - betaX*betaX - betaY*betaY - betaZ*betaZ);
+
+  // Check that one at a time and in one go agree exactly.
+  int nDiff = 0;
+  for (int iEvent = 0; iEvent < int(events.size()); ++iEvent) {
+    Event one = events[iEvent], all = events[iEvent];
+    for (int i = 0; i < one.size(); ++i) one[i].rotbst(M);
+    for (int i = 0; i < one.size(); ++i) one[i].bst(betaX, betaY, betaZ);
+    all.rotbst(M);
+    all.bst(betaX, betaY, betaZ);
+    for (int i = 0; i < one.size(); ++i)
+      if (one[i].px() != all[i].px() || one[i].e() != all[i].e()
+        || one[i].zProd() != all[i].zProd()
+        || one[i].tProd() != all[i].tProd()) ++nDiff;
+  }
+  vector<Vec4> vecsOne = vecs, vecsAll = vecs;
+  for (int i = 0; i < int(vecs.size()); ++i) {
+    vecsOne[i].rotbst(M);
+    vecsOne[i].bst(betaX, betaY, betaZ, gamma);
+  }
+  M.apply(&vecsAll[0], vecs.size());
+  Vec4::bst(&vecsAll[0], vecs.size(), betaX, betaY, betaZ, gamma);
+  for (int i = 0; i < int(vecs.size()); ++i)
+    if (vecsOne[i].px() != vecsAll[i].px()
+      || vecsOne[i].e() != vecsAll[i].e()) ++nDiff;
+
+  // Rotation and boost of events, one particle at a time, and in one go.
+  // Passes alternate between the matrix and its inverse.
+  clock_t start = clock();
+  for (int iPass = 0; iPass < nPass; ++iPass) {
+    const RotBstMatrix& Mnow = (iPass%2 == 0) ? M : Minv;
+    for (int iEvent = 0; iEvent < int(events.size()); ++iEvent) {
+      Event& event = events[iEvent];
+      for (int i = 0; i < event.size(); ++i) event[i].rotbst(Mnow);
+    }
+  }
+  double tRotOne = secondsSince(start);
+  start = clock();
+  for (int iPass = 0; iPass < nPass; ++iPass) {
+    const RotBstMatrix& Mnow = (iPass%2 == 0) ? M : Minv;
+    for (int iEvent = 0; iEvent < int(events.size()); ++iEvent)
+      events[iEvent].rotbst(Mnow);
+  }
+  double tRotAll = secondsSince(start);
+
+  // Pure boosts of events, back and forth.
+  start = clock();
+  for (int iPass = 0; iPass < nPass; ++iPass) {
+    double sign = (iPass%2 == 0) ? 1. : -1.;
+    for (int iEvent = 0; iEvent < int(events.size()); ++iEvent) {
+      Event& event = events[iEvent];
+      for (int i = 0; i < event.size(); ++i)
+        event[i].bst(sign * betaX, sign * betaY, sign * betaZ, gamma);
+    }
+  }
+  double tBstOne = secondsSince(start);
+  start = clock();
+  for (int iPass = 0; iPass < nPass; ++iPass) {
+    double sign = (iPass%2 == 0) ? 1. : -1.;
+    for (int iEvent = 0; iEvent < int(events.size()); ++iEvent)
+      events[iEvent].bst(sign * betaX, sign * betaY, sign * betaZ, gamma);
+  }
+  double tBstAll = secondsSince(start);
+
+  // Rotation and boost of a plain array of four-vectors.
+  int nArr = vecs.size();
+  start = clock();
+  for (int iPass = 0; iPass < nPass; ++iPass) {
+    const RotBstMatrix& Mnow = (iPass%2 == 0) ? M : Minv;
+    for (int i = 0; i < nArr; ++i) vecs[i].rotbst(Mnow);
+  }
+  double tArrOne = secondsSince(start);
+  start = clock();
+  for (int iPass = 0; iPass < nPass; ++iPass) {
+    const RotBstMatrix& Mnow = (iPass%2 == 0) ? M : Minv;
+    Mnow.apply(&vecs[0], nArr);
+  }
+  double tArrAll = secondsSince(start);
+
+  // Pure boosts of a plain array of four-vectors.
+  start = clock();
+  for (int iPass = 0; iPass < nPass; ++iPass) {
+    double sign = (iPass%2 == 0) ? 1. : -1.;
+    for (int i = 0; i < nArr; ++i)
+      vecs[i].bst(sign * betaX, sign * betaY, sign * betaZ, gamma);
+  }
+  double tArrBstOne = secondsSince(start);
+  start = clock();
+  for (int iPass = 0; iPass < nPass; ++iPass) {
+    double sign = (iPass%2 == 0) ? 1. : -1.;
+    Vec4::bst(&vecs[0], nArr, sign * betaX, sign * betaY, sign * betaZ,
+      gamma);
+  }
+  double tArrBstAll = secondsSince(start);
+
+  // Summary, in million four-vectors per second.
+  double nEvtVec = 1e-6 * nPass * nVec;
+  double nArrVec = 1e-6 * nPass * nArr;
+  cout << fixed << setprecision(1)
+       << "\n Throughput (10^6 four-vectors/s)  one-by-one  in one go"
+       << "\n Event rotation and boost        : " << setw(10)
+       << nEvtVec / max(1e-6, tRotOne) << setw(11)
+       << nEvtVec / max(1e-6, tRotAll)
+       << "\n Event boost                     : " << setw(10)
+       << nEvtVec / max(1e-6, tBstOne) << setw(11)
+       << nEvtVec / max(1e-6, tBstAll)
+       << "\n Vec4 array rotation and boost   : " << setw(10)
+       << nArrVec / max(1e-6, tArrOne) << setw(11)
+       << nArrVec / max(1e-6, tArrAll)
+       << "\n Vec4 array boost                : " << setw(10)
+       << nArrVec / max(1e-6, tArrBstOne) << setw(11)
+       << nArrVec / max(1e-6, tArrBstAll)
+       << "\n Four-vectors that differ        : " << setw(10) << nDiff
+       << endl;
+
+  // Done.
+  return 0;
+}
@@ -0,0 +1,115 @@
+// main139.cc is a part of the PYTHIA event generator.
+// Copyright (C) 2020 Torbjorn Sjostrand.
+// PYTHIA is licenced under the GNU GPL v2 or later, see COPYING for details.
+// Please respect the MCnet Guidelines, see GUIDELINES for details.
+
+// Comparison of the two internal random number engines, the default
+// Marsaglia-Zaman-Tsang one and the optional xoshiro128++ one.
+// Random numbers are generated one at a time with Rndm::flat() and in
+// arrays with Rndm::flat(double*, int), and the throughput is given in
+// millions of numbers per second. It is checked that both ways give the
+// same numbers, that the state can be saved and restored, and that
+// substreams from the same seed differ. Finally some events are
+// generated with each engine, with the xoshiro128++ one in substream 3.
+
+#include "Pythia8/Pythia.h"
+#include <ctime>
+using namespace Pythia8;
+
+//==========================================================================
+
+// Time in seconds since start.
+
+double secondsSince(clock_t start) {
+  return double(clock() - start) / CLOCKS_PER_SEC;
+}
+
+//==========================================================================
+
+int main() {
+
+  // Number of random numbers in each array, and of arrays.
+  const int nArr  = 1000;
+  int       nPass = 50000;
+  double    nRndm = 1e-6 * nArr * nPass;
+  double    arr[nArr];
+
+  for (int engine = 0; engine < 2; ++engine) {
+    Rndm rndm;
+    rndm.init( 4711, engine);
+
+    // Check that one at a time and in one go agree exactly.
+    Rndm rndmOne, rndmAll;
+    rndmOne.init( 1234, engine);
+    rndmAll.init( 1234, engine);
+    rndmAll.flat( arr, nArr);
+    int nDiff = 0;
+    for (int i = 0; i < nArr; ++i) if (rndmOne.flat() != arr[i]) ++nDiff;
+
+    // Check that the state can be saved and restored.
+    rndmAll.dumpState("main139.rndm");
+    double rSave = rndmAll.flat();
+    rndmAll.readState("main139.rndm");
+    if (rndmAll.flat() != rSave || rndmAll.engine() != engine) ++nDiff;
+
+    // Check that a substream differs from the main one.
+    Rndm rndmJump;
+    rndmJump.init( 1234, engine);
+    bool jumped = rndmJump.longJump(1);
+    if (jumped) {
+      rndmJump.flat( arr, nArr);
+      for (int i = 0; i < nArr; ++i) if (rndmAll.flat() == arr[i]) ++nDiff;
+    }
+
+    // Time generation one at a time and in one go.
+    double sum = 0.;
+    clock_t start = clock();
+    for (int iPass = 0; iPass < nPass; ++iPass)
+      for (int i = 0; i < nArr; ++i) sum += rndm.flat();
+    double tOne = secondsSince(start);
+    start = clock();
+    for (int iPass = 0; iPass < nPass; ++iPass) {
+      rndm.flat( arr, nArr);
+      for (int i = 0; i < nArr; ++i) sum += arr[i];
+    }
+    double tAll = secondsSince(start);
+
+    // Summary, in million random numbers per second.
+    cout << fixed << setprecision(1) << "\n Engine " << engine
+         << (engine == 0 ? " (Marsaglia-Zaman-Tsang)" : " (xoshiro128++)")
+         << "\n Throughput (10^6 numbers/s), one at a time: " << setw(8)
+         << nRndm / max(1e-6, tOne) << ", in one go: " << setw(8)
+         << nRndm / max(1e-6, tAll) << "\n Average: " << setprecision(5)
+         << sum / (2. * nArr * nPass) << ", substreams available: "
+         << (jumped ? "yes" : "no") << ", failed checks: " << nDiff << endl;
+  }
+
+  // Generate some events with each engine.
+  for (int engine = 0; engine < 2; ++engine) {
+    Pythia pythia;
+    pythia.readString("Beams:eCM = 13000.");
+    pythia.readString("SoftQCD:nonDiffractive = on");
+    pythia.readString("Next:numberCount = 0");
+    pythia.readString("Random:setSeed = on");
+    pythia.readString("Random:seed = 4711");
+    if (engine == 1) {
+      pythia.readString("Random:engine = 1");
+      pythia.readString("Random:stream = 3");
+    }
+    if (!pythia.init()) return 1;
+    double nCh = 0.;
+    clock_t start = clock();
+    for (int iEvent = 0; iEvent < 200; ++iEvent) {
+      if (!pythia.next()) continue;
+      for (int i = 0; i < pythia.event.size(); ++i)
+        if (pythia.event[i].isFinal() && pythia.event[i].isCharged()) ++nCh;
+    }
+    pythia.stat();
+    cout << fixed << setprecision(2) << "\n Engine " << engine
+         << ": average charged multiplicity " << nCh / 200.
+         << ", time " << secondsSince(start) << " s" << endl;
+  }
+
+  // Done.
+  return 0;
+}
@@ -0,0 +1,99 @@
+// main140.cc is a part of the PYTHIA event generator.
+// Copyright (C) 2020 Torbjorn Sjostrand.
+// PYTHIA is licenced under the GNU GPL v2 or later, see COPYING for details.
+// Please respect the MCnet Guidelines, see GUIDELINES for details.
+
+// Example how to run the trial showers of CKKW-L merging on several
+// threads with the MergingParallel class. W + 2 jets events are merged
+// with the trial showers of each event first run one after the other,
+// with Merging:seedTrialShowers = on, and then spread over four threads.
+// The event weights and events should be identical, and only the time
+// spent should differ.
+
+#include "Pythia8/Pythia.h"
+#include "Pythia8Plugins/MergingParallel.h"
+#include <chrono>
+using namespace Pythia8;
+
+//==========================================================================
+
+// Generate the events, optionally with parallel trial showers. Returns
+// the time spent, and fills the event weights and multiplicities.
+
+double runMerging(int nThreads, vector<double>& weights,
+  vector<int>& nFinal) {
+
+  // Setup: kT merging of W + 2 jets, as in main81.
+  Pythia pythia;
+  pythia.readString("Beams:frameType = 4");
+  pythia.readString("Beams:LHEF = w+_production_lhc_2.lhe");
+  pythia.readString("HadronLevel:all = off");
+  pythia.readString("Merging:doKTMerging = on");
+  pythia.readString("Merging:ktType = 2");
+  pythia.readString("Merging:Process = pp>e+ve");
+  pythia.readString("Merging:TMS = 30.");
+  pythia.readString("Merging:nJetMax = 2");
+  pythia.readString("Merging:seedTrialShowers = on");
+  pythia.readString("Next:numberCount = 0");
+  pythia.readString("Random:setSeed = on");
+  pythia.readString("Random:seed = 4711");
+
+  // Optionally hand in the parallel merging object.
+  MergingParallel* mergingPtr = 0;
+  if (nThreads > 1) {
+    mergingPtr = new MergingParallel(nThreads);
+    pythia.setMergingPtr(mergingPtr);
+  }
+  if (!pythia.init()) return -1.;
+
+  // Event loop, with timing.
+  weights.clear();
+  nFinal.clear();
+  auto start = std::chrono::steady_clock::now();
+  for (int iEvent = 0; iEvent < 200; ++iEvent) {
+    if (!pythia.next()) {
+      if (pythia.info.atEndOfFile()) break;
+      continue;
+    }
+    weights.push_back(pythia.info.weight());
+    int nFin = 0;
+    for (int i = 0; i < pythia.event.size(); ++i)
+      if (pythia.event[i].isFinal()) ++nFin;
+    nFinal.push_back(nFin);
+  }
+  auto stop = std::chrono::steady_clock::now();
+
+  // Done.
+  pythia.stat();
+  delete mergingPtr;
+  return std::chrono::duration<double>(stop - start).count();
+
+}
+
+//==========================================================================
+
+int main() {
+
+  // Sequential and parallel runs.
+  vector<double> wSeq, wPar;
+  vector<int>    nSeq, nPar;
+  double tSeq = runMerging(1, wSeq, nSeq);
+  double tPar = runMerging(4, wPar, nPar);
+  if (tSeq < 0. || tPar < 0.) return 1;
+
+  // Compare the events and the timing.
+  int nDiff = (wSeq.size() == wPar.size()) ? 0 : 1;
+  double wSum = 0.;
+  for (int i = 0; i < int(min(wSeq.size(), wPar.size())); ++i) {
+    if (wSeq[i] != wPar[i] || nSeq[i] != nPar[i]) ++nDiff;
+    wSum += wSeq[i];
+  }
+  cout << fixed << setprecision(3) << "\n Events: sequential "
+       << wSeq.size() << ", parallel " << wPar.size()
+       << "\n Average event weight: " << wSum / max(1, int(wSeq.size()))
+       << "\n Time sequential: " << tSeq << " s, 4 threads: " << tPar
+       << " s\n Events that differ: " << nDiff << endl;
+
+  // Done.
+  return 0;
+}
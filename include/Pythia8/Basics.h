@@ -39,7 +39,7 @@ public:
 
 // Rndm class.
 // This class handles random number generation according to the
-// Marsaglia-Zaman-Tsang algorithm.
+// Marsaglia-Zaman-Tsang algorithm, or optionally the xoshiro128++ one.
 
 class Rndm {
 
@@ -47,19 +47,36 @@ public:
 
   // Constructors.
   Rndm() : initRndm(false), i97(), j97(), seedSave(0), sequence(0), u(), c(),
-    cd(), cm(), useExternalRndm(false), rndmEngPtr(0) { }
+    cd(), cm(), engineSave(0), xs(), useExternalRndm(false), rndmEngPtr(0) { }
   Rndm(int seedIn) : initRndm(false), i97(), j97(), seedSave(0), sequence(0),
-    u(), c(), cd(), cm(), useExternalRndm(false), rndmEngPtr(0) {init(seedIn);}
+    u(), c(), cd(), cm(), engineSave(0), xs(), useExternalRndm(false),
+    rndmEngPtr(0) {init(seedIn);}
 
   // Possibility to pass in pointer for external random number generation.
   bool rndmEnginePtr( RndmEngine* rndmEngPtrIn);
 
-  // Initialize, normally at construction or in first call.
+  // Check if an external random number engine is used.
+  bool useExternalEngine() const {return useExternalRndm;}
+
+  // Initialize, normally at construction or in first call. Optionally
+  // pick the internal engine: 0 for Marsaglia-Zaman-Tsang and 1 for
+  // xoshiro128++; else the current one is kept.
   void init(int seedIn = 0) ;
+  void init(int seedIn, int engineIn) {
+    engineSave = (engineIn == 1) ? 1 : 0; init(seedIn);}
+  int  engine() const {return engineSave;}
+
+  // Jump ahead nJump * 2^64 or nJump * 2^96 steps in the xoshiro128++
+  // sequence, to give non-overlapping streams from a common seed.
+  bool jump(int nJump = 1) {return jumpXoshiro( nJump, JUMP);}
+  bool longJump(int nJump = 1) {return jumpXoshiro( nJump, LONGJUMP);}
 
   // Generate next random number uniformly between 0 and 1.
   double flat() ;
 
+  // Fill an array with nIn random numbers uniformly between 0 and 1.
+  void flat(double* rIn, int nIn) ;
+
   // Generate random numbers according to exp(-x).
   double exp() { return -log(flat()) ;}
 
@@ -70,8 +87,13 @@ public:
   double gauss() {return sqrt(-2. * log(flat())) * cos(M_PI * flat());}
 
   // Generate two random numbers according to exp(-x^2/2-y^2/2).
-  pair<double, double> gauss2() {double r = sqrt(-2. * log(flat()));
-    double phi = 2. * M_PI * flat();
+  pair<double, double> gauss2() {double rn[2]; flat( rn, 2);
+    return gauss2( rn[0], rn[1]);}
+
+  // Same, but from two random numbers uniformly between 0 and 1,
+  // for use with numbers generated in bulk.
+  static pair<double, double> gauss2(double rn1, double rn2) {
+    double r = sqrt(-2. * log(rn1)); double phi = 2. * M_PI * rn2;
     return pair<double, double>(r * sin(phi), r * cos(phi));}
 
   // Pick one option among  vector of (positive) probabilities.
@@ -86,16 +108,29 @@ private:
   // Default random number sequence.
   static const int DEFAULTSEED;
 
+  // Jump polynomials of xoshiro128++, for 2^64 and 2^96 steps, and
+  // conversion of 53 random bits to a double.
+  static const unsigned int JUMP[4], LONGJUMP[4];
+  static const double TWOM53;
+
   // State of the random number generator.
   bool   initRndm;
   int    i97, j97, seedSave;
   long   sequence;
   double u[97], c, cd, cm;
 
+  // Choice of internal engine, and state of the xoshiro128++ one.
+  int          engineSave;
+  unsigned int xs[4];
+
   // Pointer for external random number generation.
   bool   useExternalRndm;
   RndmEngine* rndmEngPtr;
 
+  // Next 32 bits from a xoshiro128++ state, and jump ahead in sequence.
+  static unsigned int nextXoshiro(unsigned int* s);
+  bool jumpXoshiro(int nJump, const unsigned int* poly);
+
 };
 
 //==========================================================================
@@ -179,6 +214,11 @@ public:
   void bstback(const Vec4& pIn, double mIn);
   void rotbst(const RotBstMatrix& M);
 
+  // Boost an array of nIn four-vectors by a common velocity with known
+  // gamma factor, in a vectorizable form.
+  static void bst(Vec4* vIn, int nIn, double betaX, double betaY,
+    double betaZ, double gamma);
+
   // Operator overloading with member functions
   inline Vec4 operator-() const {Vec4 tmp; tmp.xx = -xx; tmp.yy = -yy;
     tmp.zz = -zz; tmp.tt = -tt; return tmp;}
@@ -329,8 +369,12 @@ public:
     tmp.invert(); return tmp; }
   void reset();
 
+  // Apply the matrix to an array of nIn four-vectors, in a vectorizable
+  // form.
+  void apply(Vec4* vIn, int nIn) const;
+
   // Return value of matrix element.
-  double value(int i, int j) { return M[i][j];}
+  double value(int i, int j) const { return M[i][j];}
 
   // Crude estimate deviation from unit matrix.
   double deviation() const;
@@ -389,7 +389,7 @@ public:
   bool roomFor1Remnant(double eCM);
   bool roomFor1Remnant(int id1, double x1, double eCM);
   bool roomFor2Remnants(int id1, double x1, double eCM);
-  bool roomForRemnants(BeamParticle beamOther);
+  bool roomForRemnants(BeamParticle& beamOther);
 
   // Evaluate the remnant mass with initiator idIn.
   double remnantMass(int idIn);
@@ -78,6 +78,10 @@ private:
   // Colour collapses (when one colour is mapped onto another).
   vector<int> colFrom, colTo;
 
+  // Copies of the event record to restore after failures, kept as members
+  // so that their space is reused from one event to the next.
+  Event  eventSave, eventTmpSave, eventAddSave;
+
   // Pointer to various information on the generation.
   Info*          infoPtr;
 
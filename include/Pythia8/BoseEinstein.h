@@ -4,7 +4,7 @@
 // Please respect the MCnet Guidelines, see GUIDELINES for details.
 
 // This file contains the classes to handle Bose-Einstein effects.
-// BoseEinsteinHadron: simple working container for particle momenta.
+// BoseEinsteinHadrons: working container for particle momenta and shifts.
 // BoseEinstein: main class to perform the task.
 
 #ifndef Pythia8_BoseEinstein_H
@@ -20,22 +20,27 @@ namespace Pythia8 {
 
 //==========================================================================
 
-// The BoseEinsteinHadron class is a simple container for studied hadrons.
+// The BoseEinsteinHadrons class is a simple container for studied hadrons.
+// It is stored as a structure of arrays, one array for each component,
+// so that loops over many hadrons can be vectorized by the compiler.
 
-class BoseEinsteinHadron {
+class BoseEinsteinHadrons {
 
 public:
 
-  // Constructors.
-  BoseEinsteinHadron() : id(0), iPos(0), p(0.), pShift(0.), pComp(0.),
-    m2(0.) {}
-  BoseEinsteinHadron(int idIn,  int iPosIn, Vec4 pIn, double mIn) :
-    id(idIn), iPos(iPosIn), p(pIn), pShift(0.), pComp(0.) {m2 = mIn*mIn;}
+  // Constructor.
+  BoseEinsteinHadrons() {}
+
+  // Number of hadrons, reset and add a hadron.
+  int  size() const {return int(iPos.size());}
+  void clear();
+  void add(int iPosIn, const Particle& particleIn);
 
-  // Information on hadron - all public.
-  int    id, iPos;
-  Vec4   p, pShift, pComp;
-  double m2;
+  // Information on hadrons - all public. Position in event record,
+  // momentum, mass squared, rapidity and transverse mass, and
+  // accumulated normal and compensating three-momentum shifts.
+  vector<int>    iPos;
+  vector<double> px, py, pz, e, m2, y, mT, sx, sy, sz, cx, cy, cz;
 
 };
 
@@ -49,10 +54,10 @@ class BoseEinstein {
 public:
 
   // Constructor.
-  BoseEinstein() : doPion(), doKaon(), doEta(), lambda(), QRef(), infoPtr(),
-    nStep(), nStep3(), nStored(), QRef2(), QRef3(), R2Ref(), R2Ref2(),
-    R2Ref3(), mHadron(), mPair(), m2Pair(), deltaQ(), deltaQ3(), maxQ(),
-    maxQ3(), shift(), shift3() {}
+  BoseEinstein() : doPion(), doKaon(), doEta(), lambda(), QRef(), QMaxPair(),
+    infoPtr(), nStep(), nStep3(), nStored(), QRef2(), QRef3(), R2Ref(),
+    R2Ref2(), R2Ref3(), Q2MaxPair(), mHadron(), mPair(), m2Pair(),
+    deltaQ(), deltaQ3(), maxQ(), maxQ3(), shift(), shift3() {}
 
   // Find settings. Precalculate table used to find momentum shifts.
   bool init(Info* infoPtrIn, Settings& settings, ParticleData& particleData);
@@ -64,26 +69,33 @@ private:
 
   // Constants: could only be changed in the code itself.
   static const int    IDHADRON[9], ITABLE[9], NCOMPSTEP;
-  static const double STEPSIZE, Q2MIN, COMPRELERR, COMPFACMAX;
+  static const double STEPSIZE, Q2MIN, COMPRELERR, COMPFACMAX, EXPMAX,
+                      DYSAFETY;
 
   // Initialization data, read from Settings.
   bool   doPion, doKaon, doEta;
-  double lambda, QRef;
+  double lambda, QRef, QMaxPair;
 
   // Pointer to various information on the generation.
   Info* infoPtr;
 
   // Table of momentum shifts for different hadron species.
   int    nStep[4], nStep3[4], nStored[10];
-  double QRef2, QRef3, R2Ref, R2Ref2, R2Ref3, mHadron[9],
+  double QRef2, QRef3, R2Ref, R2Ref2, R2Ref3, Q2MaxPair, mHadron[9],
          mPair[4], m2Pair[4], deltaQ[4], deltaQ3[4], maxQ[4], maxQ3[4];
   double shift[4][200], shift3[4][200];
 
-  // Vector of hadrons to study.
-  vector<BoseEinsteinHadron> hadronBE;
+  // Hadrons to study, ordered in species and rapidity, and temporary
+  // lists used to sort them and to store pair invariants.
+  BoseEinsteinHadrons  hadronBE;
+  vector< pair<double,int> > sortBE[9];
+  vector<double>       Q2Pair;
+
+  // Find shifts for all pairs of hadrons of one species.
+  void shiftSpecies(int iBeg, int iEnd, int iTab);
 
   // Calculate shift and (unnormalized) compensation for pair.
-  void shiftPair(int i1, int i2, int iHad);
+  void shiftPair(int i1, int i2, int iTab, double Q2old);
 
 };
 
@@ -59,29 +59,20 @@ public:
     pSave(pIn), mSave(mIn), scaleSave(scaleIn), polSave(polIn),
     hasVertexSave(false), vProdSave(Vec4(0.,0.,0.,0.)), tauSave(0.),
     pdePtr(0), evtPtr(0) { }
-  Particle(const Particle& pt) : idSave(pt.idSave),
-    statusSave(pt.statusSave), mother1Save(pt.mother1Save),
-    mother2Save(pt.mother2Save), daughter1Save(pt.daughter1Save),
-    daughter2Save(pt.daughter2Save), colSave(pt.colSave),
-    acolSave(pt.acolSave), pSave(pt.pSave), mSave(pt.mSave),
-    scaleSave(pt.scaleSave), polSave(pt.polSave),
-    hasVertexSave(pt.hasVertexSave), vProdSave(pt.vProdSave),
-    tauSave(pt.tauSave), pdePtr(pt.pdePtr), evtPtr(pt.evtPtr) { }
-  Particle& operator=(const Particle& pt) {if (this != &pt) {
-    idSave = pt.idSave; statusSave = pt.statusSave;
-    mother1Save = pt.mother1Save; mother2Save = pt.mother2Save;
-    daughter1Save = pt.daughter1Save; daughter2Save = pt.daughter2Save;
-    colSave = pt.colSave; acolSave = pt.acolSave; pSave = pt.pSave;
-    mSave = pt.mSave; scaleSave = pt.scaleSave; polSave = pt.polSave;
-    hasVertexSave = pt.hasVertexSave; vProdSave = pt.vProdSave;
-    tauSave = pt.tauSave; pdePtr = pt.pdePtr; evtPtr = pt.evtPtr; }
-    return *this; }
+
+  // Copy constructor and assignment are the compiler-generated ones,
+  // copying all data members in one go.
 
   // Destructor.
   virtual ~Particle() {}
 
   // Member functions to set the Event and ParticleDataEntry pointers.
   void setEvtPtr(Event* evtPtrIn) { evtPtr = evtPtrIn; setPDEPtr();}
+
+  // Move to a copy of the event record sharing the same particle data,
+  // so that the ParticleDataEntry pointer can be kept.
+  void moveEvtPtr(Event* evtPtrIn) { evtPtr = evtPtrIn;
+    if (pdePtr == 0) setPDEPtr();}
   void setPDEPtr(ParticleDataEntry* pdePtrIn = 0);
 
   // Member functions for input.
@@ -200,6 +191,9 @@ public:
   int iBotCopyId(bool simplify = false) const;
   vector<int> motherList()   const;
   vector<int> daughterList() const;
+  // As above, but fill an existing vector, so that its space is reused.
+  void motherList(vector<int>& motherVec) const;
+  void daughterList(vector<int>& daughterVec) const;
   vector<int> daughterListRecursive() const;
   vector<int> sisterList(bool traceTopBot = false) const;
   bool isAncestor(int iAncestor) const;
@@ -418,11 +412,18 @@ public:
   // Event record size.
   int size() const {return entry.size();}
 
+  // Reserve space for particles and junctions. The space is kept when
+  // the record is cleared, so this only matters for the first events.
+  void reserve(int nEntry, int nJunction = 0) {entry.reserve(nEntry);
+    junction.reserve(nJunction);}
+  int capacity() const {return entry.capacity();}
+
   // Put a new particle at the end of the event record; return index.
-  int append(Particle entryIn) {
+  // The input may be an entry of this record, so only use the copy.
+  int append(const Particle& entryIn) {
     entry.push_back(entryIn); setEvtPtr();
-    if (entryIn.col() > maxColTag) maxColTag = entryIn.col();
-    if (entryIn.acol() > maxColTag) maxColTag = entryIn.acol();
+    if (entry.back().col() > maxColTag) maxColTag = entry.back().col();
+    if (entry.back().acol() > maxColTag) maxColTag = entry.back().acol();
     return entry.size() - 1;
   }
   int append(int id, int status, int mother1, int mother2, int daughter1,
@@ -530,18 +531,21 @@ public:
   double REtaPhi(int i1, int i2) const {
     return sqrt( pow2(detaAbs(i1, i2)) + pow2(dphiAbs(i1, i2)) ); }
 
-  // Member functions for rotations and boosts of an event.
+  // Member functions for rotations and boosts of an event. Boosts and
+  // rotation-boost matrices act on all entries, or on the entries in the
+  // range iBeg <= i < iEnd, with iEnd < 0 meaning up to the end.
   void rot(double theta, double phi)
     {for (int i = 0; i < size(); ++i) entry[i].rot(theta, phi);}
-  void bst(double betaX, double betaY, double betaZ)
-    {for (int i = 0; i < size(); ++i) entry[i].bst(betaX, betaY, betaZ);}
-  void bst(double betaX, double betaY, double betaZ, double gamma)
-    {for (int i = 0; i < size(); ++i) entry[i].bst(betaX, betaY, betaZ,
-    gamma);}
-  void bst(const Vec4& vec)
-    {for (int i = 0; i < size(); ++i) entry[i].bst(vec);}
+  void bst(double betaX, double betaY, double betaZ);
+  void bst(double betaX, double betaY, double betaZ, double gamma,
+    int iBeg = 0, int iEnd = -1) {transform( 0, betaX, betaY, betaZ, gamma,
+    iBeg, iEnd, true);}
+  void bst(const Vec4& vec);
   void rotbst(const RotBstMatrix& M, bool boostVertices = true)
-    {for (int i = 0; i < size(); ++i) entry[i].rotbst(M, boostVertices);}
+    {transform( &M, 0., 0., 0., 1., 0, -1, boostVertices);}
+  void rotbst(const RotBstMatrix& M, int iBeg, int iEnd,
+    bool boostVertices = true) {transform( &M, 0., 0., 0., 1., iBeg, iEnd,
+    boostVertices);}
 
   // Clear the list of junctions.
   void clearJunctions() {junction.resize(0);}
@@ -589,6 +593,7 @@ private:
 
   // Constants: could only be changed in the code itself.
   static const int IPERLINE;
+  static const double TINY;
 
   // Initialization data, normally only set once.
   int startColTag;
@@ -617,6 +622,11 @@ private:
   // The //! below is ROOT notation that this member should not be saved.
   ParticleData* particleDataPtr;  //!
 
+  // Rotate and boost a range of entries, by matrix if MPtr != 0 and else
+  // by boost, with the transformation kept in local variables.
+  void transform(const RotBstMatrix* MPtr, double betaX, double betaY,
+    double betaZ, double gamma, int iBeg, int iEnd, bool boostVertices);
+
 };
 
 //==========================================================================
@@ -69,6 +69,27 @@ public:
 
 //==========================================================================
 
+// The FlavZpTPars class is a simple container for those parameters of
+// the flavour, z and pT selection that may be changed from one string
+// (piece) to the next, notably by the rope hadronization model.
+// It allows them to be swapped in without going through Settings.
+
+class FlavZpTPars {
+
+public:
+
+  // Constructor.
+  FlavZpTPars() : probStoUD(), probSQtoQQ(), probQQ1toQQ0(), probQQtoQ(),
+    aLund(), bLund(), aExtraDiquark(), sigma() {}
+
+  // Stored parameters, named as in the respective Settings.
+  double probStoUD, probSQtoQQ, probQQ1toQQ0, probQQtoQ, aLund, bLund,
+         aExtraDiquark, sigma;
+
+};
+
+//==========================================================================
+
 // The StringFlav class is used to select quark and hadron flavours.
 
 class StringFlav {
@@ -96,6 +117,9 @@ public:
   virtual void init(Settings& settings, ParticleData* particleDataPtrIn,
     Rndm* rndmPtrIn, Info* infoPtrIn);
 
+  // Change the main flavour parameters without a full re-initialization.
+  virtual void setPars(const FlavZpTPars& pars);
+
   // Pick a light d, u or s quark according to fixed ratios.
   int pickLightQ() { double rndmFlav = probQandS * rndmPtr->flat();
     if (rndmFlav < 1.) return 1;
@@ -219,6 +243,9 @@ protected:
   int    hadronIDwin, idNewWin;
   double hadronMassWin;
 
+  // Calculate parameters derived from the basic flavour ones.
+  void initDerived();
+
 };
 
 //==========================================================================
@@ -311,6 +338,10 @@ public:
   virtual void init(Settings& settings, ParticleData& particleData,
     Rndm* rndmPtrIn, Info* infoPtrIn);
 
+  // Change the Lund a and b parameters without a full re-initialization.
+  virtual void setPars(const FlavZpTPars& pars) { aLund = pars.aLund;
+    bLund = pars.bLund; aExtraDiquark = pars.aExtraDiquark;}
+
   // Fragmentation function: top-level to determine parameters.
   virtual double zFrag( int idOld, int idNew = 0, double mT2 = 1.);
 
@@ -371,6 +402,11 @@ public:
   virtual void init(Settings& settings, ParticleData* particleDataPtr,
     Rndm* rndmPtrIn, Info* infoPtrIn);
 
+  // Change the Gaussian width without a full re-initialization.
+  virtual void setPars(const FlavZpTPars& pars) {
+    sigmaQ = pars.sigma / sqrt(2.);
+    sigma2Had = 2. * pow2( max( SIGMAMIN, pars.sigma) ); }
+
   // General function, return px and py as a pair in the same call
   // in either model.
   pair<double, double>  pxy(int idIn, double nNSP = 0.0) {
@@ -474,8 +474,9 @@ public:
 
   /// The default constructor is empty.
   SubCollisionModel(): sigTarg(8, 0.0), sigErr(8, 0.05), NInt(100000),
-    NGen(20), NPop(20), sigFuzz(0.2), fitPrint(true), avNDb(1.0*femtometer),
-    projPtr(), targPtr(), sigTotPtr(), settingsPtr(), infoPtr(), rndPtr() {}
+    NGen(20), NPop(20), sigFuzz(0.2), fitPrint(true), reuseMode(0),
+    avNDb(1.0*femtometer), projPtr(), targPtr(), sigTotPtr(),
+    settingsPtr(), infoPtr(), rndPtr() {}
 
   /// Virtual destructor,
   virtual ~SubCollisionModel() {}
@@ -501,10 +502,10 @@ public:
   /// sub-collisions are ordered in the impact parameter distance
   /// between the nucleons. The T-variable will be set to the summed
   /// elastic amplityde.
-  virtual multiset<SubCollision> getCollisions(vector<Nucleon> & proj,
-                                               vector<Nucleon> & targ,
-                                               const Vec4 & bvec,
-                                               double & T) = 0;
+  virtual vector<SubCollision> getCollisions(vector<Nucleon> & proj,
+                                             vector<Nucleon> & targ,
+                                             const Vec4 & bvec,
+                                             double & T) = 0;
 
   /// Access the nucleon-nucleon cross sections assumed
   /// for this model.
@@ -554,6 +555,22 @@ public:
   /// Use a simlified genetic algorithm to fit the parameters.
   virtual bool evolve();
 
+  /// Calculate the Chi2 for a given parameter set, using a separate
+  /// random number generator with the given seed. Different parameter
+  /// sets can then be evaluated in any order.
+  double fitChi2(const vector<double> & parms, int seed);
+
+  /// Calculate the Chi2 for all parameter sets in a population of the
+  /// genetic algorithm, one after the other. May be overridden to
+  /// evaluate them in parallel.
+  virtual void evalPopulation(const vector< vector<double> > & pop,
+                              const vector<int> & seeds,
+                              vector<double> & chi2s);
+
+  /// The name of the model, used to identify previously fitted
+  /// parameters in a cache file.
+  virtual string name() const { return "SubCollisionModel"; }
+
   /// Set the parameters of this model.
   virtual void setParm(const vector<double> &) {}
 
@@ -575,6 +592,23 @@ private:
   /// (tot, nd, dd, sdp, sdt, cd, el, bslope) and the required precision.
   vector<double> sigTarg, sigErr;
 
+  /// The largest random number seed for evaluating a parameter set.
+  static const int MAXSEED = 900000000;
+
+  /// The largest number of grid cells in each direction when pairing
+  /// nucleons.
+  static const int MAXGRID = 64;
+
+  /// Scratch space for the grid over target nucleons: the first entry
+  /// of each cell in the list of target indices ordered in cells.
+  vector<int> cellFirst, cellTarg;
+
+  /// The key identifying a fit in the cache file, and functions to
+  /// read and write fitted parameters for this key.
+  string fitCacheKey(int npar) const;
+  bool readFitCache(vector<double> & parms) const;
+  void writeFitCache(const vector<double> & parms) const;
+
 protected:
 
   /// The parameters stearing the fitting of internal parameters to
@@ -583,10 +617,25 @@ protected:
   double sigFuzz;
   bool fitPrint;
 
+  /// How to reuse fitted parameters, and the cache file to use.
+  int reuseMode;
+  string cacheFile;
+
   /// The estimated average impact parameter distance (in femtometer)
   /// for absorptive collisions.
   double avNDb;
 
+  /// Find all pairs of projectile and target nucleons (after the
+  /// shift done in getCollisions) that are closer than bMax in impact
+  /// parameter, using a grid over the target nucleons. The pairs are
+  /// ordered in projectile and then target index, as when looping
+  /// over all pairs.
+  void findPairs(const vector<Nucleon> & proj, const vector<Nucleon> & targ,
+                 double bMax);
+
+  /// The pairs found by findPairs.
+  vector< pair<int,int> > nucleonPairs;
+
   /// Info from the controlling HeavyIons object
   NucleusModel * projPtr;
   NucleusModel * targPtr;
@@ -618,7 +667,7 @@ public:
   /// Take two vectors of Nucleons and an impact parameter vector and
   /// produce the corrsponding sub-collisions. Note that states of the
   /// nucleons may be changed.
-  virtual multiset<SubCollision>
+  virtual vector<SubCollision>
   getCollisions(vector<Nucleon> & proj, vector<Nucleon> & targ,
                 const Vec4 & bvec, double & T);
 
@@ -644,7 +693,7 @@ public:
   /// Take two vectors of Nucleons and an impact parameter vector and
   /// produce the corrsponding sub-collisions. Note that states of the
   /// nucleons may be changed.
-  virtual multiset<SubCollision>
+  virtual vector<SubCollision>
   getCollisions(vector<Nucleon> & proj, vector<Nucleon> & targ,
                 const Vec4 & bvec, double & T);
 
@@ -670,7 +719,7 @@ public:
   /// Take two vectors of Nucleons and an impact parameter vector and
   /// produce the corrsponding sub-collisions. Note that states of the
   /// nucleons may be changed.
-  virtual multiset<SubCollision>
+  virtual vector<SubCollision>
   getCollisions(vector<Nucleon> & proj, vector<Nucleon> & targ,
                 const Vec4 & bvec, double & T);
 
@@ -698,6 +747,11 @@ public:
   /// Calculate the cross sections for the given set of parameters.
   SigEst getSig() const;
 
+  /// The name of the model, including the opacity mode.
+  virtual string name() const {
+    return opacityMode == 1? "DoubleStrikman(1)": "DoubleStrikman";
+  }
+
   /// Set the parameters of this model.
   virtual void setParm(const vector<double> &);
 
@@ -759,7 +813,7 @@ public:
   /// Take two vectors of Nucleons and an impact parameter vector and
   /// produce the corrsponding sub-collisions. Note that states of the
   /// nucleons may be changed.
-  virtual multiset<SubCollision>
+  virtual vector<SubCollision>
   getCollisions(vector<Nucleon> & proj, vector<Nucleon> & targ,
                 const Vec4 & bvec, double & T);
 
@@ -773,6 +827,9 @@ public:
   /// Calculate the cross sections for the given set of parameters.
   SigEst getSig() const;
 
+  /// The name of the model.
+  virtual string name() const { return "MultiRadial"; }
+
   /// Set the parameters of this model.
   virtual void setParm(const vector<double> &);
 
@@ -1037,16 +1094,16 @@ private:
 
 public:
   // Access to subcollision to be extracted by the user.
-  multiset<SubCollision>* subCollisionsPtr() { return subColsPtr; }
+  vector<SubCollision>* subCollisionsPtr() { return subColsPtr; }
 
-  void subCollisionsPtr(multiset<SubCollision> * sPtrIn) {
+  void subCollisionsPtr(vector<SubCollision> * sPtrIn) {
     subColsPtr = sPtrIn; }
 
 private:
 
   // Full information about the Glauber calculation, consisting of
   // all subcollisions.
-  multiset<SubCollision>* subColsPtr;
+  vector<SubCollision>* subColsPtr;
 
 };
 
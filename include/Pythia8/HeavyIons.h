@@ -165,6 +165,9 @@ public:
   /// Set UserHooks for specific (or ALL) internal Pythia objects.
   bool setUserHooksPtr(PythiaObject sel, UserHooks * userHooksPtrIn);
 
+  /// Print out statistics, including messages from additional workers.
+  virtual void stat();
+
   /// Iterate over nucleons.
   vector<Nucleon>::iterator projBegin() {
    return projectile.begin();
@@ -181,8 +184,57 @@ public:
 
 protected:
 
-  /// Setup an EventInfo object from a Pythia instance.
-  EventInfo mkEventInfo(Pythia & pyt, const SubCollision * coll = 0);
+  /// A request for a minimum bias sub-event from one of the worker
+  /// Pythia objects. If each task has its own random number seed, the
+  /// result does not depend on which worker generates it, or when.
+  struct SubEventTask {
+
+    SubEventTask(const SubCollision * collIn = 0, int procIn = 101,
+                 int seedIn = -1)
+      : coll(collIn), proc(procIn), seed(seedIn) {}
+
+    /// The sub-collision (if any), the wanted process and the seed
+    /// (if positive) to be used.
+    const SubCollision * coll;
+    int proc;
+    int seed;
+
+    /// The generated sub-event.
+    EventInfo result;
+
+  };
+
+  /// Generate a set of independent sub-events. By default they are
+  /// generated one after the other with the first worker, but a
+  /// subclass may distribute them over several workers in parallel.
+  virtual void runSubEventTasks(vector<SubEventTask> & tasks);
+
+  /// Generate a sub-event with the given worker, where worker zero
+  /// is the MBIAS object. Different workers may run concurrently, so
+  /// the event ordering of the result is left to the caller.
+  bool genSubEvent(int iWorker, SubEventTask & task);
+
+  /// Add workers for minimum bias sub-events, as copies of the
+  /// initialized MBIAS object. Not done if the MBIAS object has
+  /// UserHooks, since these are not shared with the workers.
+  bool addWorkers(int nAdd);
+
+  /// The number of workers in use, including the MBIAS object.
+  int nWorkers() const {
+    return ( hasMBIASHooks? 1: 1 + int(workerPtrs.size()) ); }
+
+  /// Create the SubCollisionModel selected by Angantyr:CollisionModel,
+  /// unless one is supplied by the HIUserHooks.
+  virtual SubCollisionModel * newSubCollisionModel(int model);
+
+  /// Setup an EventInfo object from a Pythia instance, optionally
+  /// without setting its ordering.
+  EventInfo mkEventInfo(Pythia & pyt, const SubCollision * coll = 0,
+                        bool doOrdering = true);
+
+  /// Set the ordering of an EventInfo object, from the HIUserHooks if
+  /// present, else from the MPI impact parameter.
+  void setEventOrdering(EventInfo & ei);
 
   /// Generate events from the internal Pythia oblects;
   EventInfo getSignal(const SubCollision & coll);
@@ -199,16 +251,16 @@ protected:
     { return getSASD(&coll, 104); }
   EventInfo getMBIAS(const SubCollision * coll, int procid);
   EventInfo getSASD(const SubCollision * coll, int procid);
-  bool genAbs(const multiset<SubCollision> & coll,
+  bool genAbs(const vector<SubCollision> & coll,
               list<EventInfo> & subevents);
-  void addSASD(const multiset<SubCollision> & coll);
-  bool addDD(const multiset<SubCollision> & coll, list<EventInfo> & subevents);
-  bool addSD(const multiset<SubCollision> & coll, list<EventInfo> & subevents);
-  void addSDsecond(const multiset<SubCollision> & coll);
-  bool addCD(const multiset<SubCollision> & coll, list<EventInfo> & subevents);
-  void addCDsecond(const multiset<SubCollision> & coll);
-  bool addEL(const multiset<SubCollision> & coll, list<EventInfo> & subevents);
-  void addELsecond(const multiset<SubCollision> & coll);
+  void addSASD(const vector<SubCollision> & coll);
+  bool addDD(const vector<SubCollision> & coll, list<EventInfo> & subevents);
+  bool addSD(const vector<SubCollision> & coll, list<EventInfo> & subevents);
+  void addSDsecond(const vector<SubCollision> & coll);
+  bool addCD(const vector<SubCollision> & coll, list<EventInfo> & subevents);
+  void addCDsecond(const vector<SubCollision> & coll);
+  bool addEL(const vector<SubCollision> & coll, list<EventInfo> & subevents);
+  void addELsecond(const vector<SubCollision> & coll);
   bool buildEvent(list<EventInfo> & subevents,
                   const vector<Nucleon> & proj,
                   const vector<Nucleon> & targ);
@@ -329,17 +381,30 @@ private:
   // The process selector for the SASD object.
   ProcessSelectorHook selectSASD;
 
+  // Additional workers for minimum bias sub-events, and their
+  // process selectors.
+  vector<Pythia *> workerPtrs;
+  vector<ProcessSelectorHook *> workerSelectPtrs;
+
+  // UserHooks have been set for the MBIAS object.
+  bool hasMBIASHooks;
+
 private:
 
   static const int MAXTRY = 999;
   static const int MAXEVSAVE = 999;
+  static const int MAXSEED = 900000000;
+
+  /// The random number seed for a given sub-event task in the current
+  /// event, derived from seedBase.
+  int subEventSeed(int iTask) const;
 
   /// Projectile and target nucleons for current collision.
   vector<Nucleon> projectile;
   vector<Nucleon> target;
 
   /// All subcollisions in current collision.
-  multiset<SubCollision> subColls;
+  vector<SubCollision> subColls;
 
   /// Flag set if there is a specific signal process specified beyond
   /// minimum bias.
@@ -364,6 +429,11 @@ private:
   /// Different choices for handling impact parameters.
   int bMode;
 
+  /// Give each independent sub-event its own random number seed,
+  /// derived from a base seed picked anew for each event.
+  bool seedSubEvents;
+  unsigned int seedBase;
+
 public:
 
   /// internal class to redirect stdout
@@ -23,6 +23,9 @@
 
 namespace Pythia8 {
 
+class History;
+class Merging;
+
 //==========================================================================
 
 // Declaration of Clustering class.
@@ -106,6 +109,35 @@ public:
 
 //==========================================================================
 
+// Declaration of TrialShowerTask class.
+// This class holds one trial shower of a History node, for use when the
+// trial showers of a weight calculation are run together in one batch.
+
+class TrialShowerTask {
+
+public:
+
+  // Constructor.
+  TrialShowerTask(History* nodeIn = 0, int typeIn = 1, double maxscaleIn = 0.)
+    : node(nodeIn), type(typeIn), seed(0), maxscale(maxscaleIn),
+      weight(1.) {}
+
+  // Perform the trial shower with a trial PartonLevel object, after
+  // reseeding its random number generator if a seed is set.
+  void run(PartonLevel* trial, Rndm* rndmPtr);
+
+  // The node to shower, the type of no-emission probability and the
+  // random number seed.
+  History* node;
+  int      type, seed;
+
+  // The starting scale, and the resulting no-emission weight.
+  double   maxscale, weight;
+
+};
+
+//==========================================================================
+
 // Declaration of History class
 //
 // A History object represents an event in a given step in the CKKW-L
@@ -136,11 +168,11 @@ public:
   // previous history node (null for the initial node).
   History( int depthIn,
            double scalein,
-           Event statein,
-           Clustering c,
+           const Event& statein,
+           const Clustering& c,
            MergingHooks* mergingHooksPtrIn,
-           BeamParticle beamAIn,
-           BeamParticle beamBIn,
+           const BeamParticle& beamAIn,
+           const BeamParticle& beamBIn,
            ParticleData* particleDataPtrIn,
            Info* infoPtrIn,
            PartonLevel* showersIn,
@@ -285,10 +317,16 @@ public:
   // Mainly for debugging.
   void printStates();
 
+  // Function to let the trial showers of each weight calculation be run
+  // in one batch by the Merging object. Only used for the initial node.
+  void setMergingPtr( Merging* mergingPtrIn) { mergingPtr = mergingPtrIn; }
+
   // Make Pythia class friend
   friend class Pythia;
   // Make Merging class friend
   friend class Merging;
+  // Make TrialShowerTask class friend
+  friend class TrialShowerTask;
 
 private:
 
@@ -468,6 +506,11 @@ private:
   double doTrialShower(PartonLevel* trial, int type, double maxscale,
     double minscale = 0.);
 
+  // Perform a trial shower, or, when the trial showers of a weight
+  // calculation are run in one batch, add it to the batch or pick up
+  // its weight from the batch.
+  double trialShower(PartonLevel* trial, int type, double maxscale);
+
   // Function to bookkeep the indices of weights generated in countEmissions
   bool updateind(vector<int> & ind, int i, int N);
 
@@ -971,6 +1014,9 @@ private:
   }
 
   int nMaxOrd;
+  // Number of increasing clustering scales in a row up to this node, and
+  // maximal such number along the path, as needed by nOrdered.
+  int nIncreaseNow, nIncreaseMax;
   int nMaxOrdered() {
     if ( mother ) return mother->nMaxOrdered();
     return nMaxOrd;
@@ -983,6 +1029,17 @@ private:
     if ( mother ) return mother->maxDepth();
     return depth;
   }
+
+  // Merging object that runs the trial showers in one batch, if any, and
+  // the batch being collected (mode 1) or picked up (mode 2), from entry
+  // iTrialNext on. Only used in the initial node.
+  Merging* mergingPtr;
+  vector<TrialShowerTask> trialBatch;
+  int trialBatchMode, iTrialNext;
+  History* initialNode() {
+    if ( mother ) return mother->initialNode();
+    return this;
+  }
   int npaths() {
     if ( mother ) return mother->npaths();
     return paths.size();
@@ -19,6 +19,37 @@ namespace Pythia8 {
 
 //==========================================================================
 
+// Fast reading of the next number in a character string, used instead
+// of string streams for the numbers in event blocks. Leading white
+// space is skipped, and the pointer is moved past the number. Returns
+// false if no number could be read. Doubles are converted with strtod,
+// as in the standard streams, so the results are identical.
+
+inline bool readNumberLHEF(const char*& str, double& val) {
+  char* next;
+  val = strtod(str, &next);
+  if (next == str) return false;
+  str = next;
+  return true;
+}
+
+inline bool readNumberLHEF(const char*& str, long& val) {
+  char* next;
+  val = strtol(str, &next, 10);
+  if (next == str) return false;
+  str = next;
+  return true;
+}
+
+inline bool readNumberLHEF(const char*& str, int& val) {
+  long lval;
+  if (!readNumberLHEF(str, lval)) return false;
+  val = int(lval);
+  return true;
+}
+
+//==========================================================================
+
 // The XMLTag struct is used to represent all information within an XML tag.
 // It contains the attributes as a map, any sub-tags as a vector of pointers
 // to other XMLTag objects, and any other information as a single string.
@@ -107,15 +138,16 @@ struct XMLTag {
       // Find the first tag.
       pos_t begin = str.find("<", curr);
       // Skip tags in lines beginning with #.
-      pos_t lastbreak_before_begin = str.find_last_of("\n",begin);
-      pos_t lastpound_before_begin = str.find_last_of("#",begin);
-      // Logic: Last newline before begin was before last pound sign (or there
-      // was no last newline at all, i.e. this is the special case of the
-      // first line), and hence the pound sign was before the tag was opened
-      // (at begin) with '<'. Thus, skip forward to next new line.
-      if ( (lastbreak_before_begin < lastpound_before_begin
-         || lastbreak_before_begin == end)
-        && begin > lastpound_before_begin) {
+      // Logic: there is a pound sign between the last newline before
+      // begin (or the start of the string, for the first line) and the
+      // tag opened (at begin) with '<'. Thus, skip forward to next new
+      // line. Only the current line is scanned, to keep long blocks
+      // with many tags, like rwgt, linear in the number of tags.
+      bool commented = false;
+      if ( begin != end )
+        for (pos_t i = begin; i > 0 && str[i - 1] != '\n'; --i)
+          if ( str[i - 1] == '#' ) { commented = true; break; }
+      if ( commented ) {
         pos_t endcom = str.find_first_of("\n",begin);
         if ( endcom == end ) {
           if ( leftover ) *leftover += str.substr(curr);
@@ -127,7 +159,7 @@ struct XMLTag {
       }
 
       // Skip xml-style comments.
-      if ( begin != end && str.find("<!--", curr) == begin ) {
+      if ( begin != end && str.compare(begin, 4, "<!--") == 0 ) {
         pos_t endcom = str.find("-->", begin);
         if ( endcom == end ) {
           if ( leftover ) *leftover += str.substr(curr);
@@ -144,7 +176,7 @@ struct XMLTag {
       // which XML would erroneously interpret as the start of a new
       // element or the start of a character entity, respectively.)
       // See eg http://www.w3schools.com/xml/xml_cdata.asp
-      if ( str.find("<![CDATA[", curr) == begin ) {
+      if ( begin != end && str.compare(begin, 9, "<![CDATA[") == 0 ) {
         pos_t endcom = str.find("]]>", begin);
         if ( endcom == end ) {
           if ( leftover ) *leftover += str.substr(curr);
@@ -869,6 +901,32 @@ public:
   // member variable.
   bool readEvent(HEPEUP * peup = 0);
 
+  // Skip the next event, only scanning for the start and end tags.
+  // Return false if there are no more events.
+  bool skipEvent();
+
+  // Skip a number of events, by a jump in the file if they are indexed.
+  bool skipEvents(long nSkip);
+
+  // Index the positions of the events in the file, read from indexFile
+  // if it matches the event file, or else found by scanning the event
+  // file once, and then saved in indexFile if not empty.
+  bool indexEvents(string indexFileIn);
+
+  // Name of the event file, empty for an external stream.
+  string fileName() const {return filename;}
+
+  // Number of indexed events, and jump to an indexed event. If no event
+  // starts at the indexed position the index is rebuilt once.
+  long nEventIndex() const {return eventOffsets.size();}
+  bool seekEvent(long iEvent);
+
+  // Number of the next event to read, counting from zero.
+  long nextEvent() const {return iEventNext;}
+
+  // Stop after a number of further events; negative means no limit.
+  void setEventLimit(long nEventIn) {nEventLeft = nEventIn;}
+
   // Reset values of all event-related members to their defaults.
   void clearEvent() {
    currentLine = "";
@@ -881,6 +939,10 @@ protected:
 
   // Used internally to read a single line from the stream.
   bool getLine() {
+    if (keepLine) {
+      keepLine = false;
+      return true;
+    }
     currentLine = "";
     if(!getline(*file, currentLine)) return false;
     // Replace single by double quotes
@@ -901,8 +963,37 @@ protected:
   // external stream or the internal intstream.
   istream * file;
 
-  // The last line read in from the stream in getline().
+  // The last line read in from the stream in getline(), and whether it
+  // should be returned again by the next call.
   string currentLine;
+  bool keepLine;
+
+  // Number of the next event, the remaining number of events to read,
+  // and the positions of all events in the file, if indexed.
+  long iEventNext, nEventLeft;
+  vector<std::streamoff> eventOffsets;
+
+  // The index file, and a hash of the header and init blocks of the
+  // event file that it belongs to.
+  string indexFile;
+  unsigned long initHash;
+
+  // Scan the event file for the positions of the events.
+  bool scanEvents();
+
+  // Read and write the index file.
+  bool readIndex(std::streamoff fileSize);
+  void writeIndex(std::streamoff fileSize);
+
+  // Hash the header and init blocks of the event file.
+  bool hashInit();
+
+  // Move the stream to an indexed event, and check that it starts there.
+  bool moveToEvent(long iEvent);
+
+  // Add a number of bytes to a hash, and the start value of hashes.
+  static void addHash(unsigned long& hash, const char* data, size_t n);
+  static const unsigned long HASHBASIS;
 
 public:
 
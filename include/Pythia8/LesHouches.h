@@ -182,6 +182,11 @@ public:
     for (int iSkip = 0; iSkip < nSkip; ++iSkip) if (!setEvent()) return false;
     return true;}
 
+  // Index the events of the input, so that skipping is done by a jump,
+  // and optionally only read shard iShard out of nShard equal parts.
+  // Only available for the LHAupLHEF class.
+  virtual bool indexEvents(int = 0, int = 1) {return false;}
+
   // Four routines to write a Les Houches Event file in steps.
   virtual bool openLHEF(string fileNameIn);
   virtual bool closeLHEF(bool updateInit = false);
@@ -349,7 +354,8 @@ public:
     bool readHeadersIn = false, bool setScalesFromLHEFIn = false ) :
     infoPtr(infoPtrIn), filename(""), headerfile(""),
     is(isIn), is_gz(NULL), isHead(isHeadIn), isHead_gz(NULL),
-    readHeaders(readHeadersIn), reader(is),
+    readHeaders(readHeadersIn), reader(is), hepeupPtr(0),
+    eventCommentsPtr(0), weightsDetailedPtr(0),
     setScalesFromLHEF(setScalesFromLHEFIn), hasExtFileStream(true),
     hasExtHeaderStream(true) {}
 
@@ -358,7 +364,8 @@ public:
     bool setScalesFromLHEFIn = false ) :
     infoPtr(infoPtrIn), filename(filenameIn), headerfile(headerIn),
     is(NULL), is_gz(NULL), isHead(NULL), isHead_gz(NULL),
-    readHeaders(readHeadersIn), reader(filenameIn),
+    readHeaders(readHeadersIn), reader(filenameIn), hepeupPtr(0),
+    eventCommentsPtr(0), weightsDetailedPtr(0),
     setScalesFromLHEF(setScalesFromLHEFIn), hasExtFileStream(false),
     hasExtHeaderStream(false) {
     is = (openFile(filenameIn, ifs));
@@ -419,11 +426,13 @@ public:
   }
 
   // Skip ahead a number of events, which are not considered further.
-  bool skipEvent(int nSkip) {
-    for (int iSkip = 0; iSkip < nSkip; ++iSkip)
-      if (!setNewEventLHEF()) return false;
-     return true;
-  }
+  // The events are only scanned for their end tags, not parsed, or
+  // jumped over if indexed.
+  virtual bool skipEvent(int nSkip) {return reader.skipEvents(nSkip);}
+
+  // Index the events, with the index stored next to the event file,
+  // and optionally restrict reading to shard iShard of nShard.
+  virtual bool indexEvents(int iShard = 0, int nShard = 1);
 
   // Routine for doing the job of reading and setting info on next event.
   bool setNewEventLHEF();
@@ -433,6 +442,17 @@ public:
 
 protected:
 
+  // Read the next event, and point to its contents. By default the
+  // reader parses the event from file, but a derived class may give
+  // the events from elsewhere, e.g. from a buffer filled ahead of time.
+  virtual bool readEventLHEF() {
+    if (!reader.readEvent()) return false;
+    hepeupPtr          = &reader.hepeup;
+    eventCommentsPtr   = &reader.eventComments;
+    weightsDetailedPtr = &reader.weights_detailed_vec;
+    return true;
+  }
+
   // Used internally to read a single line from the stream.
   bool getLine(string & line, bool header = true) {
 #ifdef GZIPSUPPORT
@@ -467,7 +487,15 @@ private:
   // Flag to read headers or not
   bool readHeaders;
 
+protected:
+
+  // The reader of the file, and the contents of the current event.
   Reader reader;
+  HEPEUP* hepeupPtr;
+  string* eventCommentsPtr;
+  vector<double>* weightsDetailedPtr;
+
+private:
 
   // Flag to set particle production scales or not.
   bool setScalesFromLHEF, hasExtFileStream, hasExtHeaderStream;
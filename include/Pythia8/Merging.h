@@ -46,6 +46,7 @@ public:
     beamAPtr = beamAPtrIn; beamBPtr = beamBPtrIn;
     trialPartonLevelPtr = trialPartonLevelPtrIn;
     mergingHooksPtr = mergingHooksPtrIn; coupSMPtr = coupSMPtrIn;
+    initSettingsRefs();
   }
 
   // Initialisation function for internal use inside Pythia source code
@@ -72,6 +73,10 @@ public:
   LHEF3FromPythia8* lhaPtr;
   void setLHAPtr( LHEF3FromPythia8* lhaUpIn ) { lhaPtr = lhaUpIn; }
 
+  // Function to run the trial showers collected by a History object in
+  // one batch, each with a random number seed of its own.
+  void runTrialShowerBatch( vector<TrialShowerTask>& tasks);
+
 protected:
 
   //----------------------------------------------------------------------//
@@ -81,7 +86,7 @@ protected:
   // Constructor.
   Merging() : lhaPtr(0), settingsPtr(), infoPtr(), particleDataPtr(),
     rndmPtr(), trialPartonLevelPtr(), mergingHooksPtr(), beamAPtr(),
-    beamBPtr(), coupSMPtr(), tmsNowMin() {}
+    beamBPtr(), coupSMPtr(), tmsNowMin(), seedBase(0) {}
 
   // Make Pythia class friend
   friend class Pythia;
@@ -115,6 +120,29 @@ protected:
   double tmsNowMin;
   static const double TMSMISMATCH;
 
+  // Handles to the merging settings that are read for each event.
+  FlagRef allowIncompleteHistoriesInRealRef, applyVetoRef,
+          doCutBasedMergingRef, doKTMergingRef, doMGMergingRef, doNL3LoopRef,
+          doNL3SubtRef, doNL3TreeRef, doPTLundMergingRef, doUMEPSSubtRef,
+          doUMEPSTreeRef, doUNLOPSLoopRef, doUNLOPSSubtRef, doUNLOPSSubtNLORef,
+          doUNLOPSTildeRef, doUNLOPSTreeRef, doUserMergingRef,
+          doXSectionEstimateRef, enforceCutOnLHERef,
+          runtimeAMCATNLOInterfaceRef, seedTrialShowersRef;
+  ModeRef nReclusterRef, nRequestedRef;
+  WordRef processRef;
+  void initSettingsRefs();
+
+  // Run a batch of trial showers, by default one after the other with
+  // the trial PartonLevel object. Since each has its own random number
+  // seed, they may instead be run in parallel in a derived class.
+  virtual void runTrialShowers( vector<TrialShowerTask>& tasks);
+
+  // The random number seed for a trial shower in the current batch,
+  // derived from a base seed picked once per batch.
+  static const int MAXSEED;
+  unsigned int seedBase;
+  int trialShowerSeed(int iTask) const;
+
   // Function to perform CKKW-L merging on the event.
   int mergeProcessCKKWL( Event& process);
 
@@ -286,7 +286,9 @@ public:
     ParticleData* particleDataPtrIn, PartonSystems* partonSystemsPtrIn)
     { settingsPtr = settingsPtrIn; infoPtr = infoPtrIn;
       particleDataPtr = particleDataPtrIn;
-      partonSystemsPtr = partonSystemsPtrIn;}
+      partonSystemsPtr = partonSystemsPtrIn;
+      unlopsTMSdefinition
+        = settingsPtr->modeRef("Merging:unlopsTMSdefinition");}
 
   //----------------------------------------------------------------------//
   // Simple output functions
@@ -511,6 +513,9 @@ public:
 
   Settings* settingsPtr;
 
+  // Handle to a setting used in each merging scale evaluation.
+  ModeRef unlopsTMSdefinition;
+
   // Pointer to the particle data table.
   ParticleData*  particleDataPtr;
 
@@ -212,6 +212,7 @@ private:
                       EXPPOWMIN, PROBATLOWB, BSTEP, BMAX, EXPMAX,
                       KCONVERGE, CONVERT2MB, ROOTMIN, ECMDEV, WTACCWARN,
                       SIGMAMBLIMIT;
+  static const int    INITCACHEVERSION;
 
   // Initialization data, read from Settings.
   bool   allowRescatter, allowDoubleRes, canVetoMPI, doPartonVertex, doVarEcm;
@@ -351,6 +352,13 @@ private:
   // Calculate factor relating matter overlap and interaction rate.
   void overlapInit();
 
+  // Persistent cache of the initialization tables, keyed by all settings
+  // and beam properties that could affect them.
+  string initCacheKey(Settings& settings);
+  void   initCacheState(vector<double*>& stateVars, double* sigmaMaxViolPtr);
+  bool   readInitCache(string fileName, string key, double& sigmaMaxViol);
+  bool   writeInitCache(string fileName, string key, double sigmaMaxViol);
+
   // Pick impact parameter and interaction rate enhancement,
   // either before the first interaction (for nondiffractive) or after it.
   void overlapFirst();
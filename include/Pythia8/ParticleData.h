@@ -397,6 +397,9 @@ private:
   // Set constituent mass.
   void setConstituentMass();
 
+  // The full database needs access to write and read binary snapshots.
+  friend class ParticleData;
+
 };
 
 //==========================================================================
@@ -411,7 +414,8 @@ public:
   ParticleData() : setRapidDecayVertex(), modeBreitWigner(), maxEnhanceBW(),
     mQRun(), Lambda5Run(), intermediateTau0(), infoPtr(0), settingsPtr(0),
     rndmPtr(0), couplingsPtr(0), particlePtr(0), isInit(false),
-    readingFailedSave(false) {}
+    readingFailedSave(false), indexShift(), indexMask(), nIndexed() {
+    rebuildIndex();}
 
   // Copy constructor.
   ParticleData( const ParticleData& oldPD) {
@@ -423,7 +427,7 @@ public:
       pde != oldPD.pdt.end(); pde++) { int idTmp = pde->first;
       pdt[idTmp] = pde->second; pdt[idTmp].initPtr(this); }
     particlePtr = 0; isInit = oldPD.isInit;
-    readingFailedSave = oldPD.readingFailedSave; }
+    readingFailedSave = oldPD.readingFailedSave; rebuildIndex(); }
 
   // Assignment operator.
   ParticleData& operator=( const ParticleData& oldPD) { if (this != &oldPD) {
@@ -435,7 +439,8 @@ public:
       pde != oldPD.pdt.end(); pde++) { int idTmp = pde->first;
       pdt[idTmp] = pde->second; pdt[idTmp].initPtr(this); }
     particlePtr = 0; isInit = oldPD.isInit;
-    readingFailedSave = oldPD.readingFailedSave; } return *this; }
+    readingFailedSave = oldPD.readingFailedSave; rebuildIndex(); }
+    return *this; }
 
   // Initialize pointers.
   void initPtr(Info* infoPtrIn, Settings* settingsPtrIn, Rndm* rndmPtrIn,
@@ -479,6 +484,12 @@ public:
   bool readFF(istream& is, bool reset = true);
   void listFF(string outFile);
 
+  // Write or read the complete database in binary form, for a snapshot.
+  // Only what is needed after construction, not the XML lines or the
+  // readString history, so init from another ParticleData is not possible.
+  bool writeSnapshot(ostream& os);
+  bool readSnapshot(istream& is);
+
   // Read in one update from a single line.
   bool readString(string lineIn, bool warn = true) ;
 
@@ -513,14 +524,15 @@ public:
     double mWidthIn = 0., double mMinIn = 0., double mMaxIn = 0.,
     double tau0In = 0.) { pdt[abs(idIn)] = ParticleDataEntry(idIn,
     nameIn, spinTypeIn, chargeTypeIn, colTypeIn, m0In, mWidthIn,
-    mMinIn, mMaxIn, tau0In); pdt[abs(idIn)].initPtr(this); }
+    mMinIn, mMaxIn, tau0In); pdt[abs(idIn)].initPtr(this);
+    indexParticle(abs(idIn)); }
   void addParticle(int idIn, string nameIn, string antiNameIn,
     int spinTypeIn = 0, int chargeTypeIn = 0, int colTypeIn = 0,
     double m0In = 0., double mWidthIn = 0., double mMinIn = 0.,
     double mMaxIn = 0., double tau0In = 0.) { pdt[abs(idIn)]
     = ParticleDataEntry(idIn, nameIn, antiNameIn, spinTypeIn,
     chargeTypeIn, colTypeIn, m0In, mWidthIn, mMinIn, mMaxIn, tau0In);
-    pdt[abs(idIn)].initPtr(this); }
+    pdt[abs(idIn)].initPtr(this); indexParticle(abs(idIn)); }
 
   // Reset all the properties of an entry in one go.
   void setAll(int idIn, string nameIn, string antiNameIn,
@@ -532,26 +544,22 @@ public:
     colTypeIn, m0In, mWidthIn, mMinIn, mMaxIn, tau0In); }
 
   // Query existence of an entry.
-  bool isParticle(int idIn) const {
-    map<int,ParticleDataEntry>::const_iterator found = pdt.find( abs(idIn) );
-    if ( found == pdt.end() ) return false;
-    if ( idIn > 0 || found->second.hasAnti() ) return true;
-    return false;
-  }
+  bool isParticle(int idIn) const { return findParticle(idIn) != NULL; }
 
   // Query existence of an entry and return an iterator.
+  // The search goes via the hash index rather than the map.
   ParticleDataEntry* findParticle(int idIn) {
-    map<int,ParticleDataEntry>::iterator found = pdt.find( abs(idIn) );
-    if( found == pdt.end() ) return NULL;
-    if ( idIn > 0 || found->second.hasAnti() ) return &((*found).second);
+    ParticleDataEntry* found = indexLookup( abs(idIn) );
+    if ( found == NULL ) return NULL;
+    if ( idIn > 0 || found->hasAnti() ) return found;
     return NULL;
   }
 
   // Query existence of an entry and return a const iterator.
   const ParticleDataEntry* findParticle(int idIn) const {
-    map<int,ParticleDataEntry>::const_iterator found = pdt.find( abs(idIn) );
-    if( found == pdt.end() ) return NULL;
-    if ( idIn > 0 || found->second.hasAnti() ) return &((*found).second);
+    const ParticleDataEntry* found = indexLookup( abs(idIn) );
+    if ( found == NULL ) return NULL;
+    if ( idIn > 0 || found->hasAnti() ) return found;
     return NULL;
   }
 
@@ -769,7 +777,9 @@ public:
   // Return pointer to entry.
   ParticleDataEntry* particleDataEntryPtr(int idIn) {
     ParticleDataEntry* ptr = findParticle(idIn);
-    return ( ptr ) ? ptr : &pdt[0]; }
+    if ( ptr ) return ptr;
+    if (pdt.find(0) == pdt.end()) { pdt[0].initPtr(this); indexParticle(0); }
+    return &pdt[0]; }
 
   // Check initialisation status.
   bool getIsInit() {return isInit;}
@@ -805,6 +815,33 @@ private:
   // Flag that initialization has been performed; whether any failures.
   bool   isInit, readingFailedSave;
 
+  // Open-addressing hash index from abs(id) to the entries in pdt.
+  // Identity codes and pointers are kept in separate contiguous arrays,
+  // with -1 marking an empty slot. Map nodes do not move when other
+  // entries are added, so only clear and erase require a rebuild.
+  vector<int>                idIndex;
+  vector<ParticleDataEntry*> ptrIndex;
+  int    indexShift, indexMask, nIndexed;
+
+  // Constants: could only be changed in the code itself.
+  static const unsigned int INDEXHASH;
+  static const int    INDEXMINSIZE;
+  static const double INDEXMAXLOAD;
+
+  // Find an entry in the index, without the antiparticle check.
+  ParticleDataEntry* indexLookup(int idAbs) const {
+    int slot = int( (static_cast<unsigned int>(idAbs) * INDEXHASH)
+      >> indexShift );
+    for ( ; ; slot = (slot + 1) & indexMask) {
+      if (idIndex[slot] == idAbs) return ptrIndex[slot];
+      if (idIndex[slot] < 0) return NULL;
+    }
+  }
+
+  // Add an entry of pdt to the index, or rebuild the index from scratch.
+  void   indexParticle(int idAbs);
+  void   rebuildIndex();
+
   // Method for common setting of particle-specific info.
   void   initCommon();
 
@@ -68,6 +68,12 @@ public:
   virtual double xfVal(int id, double x, double Q2);
   virtual double xfSea(int id, double x, double Q2);
 
+  // Read out parton densities for a batch of flavours and (x, Q2) points,
+  // with the same results as xf. Grid-based sets evaluate only the
+  // requested flavour at each point, rather than all of them.
+  virtual void xfBatch(const vector<int>& ids, const vector<double>& xVec,
+    const vector<double>& Q2Vec, vector<double>& xfVec);
+
   // Check whether x and Q2 values fall inside the fit bounds (LHAPDF6 only).
   virtual bool insideBounds(double, double) {return true;}
 
@@ -154,6 +160,15 @@ protected:
   // Resolve valence content for assumed meson. Possibly modified later.
   void setValenceContent();
 
+  // Which of the stored densities xf returns for a flavour, for xfBatch.
+  int xfQuantity(int id) const;
+
+  // Check whether a batch point shares (x, Q2) with a neighbour.
+  bool isSharedPoint(int i, const vector<double>& xVec,
+    const vector<double>& Q2Vec) const { int n = xVec.size();
+    return (i > 0 && xVec[i] == xVec[i-1] && Q2Vec[i] == Q2Vec[i-1])
+      || (i + 1 < n && xVec[i+1] == xVec[i] && Q2Vec[i+1] == Q2Vec[i]); }
+
   // Update parton densities.
   virtual void xfUpdate(int id, double x, double Q2) = 0;
 
@@ -240,6 +255,10 @@ public:
     alphaSQ0(), alphaSMZ(), distance(), tolerance(), xx(), qq(),
     c() {init( is, infoPtr);}
 
+  // Batch of PDF values, evaluating only the requested flavours.
+  void xfBatch(const vector<int>& ids, const vector<double>& xVec,
+    const vector<double>& Q2Vec, vector<double>& xfVec);
+
 private:
 
   // Constants: could only be changed in the code itself.
@@ -318,6 +337,10 @@ public:
   // Allow extrapolation beyond boundaries. This is optional.
   void setExtrapolate(bool doExtraPolIn) {doExtraPol = doExtraPolIn;}
 
+  // Batch of PDF values, evaluating only the requested flavours.
+  void xfBatch(const vector<int>& ids, const vector<double>& xVec,
+    const vector<double>& Q2Vec, vector<double>& xfVec);
+
 private:
 
   // Constants: could only be changed in the code itself.
@@ -905,8 +928,18 @@ public:
   // Allow extrapolation beyond boundaries. This is optional.
   void setExtrapolate(bool doExtraPolIn) {doExtraPol = doExtraPolIn;}
 
+  // Batch of PDF values, evaluating only the requested flavours.
+  void xfBatch(const vector<int>& ids, const vector<double>& xVec,
+    const vector<double>& Q2Vec, vector<double>& xfVec);
+
 private:
 
+  // Location in the grid and interpolation weights for an (x, Q2) point.
+  struct GridPoint {
+    int    inx, m3x, n3q, m3q;
+    double wx[4], wq[4];
+  };
+
   // Variables to be set during code initialization.
   bool   doExtraPol;
   int    nx, nq, nqSub;
@@ -925,9 +958,13 @@ private:
   // Update PDF values.
   void xfUpdate(int id, double x, double Q2);
 
-  // Interpolation in the grid for a given PDF flavour.
+  // Interpolation in the grid for all PDF flavours.
   void xfxevolve(double x, double Q2);
 
+  // Find location in the grid, and interpolate for one PDF flavour.
+  void   xfxLocate(double x, double Q2, GridPoint& pt);
+  double xfxInterpolate(int iid, double x, const GridPoint& pt);
+
 };
 
 //==========================================================================
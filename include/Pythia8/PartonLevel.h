@@ -230,6 +230,9 @@ private:
   // The Junction splitting class used to split junctions systems.
   JunctionSplitting junctionSplitting;
 
+  // Copy of the event record to restore after failed colour reconnection.
+  Event eventSave;
+
   // The Diffraction class is for hard diffraction selection.
   HardDiffraction hardDiffraction;
 
@@ -29,6 +29,48 @@ namespace Pythia8 {
 
 //==========================================================================
 
+// The ProcessSelector class picks one of a set of process containers
+// with probability proportional to its cross section maximum. A Fenwick
+// (binary indexed) tree gives O(log N) selection, and O(log N) update
+// when a single maximum changes. Negative maxima, as may occur for
+// Les Houches input, revert to the simple linear search.
+
+class ProcessSelector {
+
+public:
+
+  // Constructor.
+  ProcessSelector() : nSize(), nHigh(), useTree(), sumNow() {}
+
+  // Set up from the current maxima of the containers.
+  void init(vector<ProcessContainer*>& containerPtrs);
+
+  // Update the maximum of a single container.
+  void update(int i, double sigmaMaxIn);
+
+  // Pick a container, given a random number in the range [0, 1).
+  int pick(double rndmIn) const;
+
+  // Sum of all maxima, and whether the tree is used.
+  double sum()     const {return sumNow;}
+  bool   isTree()  const {return useTree;}
+
+private:
+
+  // Number of containers, and largest power of two not above it.
+  int    nSize, nHigh;
+
+  // Use tree or linear search. Sum of maxima.
+  bool   useTree;
+  double sumNow;
+
+  // Current maxima, and Fenwick tree of partial sums (1-based).
+  vector<double> sigmaMaxs, tree;
+
+};
+
+//==========================================================================
+
 // The ProcessLevel class contains the top-level routines to generate
 // the characteristic "hard" process of an event.
 
@@ -42,7 +84,8 @@ public:
     doMPI(), doWt2(), startColTag(), maxPDFreweight(), mHatMin1(), mHatMax1(),
     pTHatMin1(), pTHatMax1(), mHatMin2(), mHatMax2(), pTHatMin2(), pTHatMax2(),
     sigmaND(), beamHasGamma(), gammaMode(), iContainer(), iLHACont(-1),
-    sigmaMaxSum(), i2Container(), sigma2MaxSum(), infoPtr(), particleDataPtr(),
+    sigmaMaxSum(), i2Container(), sigma2MaxSum(), nPick(), nPickAcc(),
+    nMaxUpdate(), infoPtr(), particleDataPtr(),
     rndmPtr(),  beamAPtr(), beamBPtr(), beamGamAPtr(), beamGamBPtr(),
     beamVMDAPtr(), beamVMDBPtr(), couplingsPtr(), sigmaTotPtr(),
     slhaInterfacePtr(), userHooksPtr(), lhaUpPtr() {}
@@ -76,6 +119,9 @@ public:
   // Print statistics on cross sections and number of events.
   void statistics(bool reset = false);
 
+  // Print statistics on the selection between subprocesses.
+  void selectionStatistics(bool reset = false);
+
   // Reset statistics.
   void resetStatistics();
 
@@ -117,6 +163,12 @@ private:
   int    i2Container;
   double sigma2MaxSum;
 
+  // Selection between the containers of the first and second process.
+  ProcessSelector selector, selector2;
+
+  // Statistics on picks, successful picks and updates of maxima.
+  long   nPick, nPickAcc, nMaxUpdate;
+
   // Single half-dummy container for LHA input of resonance decay only.
   ProcessContainer containerLHAdec;
 
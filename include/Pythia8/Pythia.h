@@ -74,6 +74,12 @@ public:
   Pythia( istream& settingsStrings, istream& particleDataStrings,
     bool printBanner = true);
 
+  // Constructor reading settings and particle database from a binary
+  // snapshot, with fall-back to the XML files if the snapshot does not
+  // match the current version.
+  Pythia( istream& snapshotIn, string xmlDir = "../share/Pythia8/xmldoc",
+    bool printBanner = true);
+
   // Destructor. (See Pythia.cc file.)
   ~Pythia();
 
@@ -83,6 +89,12 @@ public:
   // Check consistency of version numbers (called by constructors).
   bool checkVersion();
 
+  // Write or read a binary snapshot of the settings and particle database.
+  bool writeSnapshot(string fileName);
+  bool writeSnapshot(ostream& os);
+  bool readSnapshot(string fileName);
+  bool readSnapshot(istream& is);
+
   // Read in one update for a setting or particle data from a single line.
   bool readString(string, bool warn = true);
 
@@ -287,7 +299,8 @@ private:
 
   // Constants: could only be changed in the code itself.
   static const double VERSIONNUMBERHEAD, VERSIONNUMBERCODE;
-  static const int    NTRY, SUBRUNDEFAULT;
+  static const int    NTRY, SUBRUNDEFAULT, SNAPSHOTFORMAT;
+  static const string SNAPSHOTTAG;
 
   // Initialization data, extracted from database.
   string xmlPath;
@@ -406,6 +419,10 @@ private:
   PartonVertex* partonVertexPtr;
   bool          useNewPartonVertex;
 
+  // Spare copies of the event records, to restore after failures.
+  // Kept as members so that their space is reused between events.
+  Event processSave, spareEvent;
+
   // The main generator class to define the core process of the event.
   ProcessLevel processLevel;
 
@@ -440,6 +457,13 @@ private:
   // Write the Pythia banner, with symbol and version information.
   void banner();
 
+  // Find the path to the XML files, and read them (called by constructors).
+  void findXMLPath(string xmlDir);
+  bool readXMLFiles();
+
+  // Checksum of the data part of a snapshot.
+  unsigned int snapshotChecksum(const string& data);
+
   // Check for lines in file that mark the beginning of new subrun.
   int readSubrun(string line, bool warn = true);
 
@@ -28,6 +28,22 @@ class Couplings;
 
 //==========================================================================
 
+// The ResonanceWidthTable contains the partial widths of the decay
+// channels of a resonance at a set of masses, in increasing order,
+// for linear interpolation between them.
+
+class ResonanceWidthTable {
+
+public:
+
+  // Masses and partial widths, widths[iMass][iChannel].
+  vector<double>           mass;
+  vector< vector<double> > widths;
+
+};
+
+//==========================================================================
+
 // The ResonanceWidths is the base class. Also used for generic resonaces.
 
 class ResonanceWidths {
@@ -45,6 +61,10 @@ public:
   virtual bool init(Info* infoPtrIn, Settings* settingsPtrIn,
     ParticleData* particleDataPtrIn, Couplings* couplingsPtrIn);
 
+  // Tabulate partial widths as a function of mass, if so requested.
+  // Done after all resonances have been initialized.
+  void initTables();
+
   // Return identity of particle species.
   int id() const {return idRes;}
 
@@ -80,12 +100,13 @@ protected:
     GamMRat(), openPos(), openNeg(), forceFactor(), iChannel(), onMode(),
     meMode(), mult(), id1(), id2(), id3(), id1Abs(), id2Abs(), id3Abs(),
     idInFlav(), widNow(), mHat(), mf1(), mf2(), mf3(), mr1(), mr2(), mr3(),
-    ps(), kinFac(), alpEM(), alpS(), colQ(), preFac(), particlePtr(),
+    ps(), kinFac(), alpEM(), alpS(), colQ(), preFac(), useTables(),
+    checkTables(), tableAccuracy(), mMinTable(), mMaxTable(), particlePtr(),
     infoPtr(), settingsPtr(), particleDataPtr(), couplingsPtr() {}
 
   // Constants: could only be changed in the code itself.
-  static const int    NPOINT;
-  static const double MASSMIN, MASSMARGIN;
+  static const int    NPOINT, NTABLE, NTABLEPEAK, NTABLEMAX;
+  static const double MASSMIN, MASSMARGIN, TABLEMASSMAX, TABLEMINSTEP;
 
   // Particle properties always present.
   int    idRes, hasAntiRes;
@@ -99,6 +120,12 @@ protected:
   double widNow, mHat, mf1, mf2, mf3, mr1, mr2, mr3, ps, kinFac,
          alpEM, alpS, colQ, preFac;
 
+  // Tabulated partial widths, one table for each incoming flavour
+  // that gives different widths.
+  bool   useTables, checkTables;
+  double tableAccuracy, mMinTable, mMaxTable;
+  map<int, ResonanceWidthTable> widthTables;
+
   // Pointer to properties of the particle species.
   ParticleDataEntry* particlePtr;
 
@@ -130,6 +157,22 @@ protected:
   // Optional argument calledFromInit only used for Z0.
   virtual void calcWidth(bool = false) {}
 
+  // Incoming flavours that give different widths need separate tables.
+  // Only used for gamma*/Z0 mixes and alike; else all share one table.
+  virtual int tableFlav(int) {return 0;}
+
+  // Calculate partial width of a decay channel at the current mass.
+  double channelWidth(int iChannelIn);
+
+  // Find the width table for an incoming flavour; set it up if needed.
+  ResonanceWidthTable& widthTable(int idInFlavIn);
+
+  // Calculate partial widths at a given mass, and refine a table
+  // between two masses until linear interpolation is good enough.
+  void tableWidths(double mHatIn, int idInFlavIn, vector<double>& widths);
+  void refineTable(ResonanceWidthTable& table, int idInFlavIn, double mA,
+    const vector<double>& widA, double mB, const vector<double>& widB);
+
   // Simple routines for matrix-element integration over Breit-Wigners.
   double numInt1BW(double mHatIn, double m1, double Gamma1, double mMin1,
     double m2, int psMode = 1);
@@ -183,6 +226,9 @@ private:
   // Caclulate width for currently considered channel.
   virtual void calcWidth(bool calledFromInit = false);
 
+  // Widths depend on incoming flavour through interference.
+  virtual int tableFlav(int idInFlavIn) {return abs(idInFlavIn);}
+
 };
 
 //==========================================================================
@@ -381,6 +427,9 @@ private:
   // Caclulate width for currently considered channel.
   virtual void calcWidth(bool calledFromInit = false);
 
+  // Widths depend on incoming flavour through interference.
+  virtual int tableFlav(int idInFlavIn) {return abs(idInFlavIn);}
+
 };
 
 //==========================================================================
@@ -532,6 +581,9 @@ private:
   // Caclulate width for currently considered channel.
   virtual void calcWidth(bool calledFromInit = false);
 
+  // Widths depend on incoming flavour through interference.
+  virtual int tableFlav(int idInFlavIn) {return abs(idInFlavIn);}
+
 };
 
 //==========================================================================
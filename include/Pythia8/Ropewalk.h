@@ -17,6 +17,7 @@
 
 #include "Pythia8/Basics.h"
 #include "Pythia8/Event.h"
+#include "Pythia8/FragmentationFlavZpT.h"
 #include "Pythia8/FragmentationSystems.h"
 #include "Pythia8/Info.h"
 #include "Pythia8/ParticleData.h"
@@ -248,6 +249,12 @@ public:
 
 private:
 
+  // Index the dipoles in flat arrays, for the overlap searches.
+  void indexDipoles();
+
+  // Rapidity of a dipole end in a given frame, as Particle::y(m0, r).
+  double rapInFrame(const Vec4& p, double m2, const RotBstMatrix& r);
+
   // Parameters of the ropewalk.
   double r0, m0, pTcut;
   // Do shoving flag.
@@ -290,6 +297,14 @@ private:
   typedef multimap<pair<int,int>, RopeDipole> DMap;
   DMap dipoles;
 
+  // Index of the dipoles, in the same order: whether above the minimal
+  // mass, lab-frame rapidity range, and momenta and masses squared
+  // of the two ends.
+  vector<RopeDipole*> dipIndex;
+  vector<bool>        dipIsMassive;
+  vector<double>      dipYMin, dipYMax, dipM2End1, dipM2End2;
+  vector<Vec4>        dipPEnd1, dipPEnd2;
+
   // All excitations.
   vector< vector<Particle> > eParticles;
 
@@ -312,22 +327,22 @@ class RopeFragPars {
 public:
 
   // Constructor.
-  RopeFragPars() : infoPtr(), aIn(), adiqIn(), bIn(), rhoIn(), xIn(),
-    yIn(), xiIn(), sigmaIn(), kappaIn(), aEff(), adiqEff(), bEff(),
-    rhoEff(), xEff(), yEff(), xiEff(), sigmaEff(), kappaEff(),
-    beta() {}
+  RopeFragPars() : infoPtr(), hExact(-1.), aIn(), adiqIn(), bIn(), rhoIn(),
+    xIn(), yIn(), xiIn(), sigmaIn(), kappaIn(), aEff(), adiqEff(), bEff(),
+    rhoEff(), xEff(), yEff(), xiEff(), sigmaEff(), kappaEff(), beta() {}
 
   // The init function sets up initial parameters from settings.
   void init(Info* infoPtrIn, Settings& settings);
 
-  // Return parameters at given string tension, ordered by their
-  // name for easy insertion in settings.
-  map<string,double> getEffectiveParameters(double h);
+  // Return parameters at given string tension, interpolated in a dense
+  // table or, optionally, calculated exactly.
+  FlavZpTPars getEffectiveParameters(double h, bool exact = false);
 
 private:
 
   // Constants: can only be changed in the code itself.
-  static const double DELTAA, ACONV, ZCUT;
+  static const double DELTAA, ACONV, ZCUT, HTABMAX;
+  static const int    NTABPERUNIT;
 
   // Get the Fragmentation function a parameter from cache or calculate it.
   double getEffectiveA(double thisb, double mT2, bool isDiquark);
@@ -335,8 +350,11 @@ private:
   // Calculate the effective parameters.
   bool calculateEffectiveParameters(double h);
 
-  // Insert calculated parameters in cache for later (re-)use.
-  bool insertEffectiveParameters(double h);
+  // Collect the current effective parameters.
+  FlavZpTPars effectiveParameters();
+
+  // Return table entry, calculating it first if needed.
+  const FlavZpTPars& tableEntry(int iTab);
 
   // Calculate the a parameter.
   double aEffective(double aOrig, double thisb, double mT2);
@@ -353,8 +371,14 @@ private:
   // The info pointer.
   Info* infoPtr;
 
-  // Parameter caches to re-use calculations. Sets of parameters, ordered in h.
-  map<double, map<string, double> > parameters;
+  // Parameter table at h = iTab / NTABPERUNIT, filled on demand, with
+  // flags for which entries have been calculated.
+  vector<FlavZpTPars> parTable;
+  vector<bool>        parFilled;
+
+  // The last exactly calculated set of parameters.
+  double      hExact;
+  FlavZpTPars parExact;
 
   // Values of the a-parameter ordered in b*mT2 grid.
   map<double, double> aMap;
@@ -420,10 +444,10 @@ private:
 
   // Find breakup placement and fetch effective parameters.
   // For model depending on vertex information.
-  map<string, double> fetchParameters(double m2Had, vector<int> iParton,
+  FlavZpTPars fetchParameters(double m2Had, vector<int> iParton,
     int endId);
   // For simple Buffon model.
-  map<string, double> fetchParametersBuffon(double m2Had, vector<int> iParton,
+  FlavZpTPars fetchParametersBuffon(double m2Had, vector<int> iParton,
     int endId);
 
   // Pointer to settings.
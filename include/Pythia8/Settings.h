@@ -12,6 +12,7 @@
 // MVec: vector of Modes (integers).
 // PVec: vector of Parms (doubles).
 // WVec: vector of Words (strings).
+// SnapshotWriter and SnapshotReader: binary input/output of databases.
 // Settings: maps of flags, modes, parms and words with input/output.
 
 #ifndef Pythia8_Settings_H
@@ -188,6 +189,169 @@ public:
 
 //==========================================================================
 
+// Handles to the current value of a flag, mode, parm or word. They are
+// obtained once from Settings, typically at initialization, and then
+// give the value by a pointer dereference instead of a string lookup.
+// Later changes of the value in Settings are seen. A handle is only
+// valid as long as the Settings object it was obtained from.
+
+class FlagRef {
+
+public:
+
+  // Constructors. Default points to a false value.
+  FlagRef() : valPtr(&DEFAULTVAL) {}
+  explicit FlagRef(const bool* valPtrIn) : valPtr(valPtrIn) {}
+
+  // Current value.
+  bool operator()() const {return *valPtr;}
+
+private:
+
+  // Default value and pointer to current value.
+  static const bool DEFAULTVAL;
+  const bool* valPtr;
+
+};
+
+class ModeRef {
+
+public:
+
+  // Constructors. Default points to a zero value.
+  ModeRef() : valPtr(&DEFAULTVAL) {}
+  explicit ModeRef(const int* valPtrIn) : valPtr(valPtrIn) {}
+
+  // Current value.
+  int operator()() const {return *valPtr;}
+
+private:
+
+  // Default value and pointer to current value.
+  static const int DEFAULTVAL;
+  const int* valPtr;
+
+};
+
+class ParmRef {
+
+public:
+
+  // Constructors. Default points to a zero value.
+  ParmRef() : valPtr(&DEFAULTVAL) {}
+  explicit ParmRef(const double* valPtrIn) : valPtr(valPtrIn) {}
+
+  // Current value.
+  double operator()() const {return *valPtr;}
+
+private:
+
+  // Default value and pointer to current value.
+  static const double DEFAULTVAL;
+  const double* valPtr;
+
+};
+
+class WordRef {
+
+public:
+
+  // Constructors. Default points to a blank value.
+  WordRef() : valPtr(&DEFAULTVAL) {}
+  explicit WordRef(const string* valPtrIn) : valPtr(valPtrIn) {}
+
+  // Current value.
+  const string& operator()() const {return *valPtr;}
+
+private:
+
+  // Default value and pointer to current value.
+  static const string DEFAULTVAL;
+  const string* valPtr;
+
+};
+
+//==========================================================================
+
+// Helper classes for the binary snapshot of the Settings and ParticleData
+// databases. Values are stored in the native binary representation, so
+// a snapshot can only be read on the same kind of platform. Strings and
+// vectors are preceded by their length.
+
+class SnapshotWriter {
+
+public:
+
+  // Constructor.
+  SnapshotWriter(ostream& osIn) : os(osIn) {}
+
+  // Write a single value, a string or a vector.
+  void write(bool val) {char c = (val) ? 1 : 0; os.write( &c, 1);}
+  void write(int val) {os.write( (const char*)&val, sizeof(int));}
+  void write(double val) {os.write( (const char*)&val, sizeof(double));}
+  void write(const string& val) {write( int(val.size()));
+    os.write( val.data(), val.size());}
+  template<typename T> void write(const vector<T>& val) {
+    write( int(val.size()));
+    for (int i = 0; i < int(val.size()); ++i) write( T(val[i]));}
+
+  // Check that all writing worked.
+  bool good() const {return os.good();}
+
+private:
+
+  // The output stream.
+  ostream& os;
+
+};
+
+//--------------------------------------------------------------------------
+
+// Reader of the binary snapshot written by SnapshotWriter.
+
+class SnapshotReader {
+
+public:
+
+  // Constructor.
+  SnapshotReader(istream& isIn) : is(isIn) {}
+
+  // Read a single value, a string or a vector. False if reading failed.
+  bool read(bool& val) {char c = 0; is.read( &c, 1); val = (c != 0);
+    return is.good();}
+  bool read(int& val) {is.read( (char*)&val, sizeof(int));
+    return is.good();}
+  bool read(double& val) {is.read( (char*)&val, sizeof(double));
+    return is.good();}
+  bool read(string& val) {
+    int n = 0;
+    if (!read(n) || n < 0 || n > MAXSIZE) return false;
+    val.resize(n);
+    if (n > 0) is.read( &val[0], n);
+    return is.good();}
+  template<typename T> bool read(vector<T>& val) {
+    int n = 0;
+    if (!read(n) || n < 0 || n > MAXSIZE) return false;
+    val.resize(n);
+    for (int i = 0; i < n; ++i) {
+      T tmp;
+      if (!read(tmp)) return false;
+      val[i] = tmp;
+    }
+    return true;}
+
+private:
+
+  // Sanity limit on the length of strings and vectors.
+  static const int MAXSIZE;
+
+  // The input stream.
+  istream& is;
+
+};
+
+//==========================================================================
+
 // This class holds info on flags (bool), modes (int), parms (double),
 // words (string), fvecs (vector of bool), mvecs (vector of int),
 // pvecs (vector of double) and wvecs (vector of string).
@@ -198,7 +362,7 @@ public:
 
   // Constructor.
   Settings() : infoPtr(), isInit(false), readingFailedSave(false),
-    lineSaved(false) {}
+    lineSaved(false), countLookupsNow(false) {}
 
   // Initialize Info pointer.
   void initPtr(Info* infoPtrIn) {infoPtr = infoPtrIn;}
@@ -293,6 +457,12 @@ public:
   vector<double> pvec(string keyIn);
   vector<string> wvec(string keyIn);
 
+  // Give back handle to current value, with check that key exists.
+  FlagRef flagRef(string keyIn);
+  ModeRef modeRef(string keyIn);
+  ParmRef parmRef(string keyIn);
+  WordRef wordRef(string keyIn);
+
   // Give back default value, with check that key exists.
   bool   flagDefault(string keyIn);
   int    modeDefault(string keyIn);
@@ -343,6 +513,10 @@ public:
   // Check initialisation status.
   bool getIsInit() {return isInit;}
 
+  // Write or read the complete database in binary form, for a snapshot.
+  bool writeSnapshot(ostream& os);
+  bool readSnapshot(istream& is);
+
   // Keep track whether any readings have failed, invalidating run setup.
   bool readingFailed() {return readingFailedSave;}
 
@@ -352,6 +526,12 @@ public:
   // Check whether any other processes than SoftQCD are switched on.
   bool onlySoftQCD();
 
+  // Count string-keyed value lookups, e.g. after initialization, and
+  // list the most frequent ones. Only active when the library is
+  // compiled with -DPYTHIA8_COUNT_LOOKUPS.
+  void countLookups(bool countIn) {countLookupsNow = countIn;}
+  void listLookups();
+
  private:
 
   // Pointer to various information on the generation.
@@ -392,6 +572,10 @@ public:
   vector<string> readStringHistory;
   map<int, vector<string> > readStringSubrun;
 
+  // Counters of string-keyed value lookups.
+  bool   countLookupsNow;
+  map<string, long> lookupCounts;
+
   // Print out table of database, called from listAll and listChanged.
   void list(bool doListAll, bool doListString, string match);
 
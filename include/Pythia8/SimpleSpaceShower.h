@@ -187,6 +187,9 @@ private:
          strengthIntAsym, weakEnhancement, mZ, gammaZ, thetaWRat, mW, gammaW,
          weakMaxWt, vetoWeakDeltaR2;
 
+  // Handle to a setting that is read during the evolution.
+  ParmRef sudakovMin;
+
   // alphaStrong and alphaEM calculations.
   AlphaStrong alphaS;
   AlphaEM alphaEM;
@@ -30,7 +30,8 @@ public:
     isHiddenValley(false), colvType(0), MEmix(0.), MEorder(true),
     MEsplit(true), MEgluinoRec(false), isFlexible(false), flavour(), iAunt(),
     mRad(), m2Rad(), mRec(), m2Rec(), mDip(), m2Dip(), m2DipCorr(), pT2(),
-    m2(), z(), mFlavour(), asymPol(), flexFactor(), pAccept() { }
+    m2(), z(), mFlavour(), asymPol(), flexFactor(), pAccept(),
+    hasTrial(false), keyTrial(), pT2begTrial(), pT2endTrial() { }
   TimeDipoleEnd(int iRadiatorIn, int iRecoilerIn, double pTmaxIn = 0.,
     int colIn = 0, int chgIn = 0, int gamIn = 0, int weakTypeIn = 0,
     int isrIn = 0, int systemIn = 0, int MEtypeIn = 0, int iMEpartnerIn = -1,
@@ -46,7 +47,8 @@ public:
     MEorder (MEorderIn), MEsplit(MEsplitIn), MEgluinoRec(MEgluinoRecIn),
     isFlexible(isFlexibleIn), hasJunction(false), flavour(), iAunt(), mRad(),
     m2Rad(), mRec(), m2Rec(), mDip(), m2Dip(), m2DipCorr(), pT2(), m2(), z(),
-    mFlavour(), asymPol(), flexFactor(), pAccept()  { }
+    mFlavour(), asymPol(), flexFactor(), pAccept(), hasTrial(false),
+    keyTrial(), pT2begTrial(), pT2endTrial()  { }
 
   // Basic properties related to dipole and matrix element corrections.
   int    iRadiator, iRecoiler;
@@ -64,6 +66,13 @@ public:
   double mRad, m2Rad, mRec, m2Rec, mDip, m2Dip, m2DipCorr,
          pT2, m2, z, mFlavour, asymPol, flexFactor, pAccept;
 
+  // Trial emission kept for reuse, with the dipole properties and the
+  // evolution range it was found for.
+  static const int NKEYTRIAL = 16;
+  bool   hasTrial;
+  double keyTrial[NKEYTRIAL];
+  double pT2begTrial, pT2endTrial;
+
 };
 
 //==========================================================================
@@ -99,10 +108,11 @@ public:
     pTmaxFudgeMPI(), weakEnhancement(), vetoWeakDeltaR2(), twoHard(),
     dopTlimit1(), dopTlimit2(), dopTdamp(), pT2damp(), kRad(), kEmt(),
     pdfScale2(), doTrialNow(), canEnhanceEmission(), canEnhanceTrial(),
-    canEnhanceET(), doUncertaintiesNow(), dipSel(), iDipSel(), nHard(),
+    canEnhanceET(), doUncertaintiesNow(), dipSel(), iDipSel(),
+    cacheTrials(), useTrialCache(), nBeamChange(), nHard(),
     nFinalBorn(), nMaxGlobalBranch(), nGlobal(), globalRecoilMode(),
-    limitMUQ(), weakHardSize() { beamOffset = 0; pdfMode = 0;
-    useSystems = true; }
+    limitMUQ(), nFinalColNow(), hasHardFinal(), weakHardSize() {
+    beamOffset = 0; pdfMode = 0; useSystems = true; }
 
   // Destructor.
   virtual ~SimpleTimeShower() {}
@@ -208,6 +218,11 @@ private:
          alphaHVfix, LambdaHV, pThvCut, pT2hvCut, mHV, pTmaxFudgeMPI,
          weakEnhancement, vetoWeakDeltaR2;
 
+  // Handles to settings that are read during the evolution.
+  FlagRef setScalesFromLHEF;
+  ModeRef nPartonsInBorn;
+  ParmRef sudakovMin;
+
   // alphaStrong and alphaEM calculations.
   AlphaStrong alphaS;
   AlphaEM     alphaEM;
@@ -232,6 +247,14 @@ private:
   TimeDipoleEnd* dipSel;
   int iDipSel;
 
+  // Reuse of the trial evolution of unchanged dipole ends. The counter
+  // of beam changes tells when the stored trials are no longer valid.
+  bool cacheTrials, useTrialCache;
+  int  nBeamChange;
+  void trialKey( const TimeDipoleEnd& dip, double* key) const;
+  bool hasValidTrial( const TimeDipoleEnd& dip, double pT2begDip) const;
+  void storeTrial( TimeDipoleEnd& dip, double pT2begDip, double pT2endDip);
+
   // Setup a dipole end, either QCD, QED/photon, weak or Hidden Valley one.
   void setupQCDdip( int iSys, int i, int colTag,  int colSign, Event& event,
     bool isOctetOnium = false, bool limitPTmaxIn = true);
@@ -299,6 +322,13 @@ private:
   int nGlobal, globalRecoilMode;
   // Switch to constrain recoiling system.
   bool limitMUQ;
+  // Quantities found once per pTnext call instead of once per dipole end:
+  // the number of final coloured partons, whether entries descend from
+  // the hard partons, and the final partons of the global recoil.
+  int nFinalColNow;
+  bool hasHardFinal;
+  vector<int> hardDescendant, iHardFinal, iChainHard;
+  bool isHardDescendant( const Event& event, int i);
 
   // Calculate uncertainty-band weights for accepted/rejected trial branching.
   // Usage: calcUncertainties( accept, pAccept, enhance, vp, dip,
@@ -60,6 +60,11 @@ public:
     virtual int     overflow( int c = EOF);
     virtual int     underflow();
     virtual int     sync();
+    virtual std::streampos seekoff( std::streamoff off,
+        std::ios_base::seekdir way,
+        std::ios_base::openmode which = std::ios_base::in);
+    virtual std::streampos seekpos( std::streampos pos,
+        std::ios_base::openmode which = std::ios_base::in);
 };
 
 // -------------------------------------------------------------------------
@@ -0,0 +1,141 @@
+// AngantyrParallel.h is a part of the PYTHIA event generator.
+// Copyright (C) 2020 Torbjorn Sjostrand.
+// PYTHIA is licenced under the GNU GPL v2 or later, see COPYING for details.
+// Please respect the MCnet Guidelines, see GUIDELINES for details.
+
+// This file contains a version of the Angantyr heavy ion model that
+// generates the independent nucleon-nucleon sub-events of an event on
+// a number of threads.
+// ParallelFit: a SubCollisionModel fitted with a parallel population.
+// AngantyrParallel: Angantyr with parallel sub-events and fitting.
+// Note: requires C++11 threads, i.e. compile with -std=c++11 -pthread.
+
+#ifndef Pythia8_AngantyrParallel_H
+#define Pythia8_AngantyrParallel_H
+
+#include "Pythia8/Pythia.h"
+#include "Pythia8/HeavyIons.h"
+#include <atomic>
+#include <thread>
+
+namespace Pythia8 {
+
+//==========================================================================
+
+// ParallelFit evaluates the parameter sets of each generation in the
+// genetic-algorithm fit of a SubCollisionModel on a number of threads.
+// Each thread uses a copy of the model, and each parameter set has its
+// own random number seed, so the result is the same as when fitting
+// sequentially.
+
+template<class Model>
+class ParallelFit : public Model {
+
+public:
+
+  // Constructor, with the number of threads and the model option.
+  ParallelFit(int nThreadsIn, int modeIn = 0)
+    : Model(modeIn), nThreads(nThreadsIn) {}
+
+  // Calculate the Chi2 of all parameter sets in the population.
+  virtual void evalPopulation(const vector< vector<double> >& pop,
+    const vector<int>& seeds, vector<double>& chi2s) {
+    int nPop = pop.size();
+    chi2s.resize(nPop);
+    std::atomic<int> iNext(0);
+    auto work = [&]() {
+      Model model(*this);
+      for (int i = iNext++; i < nPop; i = iNext++)
+        chi2s[i] = model.fitChi2(pop[i], seeds[i]);
+    };
+    vector<std::thread> threadPool;
+    for (int iThread = 1; iThread < min(nThreads, nPop); ++iThread)
+      threadPool.push_back(std::thread(work));
+    work();
+    for (int i = 0; i < int(threadPool.size()); ++i) threadPool[i].join();
+  }
+
+private:
+
+  // The number of threads.
+  int nThreads;
+
+};
+
+//==========================================================================
+
+// AngantyrParallel is used in place of the default Angantyr object,
+// by handing it to Pythia::setHeavyIonsPtr before Pythia::init. Each
+// thread has its own copy of the internal minimum bias Pythia object.
+// Every sub-event is generated with its own random number seed, see
+// Angantyr:seedSubEvents, so the events do not depend on the number
+// of threads. The sub-events are stitched together in the same order
+// as in a sequential run. The default sub-collision models are fitted
+// in parallel with ParallelFit. UserHooks set for the internal minimum
+// bias object are not shared with the other threads, so then all
+// sub-events are generated on the calling thread. HIUserHooks are only
+// called from the calling thread.
+
+class AngantyrParallel : public Angantyr {
+
+public:
+
+  // Constructor. By default one thread per hardware core is used.
+  AngantyrParallel(Pythia& mainPythiaIn, int nThreadsIn = 0)
+    : Angantyr(mainPythiaIn), nThreads(nThreadsIn) {
+    if (nThreads <= 0)
+      nThreads = max(1, int(std::thread::hardware_concurrency()));
+  }
+
+  // Initialize the model, and then the additional workers.
+  virtual bool init() {
+    mainPythiaPtr->settings.flag("Angantyr:seedSubEvents", true);
+    if (!Angantyr::init()) return false;
+    return addWorkers(nThreads - 1);
+  }
+
+  // The number of threads used.
+  int threads() const {return nThreads;}
+
+protected:
+
+  // Use parallel fitting for the models with parameters to fit.
+  virtual SubCollisionModel* newSubCollisionModel(int model) {
+    if (model == 1) return new ParallelFit<DoubleStrikman>(nThreads);
+    if (model == 2) return new ParallelFit<DoubleStrikman>(nThreads, 1);
+    return Angantyr::newSubCollisionModel(model);
+  }
+
+  // Let the workers pick tasks from the list until all are done. The
+  // calling thread takes the part of the first worker.
+  virtual void runSubEventTasks(vector<SubEventTask>& tasks) {
+    int nTask = tasks.size();
+    int nRun  = min(nWorkers(), nTask);
+    if (nRun <= 1) {
+      Angantyr::runSubEventTasks(tasks);
+      return;
+    }
+    std::atomic<int> iNext(0);
+    auto work = [&](int iWorker) {
+      for (int i = iNext++; i < nTask; i = iNext++)
+        genSubEvent(iWorker, tasks[i]);
+    };
+    vector<std::thread> threadPool;
+    for (int iWorker = 1; iWorker < nRun; ++iWorker)
+      threadPool.push_back(std::thread(work, iWorker));
+    work(0);
+    for (int i = 0; i < int(threadPool.size()); ++i) threadPool[i].join();
+  }
+
+private:
+
+  // The number of threads.
+  int nThreads;
+
+};
+
+//==========================================================================
+
+} // end namespace Pythia8
+
+#endif // Pythia8_AngantyrParallel_H
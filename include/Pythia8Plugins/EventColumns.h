@@ -0,0 +1,622 @@
+// EventColumns.h is a part of the PYTHIA event generator.
+// Copyright (C) 2020 Torbjorn Sjostrand.
+// PYTHIA is licenced under the GNU GPL v2 or later, see COPYING for details.
+// Please respect the MCnet Guidelines, see GUIDELINES for details.
+
+// This file contains a compact binary format for storing PYTHIA events,
+// together with some event information, and reading them back.
+// EventColumnsBase: the layout of the file, shared by writer and reader.
+// EventColumnsWriter: collect events in blocks and write them to file.
+// EventColumnsReader: map a file into memory and give access to columns.
+// The events are stored in blocks, where each property is stored as a
+// contiguous column over all particles (or events) of the block. The
+// reader uses the columns in place, without constructing Particle
+// objects. Blocks can be compressed with zlib, if PYTHIA is configured
+// with gzip support, at the price of a decompression when reading.
+// The file is in the native byte order, and is not portable between
+// platforms of different endianness. The reader requires POSIX mmap.
+
+#ifndef Pythia8_EventColumns_H
+#define Pythia8_EventColumns_H
+
+#include "Pythia8/Pythia.h"
+#include <fcntl.h>
+#include <stdint.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifdef GZIPSUPPORT
+#include <zlib.h>
+#endif
+
+namespace Pythia8 {
+
+//==========================================================================
+
+// EventColumnsBase defines the columns and the file layout.
+// A file begins with a FileHeader, followed by any number of blocks.
+// Each block has a BlockHeader and a payload with the columns in the
+// order: event doubles, weights, particle doubles, event ints,
+// particle offsets, weight offsets, particle ints. The payload is
+// padded to a multiple of eight bytes, so all columns are aligned.
+
+class EventColumnsBase {
+
+public:
+
+  // Event-level columns of doubles and ints.
+  enum EventDouble {QFAC, QREN, PTHAT, SCALUP, ALPHAS, ALPHAEM, X1, X2,
+    NEVENTDOUBLE};
+  enum EventInt {CODE, ID1, ID2, NEVENTINT};
+
+  // Particle-level columns of doubles and ints.
+  enum ParticleDouble {PX, PY, PZ, E, M, SCALE, POL, XPROD, YPROD, ZPROD,
+    TPROD, TAU, NPARTDOUBLE};
+  enum ParticleInt {ID, STATUS, MOTHER1, MOTHER2, DAUGHTER1, DAUGHTER2, COL,
+    ACOL, NPARTINT};
+
+protected:
+
+  // File and block headers.
+  struct FileHeader {
+    char     magic[8];
+    uint32_t version, byteOrder, sizeInt, sizeDouble, flags, nBlockEvent;
+  };
+  struct BlockHeader {
+    char     magic[4];
+    uint32_t nEvent, nParticle, nWeight, compressed, dummy;
+    uint64_t rawSize, storedSize;
+  };
+
+  // Constants: file format version, byte order test, compression flag.
+  static const uint32_t VERSION = 1;
+  static const uint32_t BYTEORDER = 0x01020304;
+  static const uint32_t COMPRESSED = 1;
+
+  // Identification strings of file and block.
+  static const char* fileMagic() {return "PY8COLS";}
+  static const char* blockMagic() {return "BLK";}
+
+  // Size of the payload of a block, in bytes, including padding.
+  static uint64_t payloadSize(uint64_t nEvent, uint64_t nParticle,
+    uint64_t nWeight) {
+    uint64_t nDouble = NEVENTDOUBLE * nEvent + nWeight
+      + NPARTDOUBLE * nParticle;
+    uint64_t nInt = NEVENTINT * nEvent + 2 * (nEvent + 1)
+      + NPARTINT * nParticle;
+    uint64_t size = nDouble * sizeof(double) + nInt * sizeof(int);
+    return 8 * ((size + 7) / 8);
+  }
+
+};
+
+//==========================================================================
+
+// EventColumnsWriter collects the events of a block column by column,
+// and writes the block to file when it is full, or when closed.
+
+class EventColumnsWriter : public EventColumnsBase {
+
+public:
+
+  // Constructor, with the file name, the number of events per block,
+  // and whether the blocks should be compressed.
+  EventColumnsWriter(string fileName, int nBlockEventIn = 1000,
+    bool compressIn = false) : nBlockEvent(max(1, nBlockEventIn)),
+    compress(compressIn), nEventSave(0), nParticle(0) {
+#ifndef GZIPSUPPORT
+    if (compress) cout << " EventColumnsWriter warning: no gzip support, "
+                       << "blocks are not compressed." << endl;
+    compress = false;
+#endif
+    os.open(fileName.c_str(), ios::out | ios::binary);
+    if (!os) {
+      cout << " EventColumnsWriter error: could not open " << fileName
+           << endl;
+      return;
+    }
+    FileHeader head;
+    memset(&head, 0, sizeof(head));
+    strncpy(head.magic, fileMagic(), 8);
+    head.version     = VERSION;
+    head.byteOrder   = BYTEORDER;
+    head.sizeInt     = sizeof(int);
+    head.sizeDouble  = sizeof(double);
+    head.flags       = (compress) ? COMPRESSED : 0;
+    head.nBlockEvent = nBlockEvent;
+    os.write((const char*)&head, sizeof(head));
+    clearBlock();
+  }
+
+  // Destructor writes the last block.
+  ~EventColumnsWriter() {close();}
+
+  // Add an event, with event information taken from Info if provided.
+  bool writeEvent(const Event& event, Info* infoPtr = 0);
+
+  // Add the current event of a Pythia object.
+  bool writeEvent(Pythia& pythia) {
+    return writeEvent(pythia.event, &pythia.info);}
+
+  // Write the remaining events and close the file.
+  void close() {
+    if (!os.is_open()) return;
+    flush();
+    os.close();
+  }
+
+  // Check that the file is usable, and the number of events written.
+  bool isOpen() const {return os.is_open() && os.good();}
+  long nEvent() const {return nEventSave;}
+
+private:
+
+  // The writer owns an open file, and so cannot be copied or assigned.
+  EventColumnsWriter(const EventColumnsWriter&);
+  EventColumnsWriter& operator=(const EventColumnsWriter&);
+
+  // Write the current block to file.
+  bool flush();
+
+  // Reset the block buffers, keeping the allocated space.
+  void clearBlock() {
+    for (int i = 0; i < NEVENTDOUBLE; ++i) eventDoubles[i].resize(0);
+    for (int i = 0; i < NEVENTINT; ++i) eventInts[i].resize(0);
+    for (int i = 0; i < NPARTDOUBLE; ++i) partDoubles[i].resize(0);
+    for (int i = 0; i < NPARTINT; ++i) partInts[i].resize(0);
+    weights.resize(0);
+    partOffsets.assign(1, 0);
+    weightOffsets.assign(1, 0);
+  }
+
+  // Append a column to the raw block.
+  template<class T> void put(const vector<T>& col) {
+    if (col.empty()) return;
+    const char* data = (const char*)&col[0];
+    raw.insert(raw.end(), data, data + col.size() * sizeof(T));
+  }
+
+  // Settings and output stream.
+  int      nBlockEvent;
+  bool     compress;
+  ofstream os;
+
+  // Events written, and particles in the current block.
+  long     nEventSave;
+  int      nParticle;
+
+  // The columns of the current block.
+  vector<double> eventDoubles[NEVENTDOUBLE], partDoubles[NPARTDOUBLE],
+                 weights;
+  vector<int>    eventInts[NEVENTINT], partInts[NPARTINT], partOffsets,
+                 weightOffsets;
+
+  // Buffers for the raw and the compressed block.
+  vector<char>   raw, packed;
+
+};
+
+//--------------------------------------------------------------------------
+
+// Add an event to the current block, and write the block when full.
+
+inline bool EventColumnsWriter::writeEvent(const Event& event,
+  Info* infoPtr) {
+
+  if (!isOpen()) return false;
+
+  // Event information.
+  if (infoPtr != 0) {
+    eventDoubles[QFAC].push_back(infoPtr->QFac());
+    eventDoubles[QREN].push_back(infoPtr->QRen());
+    eventDoubles[PTHAT].push_back(infoPtr->pTHat());
+    eventDoubles[SCALUP].push_back(infoPtr->scalup());
+    eventDoubles[ALPHAS].push_back(infoPtr->alphaS());
+    eventDoubles[ALPHAEM].push_back(infoPtr->alphaEM());
+    eventDoubles[X1].push_back(infoPtr->x1());
+    eventDoubles[X2].push_back(infoPtr->x2());
+    eventInts[CODE].push_back(infoPtr->code());
+    eventInts[ID1].push_back(infoPtr->id1());
+    eventInts[ID2].push_back(infoPtr->id2());
+    for (int i = 0; i < infoPtr->nWeights(); ++i)
+      weights.push_back(infoPtr->weight(i));
+  } else {
+    for (int i = 0; i < NEVENTDOUBLE; ++i) eventDoubles[i].push_back(0.);
+    for (int i = 0; i < NEVENTINT; ++i) eventInts[i].push_back(0);
+    weights.push_back(1.);
+  }
+  weightOffsets.push_back(weights.size());
+
+  // Particle information, one column at a time.
+  for (int i = 0; i < event.size(); ++i) {
+    const Particle& pt = event[i];
+    partDoubles[PX].push_back(pt.px());
+    partDoubles[PY].push_back(pt.py());
+    partDoubles[PZ].push_back(pt.pz());
+    partDoubles[E].push_back(pt.e());
+    partDoubles[M].push_back(pt.m());
+    partDoubles[SCALE].push_back(pt.scale());
+    partDoubles[POL].push_back(pt.pol());
+    partDoubles[XPROD].push_back(pt.xProd());
+    partDoubles[YPROD].push_back(pt.yProd());
+    partDoubles[ZPROD].push_back(pt.zProd());
+    partDoubles[TPROD].push_back(pt.tProd());
+    partDoubles[TAU].push_back(pt.tau());
+    partInts[ID].push_back(pt.id());
+    partInts[STATUS].push_back(pt.status());
+    partInts[MOTHER1].push_back(pt.mother1());
+    partInts[MOTHER2].push_back(pt.mother2());
+    partInts[DAUGHTER1].push_back(pt.daughter1());
+    partInts[DAUGHTER2].push_back(pt.daughter2());
+    partInts[COL].push_back(pt.col());
+    partInts[ACOL].push_back(pt.acol());
+  }
+  nParticle += event.size();
+  partOffsets.push_back(nParticle);
+
+  // Write the block when full.
+  ++nEventSave;
+  if (int(eventInts[CODE].size()) >= nBlockEvent) return flush();
+  return true;
+
+}
+
+//--------------------------------------------------------------------------
+
+// Write the current block, if not empty, and start a new one.
+
+inline bool EventColumnsWriter::flush() {
+
+  int nEventBlock = eventInts[CODE].size();
+  if (nEventBlock == 0) return true;
+
+  // Collect the columns in the order of the file layout.
+  raw.resize(0);
+  for (int i = 0; i < NEVENTDOUBLE; ++i) put(eventDoubles[i]);
+  put(weights);
+  for (int i = 0; i < NPARTDOUBLE; ++i) put(partDoubles[i]);
+  for (int i = 0; i < NEVENTINT; ++i) put(eventInts[i]);
+  put(partOffsets);
+  put(weightOffsets);
+  for (int i = 0; i < NPARTINT; ++i) put(partInts[i]);
+  BlockHeader head;
+  memset(&head, 0, sizeof(head));
+  strncpy(head.magic, blockMagic(), 4);
+  head.nEvent    = nEventBlock;
+  head.nParticle = nParticle;
+  head.nWeight   = weights.size();
+  head.rawSize   = payloadSize(nEventBlock, nParticle, weights.size());
+  raw.resize(head.rawSize, 0);
+
+  // Optionally compress the block, unless it does not get smaller.
+  const char* data = &raw[0];
+  head.storedSize  = head.rawSize;
+#ifdef GZIPSUPPORT
+  if (compress) {
+    uLongf nPacked = compressBound(raw.size());
+    packed.resize(nPacked);
+    if (compress2((Bytef*)&packed[0], &nPacked, (const Bytef*)&raw[0],
+      raw.size(), Z_BEST_SPEED) == Z_OK && nPacked < raw.size()) {
+      head.compressed = COMPRESSED;
+      head.storedSize = 8 * ((nPacked + 7) / 8);
+      packed.resize(head.storedSize, 0);
+      data = &packed[0];
+    }
+  }
+#endif
+
+  // Write block and reset buffers.
+  os.write((const char*)&head, sizeof(head));
+  os.write(data, head.storedSize);
+  nParticle = 0;
+  clearBlock();
+  if (!os) {
+    cout << " EventColumnsWriter error: could not write block." << endl;
+    return false;
+  }
+  return true;
+
+}
+
+//==========================================================================
+
+// EventColumnsReader maps a file into memory, and steps through the
+// events. Columns of uncompressed blocks point directly into the
+// mapped file, while compressed blocks are unpacked one at a time.
+// The particle columns of the current event are given as pointers to
+// the first particle, i.e. the system entry 0 as in the Event class.
+
+class EventColumnsReader : public EventColumnsBase {
+
+public:
+
+  // Constructors and destructor.
+  EventColumnsReader() : mapPtr(0), mapSize(0), nEventSave(0),
+    iBlockNow(-1), iEventNow(-1), iLocal(0) {}
+  EventColumnsReader(string fileName) : mapPtr(0), mapSize(0),
+    nEventSave(0), iBlockNow(-1), iEventNow(-1), iLocal(0) {open(fileName);}
+  ~EventColumnsReader() {close();}
+
+  // Open a file and index its blocks, or release the file.
+  bool open(string fileName);
+  void close();
+
+  // Number of blocks and events in the file.
+  bool isOpen()     const {return mapPtr != 0;}
+  int  nBlock()     const {return blockOffsets.size();}
+  long nEvent()     const {return nEventSave;}
+
+  // Go to the next event, or to a given event number.
+  bool next() {return (iEventNow + 1 < nEventSave)
+    ? goToEvent(iEventNow + 1) : false;}
+  bool goToEvent(long iEvent);
+  void rewind() {iEventNow = -1;}
+  long iEvent()     const {return iEventNow;}
+
+  // Event information of the current event.
+  double eventValue(EventDouble col) const {
+    return eventDoubles[col][iLocal];}
+  int    eventValue(EventInt col)    const {return eventInts[col][iLocal];}
+  int    code()     const {return eventInts[CODE][iLocal];}
+  double pTHat()    const {return eventDoubles[PTHAT][iLocal];}
+  double QFac()     const {return eventDoubles[QFAC][iLocal];}
+  double QRen()     const {return eventDoubles[QREN][iLocal];}
+  double scalup()   const {return eventDoubles[SCALUP][iLocal];}
+  int    nWeights() const {return wgtOffsets[iLocal + 1]
+    - wgtOffsets[iLocal];}
+  double weight(int i = 0) const {return weights[wgtOffsets[iLocal] + i];}
+
+  // Number of particles and the columns of the current event.
+  int size() const {return partOffsets[iLocal + 1] - partOffsets[iLocal];}
+  const double* column(ParticleDouble col) const {
+    return partDoubles[col] + partOffsets[iLocal];}
+  const int*    column(ParticleInt col)    const {
+    return partInts[col] + partOffsets[iLocal];}
+
+  // Single values of the current event, for the most common columns.
+  int    id(int i)     const {return column(ID)[i];}
+  int    status(int i) const {return column(STATUS)[i];}
+  bool   isFinal(int i) const {return column(STATUS)[i] > 0;}
+  double px(int i)     const {return column(PX)[i];}
+  double py(int i)     const {return column(PY)[i];}
+  double pz(int i)     const {return column(PZ)[i];}
+  double e(int i)      const {return column(E)[i];}
+  double m(int i)      const {return column(M)[i];}
+  double pT(int i)     const {return sqrt(pow2(px(i)) + pow2(py(i)));}
+
+  // Convert the current event to an ordinary event record. Junctions
+  // and event-level scales are not stored, and so not restored. The
+  // event record must have been initialized with a ParticleData pointer.
+  bool fillEvent(Event& event) const;
+
+private:
+
+  // The reader owns a memory map, and so cannot be copied or assigned.
+  EventColumnsReader(const EventColumnsReader&);
+  EventColumnsReader& operator=(const EventColumnsReader&);
+
+  // Make a block the current one, unpacking it if needed.
+  bool loadBlock(int iBlock);
+
+  // Check that offsets start at 0, never decrease and end at nTot.
+  static bool checkOffsets(const int* offsets, int nEvent, int nTot) {
+    if (offsets[0] != 0 || offsets[nEvent] != nTot) return false;
+    for (int i = 0; i < nEvent; ++i)
+      if (offsets[i + 1] < offsets[i]) return false;
+    return true;
+  }
+
+  // The mapped file.
+  char*   mapPtr;
+  size_t  mapSize;
+
+  // Index of blocks: file offset and number of the first event.
+  vector<size_t> blockOffsets;
+  vector<long>   blockFirst;
+  long    nEventSave;
+
+  // Current block and event, and event number within the block.
+  int     iBlockNow;
+  long    iEventNow;
+  int     iLocal;
+
+  // Buffer for an unpacked compressed block.
+  vector<double> unpacked;
+
+  // Pointers to the columns of the current block.
+  const double* eventDoubles[NEVENTDOUBLE];
+  const double* partDoubles[NPARTDOUBLE];
+  const double* weights;
+  const int*    eventInts[NEVENTINT];
+  const int*    partInts[NPARTINT];
+  const int*    partOffsets;
+  const int*    wgtOffsets;
+
+};
+
+//--------------------------------------------------------------------------
+
+// Map the file into memory, check the header and index the blocks.
+
+inline bool EventColumnsReader::open(string fileName) {
+
+  close();
+  int fd = ::open(fileName.c_str(), O_RDONLY);
+  if (fd < 0) {
+    cout << " EventColumnsReader error: could not open " << fileName
+         << endl;
+    return false;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || size_t(st.st_size) < sizeof(FileHeader)) {
+    cout << " EventColumnsReader error: " << fileName
+         << " is not an event columns file." << endl;
+    ::close(fd);
+    return false;
+  }
+  mapSize = st.st_size;
+  void* ptr = mmap(0, mapSize, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (ptr == MAP_FAILED) {
+    cout << " EventColumnsReader error: could not map " << fileName
+         << endl;
+    mapSize = 0;
+    return false;
+  }
+  mapPtr = (char*)ptr;
+
+  // Check that the file was written on a compatible platform.
+  const FileHeader& head = *(const FileHeader*)mapPtr;
+  if (strncmp(head.magic, fileMagic(), 8) != 0 || head.version != VERSION
+    || head.byteOrder != BYTEORDER || head.sizeInt != sizeof(int)
+    || head.sizeDouble != sizeof(double)) {
+    cout << " EventColumnsReader error: " << fileName
+         << " has an unknown format or byte order." << endl;
+    close();
+    return false;
+  }
+
+  // Index the blocks. A truncated last block is ignored. Uncompressed
+  // blocks must be stored with their full size.
+  size_t offset = sizeof(FileHeader);
+  while (offset + sizeof(BlockHeader) <= mapSize) {
+    const BlockHeader& block = *(const BlockHeader*)(mapPtr + offset);
+    if (strncmp(block.magic, blockMagic(), 4) != 0 || block.rawSize
+      != payloadSize(block.nEvent, block.nParticle, block.nWeight)
+      || (block.compressed != COMPRESSED && (block.compressed != 0
+      || block.storedSize != block.rawSize))
+      || block.storedSize > mapSize - offset - sizeof(BlockHeader)) {
+      cout << " EventColumnsReader warning: corrupt block in " << fileName
+           << "; remainder of file skipped." << endl;
+      break;
+    }
+    blockOffsets.push_back(offset);
+    blockFirst.push_back(nEventSave);
+    nEventSave += block.nEvent;
+    offset += sizeof(BlockHeader) + block.storedSize;
+  }
+  return true;
+
+}
+
+//--------------------------------------------------------------------------
+
+// Release the mapped file.
+
+inline void EventColumnsReader::close() {
+  if (mapPtr != 0) munmap(mapPtr, mapSize);
+  mapPtr     = 0;
+  mapSize    = 0;
+  nEventSave = 0;
+  iBlockNow  = -1;
+  iEventNow  = -1;
+  blockOffsets.resize(0);
+  blockFirst.resize(0);
+}
+
+//--------------------------------------------------------------------------
+
+// Make the given event the current one, loading its block if needed.
+
+inline bool EventColumnsReader::goToEvent(long iEvent) {
+  if (iEvent < 0 || iEvent >= nEventSave) return false;
+  int iBlock = iBlockNow;
+  if (iBlock < 0 || iEvent < blockFirst[iBlock] || (iBlock + 1 < nBlock()
+    && iEvent >= blockFirst[iBlock + 1])) {
+    iBlock = upper_bound(blockFirst.begin(), blockFirst.end(), iEvent)
+      - blockFirst.begin() - 1;
+    if (!loadBlock(iBlock)) return false;
+  }
+  iEventNow = iEvent;
+  iLocal    = iEvent - blockFirst[iBlock];
+  return true;
+}
+
+//--------------------------------------------------------------------------
+
+// Set up the column pointers of a block, unpacking it if compressed.
+
+inline bool EventColumnsReader::loadBlock(int iBlock) {
+
+  const BlockHeader& head
+    = *(const BlockHeader*)(mapPtr + blockOffsets[iBlock]);
+  const char* data = mapPtr + blockOffsets[iBlock] + sizeof(BlockHeader);
+  if (head.compressed == COMPRESSED) {
+#ifdef GZIPSUPPORT
+    unpacked.resize(head.rawSize / sizeof(double));
+    uLongf nRaw = head.rawSize;
+    if (uncompress((Bytef*)&unpacked[0], &nRaw, (const Bytef*)data,
+      head.storedSize) != Z_OK || nRaw != head.rawSize) {
+      cout << " EventColumnsReader error: could not unpack block "
+           << iBlock << endl;
+      return false;
+    }
+    data = (const char*)&unpacked[0];
+#else
+    cout << " EventColumnsReader error: compressed blocks require gzip "
+         << "support." << endl;
+    return false;
+#endif
+  }
+
+  // Step through the columns in the order of the file layout.
+  int nEvent = head.nEvent;
+  int nPart  = head.nParticle;
+  const double* dPtr = (const double*)data;
+  for (int i = 0; i < NEVENTDOUBLE; ++i, dPtr += nEvent)
+    eventDoubles[i] = dPtr;
+  weights = dPtr;
+  dPtr += head.nWeight;
+  for (int i = 0; i < NPARTDOUBLE; ++i, dPtr += nPart)
+    partDoubles[i] = dPtr;
+  const int* iPtr = (const int*)dPtr;
+  for (int i = 0; i < NEVENTINT; ++i, iPtr += nEvent) eventInts[i] = iPtr;
+  partOffsets = iPtr;
+  iPtr += nEvent + 1;
+  wgtOffsets = iPtr;
+  iPtr += nEvent + 1;
+  for (int i = 0; i < NPARTINT; ++i, iPtr += nPart) partInts[i] = iPtr;
+
+  // Check that the offsets of particles and weights are in range, so
+  // that a corrupt file cannot give reads outside the block.
+  if (!checkOffsets(partOffsets, nEvent, nPart)
+    || !checkOffsets(wgtOffsets, nEvent, head.nWeight)) {
+    cout << " EventColumnsReader error: corrupt offsets in block "
+         << iBlock << endl;
+    iBlockNow = -1;
+    return false;
+  }
+  iBlockNow = iBlock;
+  return true;
+
+}
+
+//--------------------------------------------------------------------------
+
+// Copy the current event into an event record, replacing its contents.
+
+inline bool EventColumnsReader::fillEvent(Event& event) const {
+  if (iEventNow < 0) return false;
+  event.clear();
+  int nPart = size();
+  const double* d[NPARTDOUBLE];
+  const int*    n[NPARTINT];
+  for (int i = 0; i < NPARTDOUBLE; ++i) d[i] = column(ParticleDouble(i));
+  for (int i = 0; i < NPARTINT; ++i) n[i] = column(ParticleInt(i));
+  for (int i = 0; i < nPart; ++i) {
+    event.append(n[ID][i], n[STATUS][i], n[MOTHER1][i], n[MOTHER2][i],
+      n[DAUGHTER1][i], n[DAUGHTER2][i], n[COL][i], n[ACOL][i], d[PX][i],
+      d[PY][i], d[PZ][i], d[E][i], d[M][i], d[SCALE][i], d[POL][i]);
+    if (d[XPROD][i] != 0. || d[YPROD][i] != 0. || d[ZPROD][i] != 0.
+      || d[TPROD][i] != 0.)
+      event.back().vProd(d[XPROD][i], d[YPROD][i], d[ZPROD][i], d[TPROD][i]);
+    event.back().tau(d[TAU][i]);
+  }
+  return true;
+}
+
+//==========================================================================
+
+} // end namespace Pythia8
+
+#endif // Pythia8_EventColumns_H
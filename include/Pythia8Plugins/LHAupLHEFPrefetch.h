@@ -0,0 +1,185 @@
+// LHAupLHEFPrefetch.h is a part of the PYTHIA event generator.
+// Copyright (C) 2020 Torbjorn Sjostrand.
+// PYTHIA is licenced under the GNU GPL v2 or later, see COPYING for details.
+// Please respect the MCnet Guidelines, see GUIDELINES for details.
+
+// This file contains a version of the Les Houches Event File reader
+// that reads, decompresses and parses events on a separate thread.
+// LHAupLHEFPrefetch: LHAupLHEF with a ring buffer of parsed events.
+// Note: requires C++11 threads, i.e. compile with -std=c++11 -pthread.
+
+#ifndef Pythia8_LHAupLHEFPrefetch_H
+#define Pythia8_LHAupLHEFPrefetch_H
+
+#include "Pythia8/Pythia.h"
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace Pythia8 {
+
+//==========================================================================
+
+// LHAupLHEFPrefetch is used in place of LHAupLHEF, by handing it to
+// Pythia::setLHAupPtr with Beams:frameType = 5. After initialization
+// a background thread reads the events ahead of the generation into a
+// ring buffer of nBuffer parsed events. Each event stays in its buffer
+// slot until the next one is requested, so that the pointers handed
+// to the Info class remain valid. The events are the same as those
+// read by LHAupLHEF, in the same order.
+
+class LHAupLHEFPrefetch : public LHAupLHEF {
+
+public:
+
+  // Constructors, as for LHAupLHEF, with the size of the ring buffer.
+  LHAupLHEFPrefetch(Info* infoPtrIn, const char* filenameIn,
+    int nBufferIn = 16, const char* headerIn = NULL,
+    bool readHeadersIn = false, bool setScalesFromLHEFIn = false)
+    : LHAupLHEF(infoPtrIn, filenameIn, headerIn, readHeadersIn,
+    setScalesFromLHEFIn), slots(max(2, nBufferIn)) {reset();}
+  LHAupLHEFPrefetch(Info* infoPtrIn, istream* isIn, istream* isHeadIn,
+    int nBufferIn = 16, bool readHeadersIn = false,
+    bool setScalesFromLHEFIn = false)
+    : LHAupLHEF(infoPtrIn, isIn, isHeadIn, readHeadersIn,
+    setScalesFromLHEFIn), slots(max(2, nBufferIn)) {reset();}
+
+  // Destructor stops the reading thread.
+  ~LHAupLHEFPrefetch() {stop();}
+
+  // Stop the reading thread before switching to a new file.
+  void newEventFile(const char* filenameIn) {
+    stop();
+    LHAupLHEF::newEventFile(filenameIn);
+  }
+
+  // Stop the reading thread before indexing the events.
+  bool indexEvents(int iShard = 0, int nShard = 1) {
+    stop();
+    return LHAupLHEF::indexEvents(iShard, nShard);
+  }
+
+  // Skip events, first those already in the buffer, and then let the
+  // reading thread skip the rest without parsing them.
+  bool skipEvent(int nSkip) {
+    if (!started) start();
+    std::unique_lock<std::mutex> lock(mtx);
+    nReleased = nTaken;
+    while (nSkip > 0 && nProduced > nTaken) {
+      nReleased = ++nTaken;
+      --nSkip;
+    }
+    if (nSkip == 0) {
+      cvFree.notify_one();
+      return true;
+    }
+    nSkipPending = nSkip;
+    cvFree.notify_one();
+    cvReady.wait(lock, [this]{return nSkipPending == 0 || finished;});
+    return nSkipPending == 0;
+  }
+
+protected:
+
+  // Give the next event from the buffer, and release the previous one.
+  bool readEventLHEF() {
+    if (!started) start();
+    std::unique_lock<std::mutex> lock(mtx);
+    nReleased = nTaken;
+    cvFree.notify_one();
+    cvReady.wait(lock, [this]{return nProduced > nTaken || finished;});
+    if (nProduced == nTaken) return false;
+    Slot& slot = slots[nTaken++ % slots.size()];
+    hepeupPtr          = &slot.hepeup;
+    eventCommentsPtr   = &slot.eventComments;
+    weightsDetailedPtr = &slot.weightsDetailed;
+    return true;
+  }
+
+private:
+
+  // A parsed event, with the comments and weights kept by the reader.
+  struct Slot {
+    HEPEUP         hepeup;
+    string         eventComments;
+    vector<double> weightsDetailed;
+  };
+
+  // Reset the counters of the ring buffer.
+  void reset() {
+    nProduced = nTaken = nReleased = nSkipPending = 0;
+    started = finished = stopping = false;
+  }
+
+  // Start the reading thread.
+  void start() {
+    started = true;
+    worker  = std::thread(&LHAupLHEFPrefetch::produce, this);
+  }
+
+  // Stop the reading thread, and reset the buffer.
+  void stop() {
+    if (!started) return;
+    {
+      std::lock_guard<std::mutex> lock(mtx);
+      stopping = true;
+    }
+    cvFree.notify_one();
+    worker.join();
+    reset();
+  }
+
+  // The reading thread: fill free slots with parsed events, or skip
+  // events without parsing them when requested.
+  void produce() {
+    std::unique_lock<std::mutex> lock(mtx);
+    while (true) {
+      cvFree.wait(lock, [this]{return stopping || nSkipPending > 0
+        || nProduced - nReleased < long(slots.size());});
+      if (stopping) return;
+      bool ok;
+      if (nSkipPending > 0) {
+        long nSkip = nSkipPending;
+        lock.unlock();
+        ok = reader.skipEvents(nSkip);
+        lock.lock();
+        if (ok) nSkipPending -= nSkip;
+      } else {
+        Slot& slot = slots[nProduced % slots.size()];
+        lock.unlock();
+        ok = reader.readEvent(&slot.hepeup);
+        slot.eventComments.swap(reader.eventComments);
+        slot.weightsDetailed.swap(reader.weights_detailed_vec);
+        lock.lock();
+        // An event read while a skip was requested is the first skipped.
+        if (ok && nSkipPending > 0) --nSkipPending;
+        else if (ok) ++nProduced;
+      }
+      if (!ok) finished = true;
+      cvReady.notify_one();
+      if (finished) return;
+    }
+  }
+
+  // The ring buffer of events.
+  vector<Slot> slots;
+
+  // Events produced, taken by and released from the generation,
+  // and events still to skip.
+  long nProduced, nTaken, nReleased, nSkipPending;
+
+  // Status of the reading thread.
+  bool started, finished, stopping;
+
+  // The reading thread and its synchronization.
+  std::thread             worker;
+  std::mutex              mtx;
+  std::condition_variable cvFree, cvReady;
+
+};
+
+//==========================================================================
+
+} // end namespace Pythia8
+
+#endif // Pythia8_LHAupLHEFPrefetch_H
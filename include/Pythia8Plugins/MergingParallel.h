@@ -0,0 +1,215 @@
+// MergingParallel.h is a part of the PYTHIA event generator.
+// Copyright (C) 2020 Torbjorn Sjostrand.
+// PYTHIA is licenced under the GNU GPL v2 or later, see COPYING for details.
+// Please respect the MCnet Guidelines, see GUIDELINES for details.
+
+// This file contains a version of the merging wrapper class that runs
+// the trial showers of the merging weight calculation on a number of
+// threads.
+// MergingParallel: Merging with parallel trial showers.
+// Note: requires C++11 threads, i.e. compile with -std=c++11 -pthread.
+
+#ifndef Pythia8_MergingParallel_H
+#define Pythia8_MergingParallel_H
+
+#include "Pythia8/Pythia.h"
+#include <atomic>
+#include <thread>
+#include <typeinfo>
+
+namespace Pythia8 {
+
+//==========================================================================
+
+// MergingParallel is used in place of the default Merging object, by
+// handing it to Pythia::setMergingPtr before Pythia::init. Each extra
+// thread has a worker Pythia object, a copy of the main one, whose trial
+// PartonLevel object is used for the trial showers. Before each batch
+// the information on the current event is copied to the workers. Every
+// trial shower has its own random number seed, see
+// Merging:seedTrialShowers, so the events do not depend on the number
+// of threads. Each trial shower uses the merging hooks of the worker
+// that runs it. User hooks and user-defined merging hooks, i.e. objects
+// of classes derived from MergingHooks, are not copied to the workers;
+// trial showers with such hooks, weak clusterings or vetoes of trial
+// emissions are therefore run on the main thread only. So is everything
+// with an external random number engine, which cannot be reseeded.
+
+class MergingParallel : public Merging {
+
+public:
+
+  // Constructor. By default one thread per hardware core is used.
+  MergingParallel(int nThreadsIn = 0) : nThreads(nThreadsIn) {
+    if (nThreads <= 0)
+      nThreads = max(1, int(std::thread::hardware_concurrency()));
+  }
+
+  // Destructor deletes the workers.
+  ~MergingParallel() {
+    for (int i = 0; i < int(workerPtrs.size()); ++i) {
+      delete workerPtrs[i];
+      delete workerMergingPtrs[i];
+    }
+  }
+
+  // Initialize, and add the workers on the first call. The trial
+  // showers need seeds of their own for the events not to depend on
+  // the number of threads, which an external random number engine
+  // cannot provide.
+  virtual void init() {
+    if (rndmPtr->useExternalEngine()) {
+      infoPtr->errorMsg("Warning in MergingParallel::init: "
+        "external random number engine; running trial showers "
+        "sequentially");
+      nThreads = 1;
+      Merging::init();
+      return;
+    }
+    Merging::init();
+    if (!settingsPtr->flag("Merging:seedTrialShowers")) {
+      infoPtr->errorMsg("Warning in MergingParallel::init: "
+        "switching on Merging:seedTrialShowers");
+      settingsPtr->flag("Merging:seedTrialShowers", true);
+    }
+    if (workerPtrs.empty() && nThreads > 1) addWorkers(nThreads - 1);
+  }
+
+  // The number of threads used.
+  int threads() const {return nThreads;}
+
+protected:
+
+  // Let the workers pick trial showers from the batch until all are
+  // done. The calling thread takes the part of the first worker.
+  virtual void runTrialShowers(vector<TrialShowerTask>& tasks) {
+    int nTask = tasks.size();
+    int nRun  = min(int(workerPtrs.size()) + 1, nTask);
+    if (nRun <= 1 || trialPartonLevelPtr->userHooksPtr != 0
+      || typeid(*mergingHooksPtr) != typeid(MergingHooks)
+      || mergingHooksPtr->doWeakClustering()
+      || mergingHooksPtr->canVetoTrialEmission()) {
+      Merging::runTrialShowers(tasks);
+      return;
+    }
+    for (int iWorker = 1; iWorker < nRun; ++iWorker)
+      copyEventInfo(*workerMergingPtrs[iWorker - 1]);
+    std::atomic<int> iNext(0);
+    auto work = [&](int iWorker) {
+      MergingParallel& worker = (iWorker == 0) ? *this
+        : *workerMergingPtrs[iWorker - 1];
+      for (int i = iNext++; i < nTask; i = iNext++)
+        tasks[i].run(worker.trialPartonLevelPtr, worker.rndmPtr);
+    };
+    vector<std::thread> threadPool;
+    for (int iWorker = 1; iWorker < nRun; ++iWorker)
+      threadPool.push_back(std::thread(work, iWorker));
+    work(0);
+    for (int i = 0; i < int(threadPool.size()); ++i) threadPool[i].join();
+  }
+
+private:
+
+  // Add workers as copies of the main Pythia object, each with a
+  // MergingParallel object of its own that gives access to its trial
+  // PartonLevel object. Their initialization output is suppressed.
+  bool addWorkers(int nAdd) {
+    if (settingsPtr->mode("Beams:frameType") == 5) {
+      infoPtr->errorMsg("Warning in MergingParallel::addWorkers: "
+        "workers cannot use an external LHAup object; running sequentially");
+      return false;
+    }
+    for (int i = 0; i < nAdd; ++i) {
+      Pythia* pythiaPtr = new Pythia(*settingsPtr, *particleDataPtr, false);
+      MergingParallel* mergingPtr = new MergingParallel(1);
+      pythiaPtr->setMergingPtr(mergingPtr);
+      std::ostringstream oss;
+      std::streambuf* coutSave = cout.rdbuf(oss.rdbuf());
+      bool isInit = pythiaPtr->init();
+      cout.rdbuf(coutSave);
+      if (!isInit) {
+        infoPtr->errorMsg("Error in MergingParallel::addWorkers: "
+          "could not initialize worker");
+        delete pythiaPtr;
+        delete mergingPtr;
+        return false;
+      }
+      workerPtrs.push_back(pythiaPtr);
+      workerMergingPtrs.push_back(mergingPtr);
+    }
+    return true;
+  }
+
+  // Copy the information on the current event, and the merging state
+  // used by the trial showers, to a worker. The event attributes of the
+  // main Info object are only referred to.
+  void copyEventInfo(MergingParallel& worker) {
+    *worker.infoPtr = *infoPtr;
+    worker.infoPtr->hasOwnEventAttributes = false;
+    MergingHooks& hooks = *worker.mergingHooksPtr;
+    const MergingHooks& main = *mergingHooksPtr;
+    hooks.processNow            = main.processNow;
+    hooks.doUserMergingSave     = main.doUserMergingSave;
+    hooks.doMGMergingSave       = main.doMGMergingSave;
+    hooks.doKTMergingSave       = main.doKTMergingSave;
+    hooks.doPTLundMergingSave   = main.doPTLundMergingSave;
+    hooks.doCutBasedMergingSave = main.doCutBasedMergingSave;
+    hooks.doNL3TreeSave         = main.doNL3TreeSave;
+    hooks.doNL3LoopSave         = main.doNL3LoopSave;
+    hooks.doNL3SubtSave         = main.doNL3SubtSave;
+    hooks.doUNLOPSTreeSave      = main.doUNLOPSTreeSave;
+    hooks.doUNLOPSLoopSave      = main.doUNLOPSLoopSave;
+    hooks.doUNLOPSSubtSave      = main.doUNLOPSSubtSave;
+    hooks.doUNLOPSSubtNLOSave   = main.doUNLOPSSubtNLOSave;
+    hooks.doUMEPSTreeSave       = main.doUMEPSTreeSave;
+    hooks.doUMEPSSubtSave       = main.doUMEPSSubtSave;
+    hooks.nReclusterSave        = main.nReclusterSave;
+    hooks.nRequestedSave        = main.nRequestedSave;
+    hooks.hasJetMaxLocal        = main.hasJetMaxLocal;
+    hooks.nJetMaxLocal          = main.nJetMaxLocal;
+    hooks.nJetMaxNLOLocal       = main.nJetMaxNLOLocal;
+    hooks.nInProcessNow         = main.nInProcessNow;
+    hooks.tmsValueNow           = main.tmsValueNow;
+    hooks.muMISave              = main.muMISave;
+    hooks.nMinMPISave           = main.nMinMPISave;
+    hooks.muFSave               = main.muFSave;
+    hooks.muRSave               = main.muRSave;
+    hooks.muFinMESave           = main.muFinMESave;
+    hooks.muRinMESave           = main.muRinMESave;
+    hooks.doIgnoreEmissionsSave = main.doIgnoreEmissionsSave;
+    hooks.doIgnoreStepSave      = main.doIgnoreStepSave;
+    hooks.nHardNowSave          = main.nHardNowSave;
+    hooks.tmsHardNowSave        = main.tmsHardNowSave;
+    hooks.nJetNowSave           = main.nJetNowSave;
+    hooks.tmsNowSave            = main.tmsNowSave;
+    copyHardProcess(*main.hardProcess, *hooks.hardProcess);
+  }
+
+  // Copy the hard process candidates of the current event.
+  void copyHardProcess(const HardProcess& from, HardProcess& to) {
+    to.hardIncoming1    = from.hardIncoming1;
+    to.hardIncoming2    = from.hardIncoming2;
+    to.hardOutgoing1    = from.hardOutgoing1;
+    to.hardOutgoing2    = from.hardOutgoing2;
+    to.hardIntermediate = from.hardIntermediate;
+    to.state            = from.state;
+    to.PosOutgoing1     = from.PosOutgoing1;
+    to.PosOutgoing2     = from.PosOutgoing2;
+    to.PosIntermediate  = from.PosIntermediate;
+    to.tms              = from.tms;
+  }
+
+  // The number of threads.
+  int nThreads;
+
+  // The worker Pythia objects and their merging objects.
+  vector<Pythia*>          workerPtrs;
+  vector<MergingParallel*> workerMergingPtrs;
+
+};
+
+//==========================================================================
+
+} // end namespace Pythia8
+
+#endif // Pythia8_MergingParallel_H
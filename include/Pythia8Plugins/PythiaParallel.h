@@ -0,0 +1,578 @@
+// PythiaParallel.h is a part of the PYTHIA event generator.
+// Copyright (C) 2020 Torbjorn Sjostrand.
+// PYTHIA is licenced under the GNU GPL v2 or later, see COPYING for details.
+// Please respect the MCnet Guidelines, see GUIDELINES for details.
+
+// This file contains a driver for thread-parallel event generation.
+// ParallelEvent: a finished event, as handed over by the event queue.
+// PythiaParallel: runs a number of Pythia clones on a pool of threads.
+// Note: requires C++11 threads, i.e. compile with -std=c++11 -pthread.
+
+#ifndef Pythia8_PythiaParallel_H
+#define Pythia8_PythiaParallel_H
+
+#include "Pythia8/Pythia.h"
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace Pythia8 {
+
+// The C++11 facilities used below.
+using std::atomic;
+using std::condition_variable;
+using std::function;
+using std::lock_guard;
+using std::mutex;
+using std::thread;
+using std::to_string;
+using std::unique_lock;
+
+//==========================================================================
+
+// A finished event, with the most relevant generation information,
+// as handed out from the bounded queue of a PythiaParallel run.
+
+class ParallelEvent {
+
+public:
+
+  // Constructor.
+  ParallelEvent() : iWorker(-1), code(0), weight(1.), pTHat(0.),
+    Q2Fac(0.), Q2Ren(0.), scalup(0.) {}
+
+  // Which worker generated the event.
+  int    iWorker;
+
+  // Process code, event weight and scales of the hard process.
+  int    code;
+  double weight, pTHat, Q2Fac, Q2Ren, scalup;
+
+  // The hard-process and complete event records.
+  Event  process, event;
+
+};
+
+//==========================================================================
+
+// The PythiaParallel class reads in settings and particle data once,
+// then hands out copies of them to a number of Pythia worker instances,
+// each with its own random number seed, that are initialized and run
+// concurrently. Finished events are handed to a user callback, one at
+// a time, or are stored in a bounded queue for the user to pick up.
+
+class PythiaParallel {
+
+public:
+
+  // Constructor. The helper instance parses the XML database only once.
+  PythiaParallel(string xmlDir = "../share/Pythia8/xmldoc",
+    bool printBanner = true) : pythiaHelper(xmlDir, printBanner),
+    settings(pythiaHelper.settings), particleData(pythiaHelper.particleData),
+    isInit(false), nEventsRun(0), doCancel(false), queueSize(0),
+    nRunning(0) {}
+
+  // Destructor. A background run still going on is cancelled.
+  ~PythiaParallel() { cancelRun();
+    for (int i = 0; i < int(pythiaPtrs.size()); ++i) delete pythiaPtrs[i];}
+
+  // Read in settings or particle data changes, common for all workers.
+  bool readString(string line, bool warn = true) {
+    return pythiaHelper.readString(line, warn);}
+  bool readFile(string fileName, bool warn = true) {
+    return pythiaHelper.readFile(fileName, warn);}
+
+  // Create and initialize the workers. The optional function is applied
+  // to each worker before its init(), e.g. to hand in user hooks.
+  bool init(function<bool(Pythia&)> customInit = nullptr);
+
+  // Generate nEvents events and hand each of them to the callback.
+  // The callback is called for one event at a time, so need not be
+  // thread safe itself. Returns the number of events generated.
+  long run(long nEvents, function<void(Pythia&)> callback);
+
+  // Alternatively start generation of nEvents in the background and pick
+  // the events up in the calling thread. At most queueSizeIn finished
+  // events are kept waiting. nextEvent returns false when done.
+  bool startRun(long nEvents, int queueSizeIn = 100);
+  bool nextEvent(ParallelEvent& eventOut);
+
+  // Stop a background run, once each worker has finished its current
+  // event, and discard the events not yet picked up. Also done when a
+  // new run is started and in the destructor.
+  void cancelRun();
+
+  // Statistics merged over all workers, in the same units as Info.
+  // The cross section of each process is estimated as in a single run
+  // with the tried, selected and accepted events of all workers.
+  long   nTried();
+  long   nSelected();
+  long   nAccepted();
+  double sigmaGen();
+  double sigmaErr();
+  double weightSum();
+
+  // Print merged cross-section statistics and worker summaries.
+  void stat();
+
+  // Access to the individual workers, e.g. for worker-specific statistics.
+  int     nWorkers() {return pythiaPtrs.size();}
+  Pythia* worker(int iWorker) {return pythiaPtrs[iWorker];}
+
+  // The helper instance holds the common settings and particle data.
+  Pythia        pythiaHelper;
+  Settings&     settings;
+  ParticleData& particleData;
+
+private:
+
+  // Constants: could only be changed in the code itself.
+  static const int MAXSEED, DEFAULTSEED;
+
+  // Initialization flag and number of events handed out.
+  bool isInit;
+  long nEventsRun;
+
+  // The workers.
+  vector<Pythia*> pythiaPtrs;
+
+  // Common counters, cancel flag and locks for the event loop.
+  atomic<long> nStarted, nDone;
+  atomic<bool> doCancel;
+  mutex        callbackMutex;
+
+  // The bounded queue and its background threads.
+  int                    queueSize, nRunning;
+  deque<ParallelEvent*>  eventQueue;
+  vector<thread>         queueThreads;
+  mutex                  queueMutex;
+  condition_variable     queueNotFull, queueNotEmpty;
+
+  // The event loop of a single worker.
+  void workerLoop(int iWorker, long nEvents,
+    function<void(Pythia&)> callback);
+
+  // Hand an event to the queue, waiting if it is full.
+  void pushEvent(Pythia& pythiaNow, int iWorker);
+
+  // Merge the process-by-process statistics of the workers.
+  void mergeProcesses(map<int, string>& nameM, map<int, long>& nTryM,
+    map<int, long>& nSelM, map<int, long>& nAccM, map<int, double>& sigmaM,
+    map<int, double>& deltaM);
+
+};
+
+//--------------------------------------------------------------------------
+
+// Constants: could be changed here if desired, but normally should not.
+// These are of technical nature, as described for each.
+
+// Largest seed accepted by the Rndm class.
+const int PythiaParallel::MAXSEED     = 900000000;
+
+// Default seed, as used by the Rndm class when Random:setSeed is off.
+const int PythiaParallel::DEFAULTSEED = 19780503;
+
+//--------------------------------------------------------------------------
+
+// Create and initialize the workers, each in a thread of its own.
+
+inline bool PythiaParallel::init(function<bool(Pythia&)> customInit) {
+
+  // Number of workers; zero means one for each hardware thread.
+  int nThreads = settings.mode("Parallelism:numThreads");
+  if (nThreads == 0) nThreads = max( 1u, thread::hardware_concurrency() );
+  bool printWorkerInit = settings.flag("Parallelism:printWorkerInit");
+
+  // Base seed. A time-dependent seed is fixed once here, so that all
+  // workers get different but consecutive seeds.
+  int seedBase = DEFAULTSEED;
+  if (settings.flag("Random:setSeed")) {
+    seedBase = settings.mode("Random:seed");
+    if (seedBase < 0) seedBase = int(time(0) % MAXSEED);
+    else if (seedBase == 0) seedBase = DEFAULTSEED;
+  }
+
+  // With the xoshiro128++ engine all workers share the seed, and
+  // instead use consecutive non-overlapping substreams.
+  bool useStreams = (settings.mode("Random:engine") == 1);
+  int streamBase  = settings.mode("Random:stream");
+
+  // Create workers from the common settings and particle data,
+  // without parsing the XML files again.
+  for (int i = 0; i < int(pythiaPtrs.size()); ++i) delete pythiaPtrs[i];
+  pythiaPtrs.resize(0);
+  for (int i = 0; i < nThreads; ++i) {
+    Pythia* pythiaPtr = new Pythia( settings, particleData, false);
+    pythiaPtr->readString("Random:setSeed = on");
+    if (useStreams) {
+      pythiaPtr->readString("Random:seed = " + to_string(seedBase));
+      pythiaPtr->readString("Random:stream = "
+        + to_string(streamBase + i));
+    } else pythiaPtr->readString("Random:seed = "
+      + to_string( 1 + (seedBase - 1 + i) % MAXSEED ));
+    if (i > 0 && !printWorkerInit) {
+      pythiaPtr->readString("Init:showProcesses = off");
+      pythiaPtr->readString("Init:showMultipartonInteractions = off");
+      pythiaPtr->readString("Init:showChangedSettings = off");
+      pythiaPtr->readString("Init:showChangedParticleData = off");
+    }
+    if (i > 0) pythiaPtr->readString("Next:numberCount = 0");
+    if (customInit && !customInit(*pythiaPtr)) {
+      delete pythiaPtr;
+      pythiaHelper.info.errorMsg("Abort from PythiaParallel::init: "
+        "user initialization of worker failed");
+      return false;
+    }
+    pythiaPtrs.push_back(pythiaPtr);
+  }
+
+  // Initialize all workers concurrently.
+  vector<int> initOK(nThreads, 0);
+  vector<thread> initThreads;
+  for (int i = 0; i < nThreads; ++i)
+    initThreads.push_back( thread( [this, i, &initOK]() {
+      initOK[i] = pythiaPtrs[i]->init() ? 1 : 0; } ) );
+  for (int i = 0; i < nThreads; ++i) initThreads[i].join();
+
+  // Done.
+  for (int i = 0; i < nThreads; ++i) if (!initOK[i]) {
+    pythiaHelper.info.errorMsg("Abort from PythiaParallel::init: "
+      "initialization of worker failed");
+    return false;
+  }
+  isInit = true;
+  return true;
+
+}
+
+//--------------------------------------------------------------------------
+
+// The event loop of a single worker. Events are numbered globally, so
+// that the total number of events is fixed irrespective of thread timing.
+
+inline void PythiaParallel::workerLoop(int iWorker, long nEvents,
+  function<void(Pythia&)> callback) {
+
+  Pythia& pythiaNow = *pythiaPtrs[iWorker];
+  int nAbort = pythiaNow.mode("Main:timesAllowErrors");
+  int iAbort = 0;
+  while (!doCancel && nStarted++ < nEvents) {
+
+    // Generate event. Give back the event number if failed.
+    if (!pythiaNow.next()) {
+      --nStarted;
+      if (pythiaNow.info.atEndOfFile()) break;
+      if (++iAbort < nAbort) continue;
+      pythiaNow.info.errorMsg("Abort from PythiaParallel::run: "
+        "too many errors in event generation");
+      break;
+    }
+
+    // Hand over event, either to callback or to queue.
+    if (callback) {
+      lock_guard<mutex> lock(callbackMutex);
+      callback(pythiaNow);
+    } else pushEvent(pythiaNow, iWorker);
+    ++nDone;
+  }
+
+}
+
+//--------------------------------------------------------------------------
+
+// Generate nEvents events, handing each of them to the callback.
+
+inline long PythiaParallel::run(long nEvents,
+  function<void(Pythia&)> callback) {
+
+  if (!isInit) {
+    pythiaHelper.info.errorMsg("Error in PythiaParallel::run: "
+      "not properly initialized");
+    return 0;
+  }
+  cancelRun();
+
+  // Run all workers until the requested number of events is reached.
+  nStarted = 0;
+  nDone    = 0;
+  vector<thread> runThreads;
+  for (int i = 0; i < nWorkers(); ++i)
+    runThreads.push_back( thread( &PythiaParallel::workerLoop, this, i,
+      nEvents, callback) );
+  for (int i = 0; i < nWorkers(); ++i) runThreads[i].join();
+  nEventsRun += nDone;
+  return nDone;
+
+}
+
+//--------------------------------------------------------------------------
+
+// Start generation of nEvents in the background, filling the queue.
+
+inline bool PythiaParallel::startRun(long nEvents, int queueSizeIn) {
+
+  if (!isInit) {
+    pythiaHelper.info.errorMsg("Error in PythiaParallel::startRun: "
+      "not properly initialized");
+    return false;
+  }
+  cancelRun();
+
+  // Start the workers, each decreasing the running count when done.
+  nStarted  = 0;
+  nDone     = 0;
+  queueSize = max( 1, queueSizeIn);
+  nRunning  = nWorkers();
+  for (int i = 0; i < nWorkers(); ++i)
+    queueThreads.push_back( thread( [this, i, nEvents]() {
+      workerLoop( i, nEvents, nullptr);
+      lock_guard<mutex> lock(queueMutex);
+      --nRunning;
+      queueNotEmpty.notify_all(); } ) );
+  return true;
+
+}
+
+//--------------------------------------------------------------------------
+
+// Copy the relevant information of the current event into the queue.
+
+inline void PythiaParallel::pushEvent(Pythia& pythiaNow, int iWorker) {
+
+  ParallelEvent* eventPtr = new ParallelEvent();
+  eventPtr->iWorker = iWorker;
+  eventPtr->code    = pythiaNow.info.code();
+  eventPtr->weight  = pythiaNow.info.weight();
+  eventPtr->pTHat   = pythiaNow.info.pTHat();
+  eventPtr->Q2Fac   = pythiaNow.info.Q2Fac();
+  eventPtr->Q2Ren   = pythiaNow.info.Q2Ren();
+  eventPtr->scalup  = pythiaNow.info.scalup();
+  eventPtr->process = pythiaNow.process;
+  eventPtr->event   = pythiaNow.event;
+
+  // Wait for space in the queue, unless the run is cancelled.
+  unique_lock<mutex> lock(queueMutex);
+  queueNotFull.wait( lock, [this]() {
+    return doCancel || int(eventQueue.size()) < queueSize; } );
+  if (doCancel) {
+    delete eventPtr;
+    return;
+  }
+  eventQueue.push_back(eventPtr);
+  queueNotEmpty.notify_one();
+
+}
+
+//--------------------------------------------------------------------------
+
+// Pick up the next finished event; false when the run is over.
+
+inline bool PythiaParallel::nextEvent(ParallelEvent& eventOut) {
+
+  ParallelEvent* eventPtr = 0;
+  {
+    unique_lock<mutex> lock(queueMutex);
+    queueNotEmpty.wait( lock, [this]() {
+      return !eventQueue.empty() || nRunning == 0; } );
+    if (eventQueue.empty()) return false;
+    eventPtr = eventQueue.front();
+    eventQueue.pop_front();
+    queueNotFull.notify_one();
+  }
+  eventOut = *eventPtr;
+  delete eventPtr;
+  ++nEventsRun;
+  return true;
+
+}
+
+//--------------------------------------------------------------------------
+
+// Stop any background run, and empty the queue.
+
+inline void PythiaParallel::cancelRun() {
+
+  if (queueThreads.empty()) return;
+  {
+    lock_guard<mutex> lock(queueMutex);
+    doCancel = true;
+    queueNotFull.notify_all();
+  }
+  for (int i = 0; i < int(queueThreads.size()); ++i) queueThreads[i].join();
+  queueThreads.resize(0);
+  for (int i = 0; i < int(eventQueue.size()); ++i) delete eventQueue[i];
+  eventQueue.clear();
+  doCancel = false;
+
+}
+
+//--------------------------------------------------------------------------
+
+// Summed event counters over all workers.
+
+inline long PythiaParallel::nTried() { long nSum = 0;
+  for (int i = 0; i < nWorkers(); ++i) nSum += pythiaPtrs[i]->info.nTried();
+  return nSum;}
+
+inline long PythiaParallel::nSelected() { long nSum = 0;
+  for (int i = 0; i < nWorkers(); ++i)
+    nSum += pythiaPtrs[i]->info.nSelected();
+  return nSum;}
+
+inline long PythiaParallel::nAccepted() { long nSum = 0;
+  for (int i = 0; i < nWorkers(); ++i)
+    nSum += pythiaPtrs[i]->info.nAccepted();
+  return nSum;}
+
+inline double PythiaParallel::weightSum() { double wtSum = 0.;
+  for (int i = 0; i < nWorkers(); ++i)
+    wtSum += pythiaPtrs[i]->info.weightSum();
+  return wtSum;}
+
+//--------------------------------------------------------------------------
+
+// Merge the process-by-process statistics. Info gives the cross section
+// of a process as the sum of accepted weights per tried event, times the
+// fraction of selected events that are accepted. The weight sums are
+// added up over workers, and the fraction is taken from the summed
+// counters. The errors are combined with the numbers of tried events
+// as weights.
+
+inline void PythiaParallel::mergeProcesses(map<int, string>& nameM,
+  map<int, long>& nTryM, map<int, long>& nSelM, map<int, long>& nAccM,
+  map<int, double>& sigmaM, map<int, double>& deltaM) {
+
+  // Sum up the counters, weight sums and weighted errors of all workers.
+  map<int, double> delta2M;
+  for (int i = 0; i < nWorkers(); ++i) {
+    Info& infoNow = pythiaPtrs[i]->info;
+    vector<int> codes = infoNow.codesHard();
+    for (int j = 0; j < int(codes.size()); ++j) {
+      int code       = codes[j];
+      long nTryNow   = infoNow.nTried(code);
+      long nSelNow   = infoNow.nSelected(code);
+      long nAccNow   = infoNow.nAccepted(code);
+      nameM[code]    = infoNow.nameProc(code);
+      nTryM[code]   += nTryNow;
+      nSelM[code]   += nSelNow;
+      nAccM[code]   += nAccNow;
+      if (nAccNow > 0) sigmaM[code]
+        += infoNow.sigmaGen(code) * nTryNow * nSelNow / double(nAccNow);
+      delta2M[code] += pow2( infoNow.sigmaErr(code) * nTryNow);
+    }
+  }
+
+  // Normalize to the total number of tried events.
+  for (map<int, string>::iterator it = nameM.begin(); it != nameM.end();
+    ++it) {
+    int code     = it->first;
+    long nTryNow = nTryM[code];
+    sigmaM[code] = (nAccM[code] > 0) ? sigmaM[code] * nAccM[code]
+                 / (double(nTryNow) * nSelM[code]) : 0.;
+    deltaM[code] = (nTryNow > 0) ? sqrt(delta2M[code]) / nTryNow : 0.;
+  }
+
+}
+
+//--------------------------------------------------------------------------
+
+// The merged cross section and its error are summed over processes.
+
+inline double PythiaParallel::sigmaGen() {
+  map<int, string> nameM;
+  map<int, long>   nTryM, nSelM, nAccM;
+  map<int, double> sigmaM, deltaM;
+  mergeProcesses( nameM, nTryM, nSelM, nAccM, sigmaM, deltaM);
+  double sigmaSum = 0.;
+  for (map<int, double>::iterator it = sigmaM.begin(); it != sigmaM.end();
+    ++it) sigmaSum += it->second;
+  return sigmaSum;
+}
+
+inline double PythiaParallel::sigmaErr() {
+  map<int, string> nameM;
+  map<int, long>   nTryM, nSelM, nAccM;
+  map<int, double> sigmaM, deltaM;
+  mergeProcesses( nameM, nTryM, nSelM, nAccM, sigmaM, deltaM);
+  double delta2Sum = 0.;
+  for (map<int, double>::iterator it = deltaM.begin(); it != deltaM.end();
+    ++it) delta2Sum += pow2(it->second);
+  return sqrt(delta2Sum);
+}
+
+//--------------------------------------------------------------------------
+
+// Print merged cross-section statistics, process by process.
+
+inline void PythiaParallel::stat() {
+
+  // Merge process-by-process information from all workers.
+  map<int, string> nameM;
+  map<int, long>   nTryM, nSelM, nAccM;
+  map<int, double> sigmaM, deltaM;
+  mergeProcesses( nameM, nTryM, nSelM, nAccM, sigmaM, deltaM);
+
+  // Header.
+  cout << "\n *-------  PYTHIA Parallel Event and Cross Section Statistics  "
+       << "----------------------------------------------------*\n"
+       << " |                                                            "
+       << "                                                     |\n"
+       << " | Subprocess                                    Code |       "
+       << "     Number of events       |      sigma +- delta    |\n"
+       << " |                                                    |       "
+       << "Tried   Selected   Accepted |     (estimated) (mb)   |\n"
+       << " |                                                    |       "
+       << "                            |                        |\n"
+       << " |------------------------------------------------------------"
+       << "-----------------------------------------------------|\n"
+       << " |                                                    |       "
+       << "                            |                        |\n";
+
+  // Print merged process info.
+  for (map<int, string>::iterator it = nameM.begin(); it != nameM.end();
+    ++it) {
+    int code      = it->first;
+    long nAccNow  = nAccM[code];
+    double sigma  = sigmaM[code];
+    double delta  = deltaM[code];
+    cout << " | " << left << setw(45) << it->second
+         << right << setw(5) << code << " | "
+         << setw(11) << nTryM[code] << " " << setw(10) << nSelM[code] << " "
+         << setw(10) << nAccNow << " | " << scientific << setprecision(3)
+         << setw(11) << sigma << setw(11) << delta << " |\n";
+  }
+
+  // Print summed process info and number of workers.
+  cout << " |                                                    |       "
+       << "                            |                        |\n"
+       << " | " << left << setw(50) << "sum" << right << " | " << setw(11)
+       << nTried() << " " << setw(10) << nSelected() << " " << setw(10)
+       << nAccepted() << " | " << scientific << setprecision(3) << setw(11)
+       << sigmaGen() << setw(11) << sigmaErr() << " |\n"
+       << " |                                                            "
+       << "                                                     |\n"
+       << " | Generated with " << setw(4) << nWorkers() << " workers"
+       << "                                                            "
+       << "                         |\n"
+       << " |                                                            "
+       << "                                                     |\n"
+       << " *-------  End PYTHIA Parallel Event and Cross Section Statistics "
+       << "-------------------------------------------------*" << endl;
+
+  // Error statistics remain worker by worker.
+  if (settings.flag("Stat:showErrors"))
+    for (int i = 0; i < nWorkers(); ++i) {
+      cout << "\n Errors and warnings of worker " << i << ":";
+      pythiaPtrs[i]->info.errorStatistics();
+    }
+
+}
+
+//==========================================================================
+
+} // end namespace Pythia8
+
+#endif // Pythia8_PythiaParallel_H
@@ -18,7 +18,7 @@ namespace Pythia8 {
 
 // Rndm class.
 // This class handles random number generation according to the
-// Marsaglia-Zaman-Tsang algorithm
+// Marsaglia-Zaman-Tsang algorithm, or optionally the xoshiro128++ one.
 
 //--------------------------------------------------------------------------
 
@@ -28,6 +28,15 @@ namespace Pythia8 {
 // The default seed, i.e. the Marsaglia-Zaman random number sequence.
 const int Rndm::DEFAULTSEED     = 19780503;
 
+// Jump polynomials of xoshiro128++, equivalent to 2^64 and 2^96 steps.
+const unsigned int Rndm::JUMP[4]     = { 0x8764000bu, 0xf542d2d3u,
+  0x6fa035c3u, 0x77f2db5bu };
+const unsigned int Rndm::LONGJUMP[4] = { 0xb523952eu, 0x0b6f099fu,
+  0xccf5a0efu, 0x1c580662u };
+
+// Conversion of 53 random bits to a double in [0, 1), i.e. 2^-53.
+const double Rndm::TWOM53       = 1.1102230246251565e-16;
+
 //--------------------------------------------------------------------------
 
 // Method to pass in pointer for external random number generation.
@@ -56,6 +65,22 @@ void Rndm::init(int seedIn) {
   else if (seedIn == 0) seed = int(time(0));
   if (seed < 0) seed = -seed;
 
+  // The xoshiro128++ engine: state words from a hash of the seed.
+  if (engineSave == 1) {
+    unsigned int h = (unsigned int)(seed);
+    for (int iw = 0; iw < 4; ++iw) {
+      h += 0x9e3779b9u;
+      unsigned int z = h;
+      z = (z ^ (z >> 16)) * 0x85ebca6bu;
+      z = (z ^ (z >> 13)) * 0xc2b2ae35u;
+      xs[iw] = z ^ (z >> 16);
+    }
+    initRndm  = true;
+    seedSave  = seed;
+    sequence  = 0;
+    return;
+  }
+
   // Unpack seed.
   int ij = (seed/30082) % 31329;
   int kl = seed % 30082;
@@ -111,6 +136,18 @@ double Rndm::flat() {
   // Find next random number and update saved state.
   ++sequence;
   double uni;
+
+  // The xoshiro128++ engine: 53 bits from two 32-bit numbers.
+  if (engineSave == 1) {
+    do {
+      unsigned int hi = nextXoshiro(xs) >> 5;
+      unsigned int lo = nextXoshiro(xs) >> 6;
+      uni = (hi * 67108864. + lo) * TWOM53;
+    } while (uni <= 0.);
+    return uni;
+  }
+
+  // The Marsaglia-Zaman-Tsang engine.
   do {
     uni = u[i97] - u[j97];
     if (uni < 0.) uni += 1.;
@@ -128,6 +165,81 @@ double Rndm::flat() {
 
 //--------------------------------------------------------------------------
 
+// Fill an array with random numbers uniformly between 0 and 1.
+// For xoshiro128++ the state is kept in local variables over the loop.
+
+void Rndm::flat(double* rIn, int nIn) {
+
+  // External or Marsaglia-Zaman-Tsang generator: one number at a time.
+  if (useExternalRndm || engineSave != 1) {
+    for (int i = 0; i < nIn; ++i) rIn[i] = flat();
+    return;
+  }
+
+  // The xoshiro128++ engine, as in flat() above.
+  if (!initRndm) init(DEFAULTSEED);
+  sequence += nIn;
+  unsigned int s[4] = { xs[0], xs[1], xs[2], xs[3] };
+  for (int i = 0; i < nIn; ++i) {
+    double uni;
+    do {
+      unsigned int hi = nextXoshiro(s) >> 5;
+      unsigned int lo = nextXoshiro(s) >> 6;
+      uni = (hi * 67108864. + lo) * TWOM53;
+    } while (uni <= 0.);
+    rIn[i] = uni;
+  }
+  for (int iw = 0; iw < 4; ++iw) xs[iw] = s[iw];
+
+}
+
+//--------------------------------------------------------------------------
+
+// Next 32-bit number from the xoshiro128++ generator of
+// D. Blackman and S. Vigna, with state s updated.
+
+inline unsigned int Rndm::nextXoshiro(unsigned int* s) {
+
+  unsigned int sum    = s[0] + s[3];
+  unsigned int result = ((sum << 7) | (sum >> 25)) + s[0];
+  unsigned int t      = s[1] << 9;
+  s[2] ^= s[0];
+  s[3] ^= s[1];
+  s[1] ^= s[2];
+  s[0] ^= s[3];
+  s[2] ^= t;
+  s[3]  = (s[3] << 11) | (s[3] >> 21);
+  return result;
+
+}
+
+//--------------------------------------------------------------------------
+
+// Jump ahead in the xoshiro128++ sequence, by combining the states
+// along the way according to the jump polynomial.
+
+bool Rndm::jumpXoshiro(int nJump, const unsigned int* poly) {
+
+  // Only possible for the internal xoshiro128++ engine.
+  if (useExternalRndm || engineSave != 1) return false;
+  if (!initRndm) init(DEFAULTSEED);
+
+  for (int iJump = 0; iJump < nJump; ++iJump) {
+    unsigned int sJump[4] = { 0, 0, 0, 0 };
+    for (int iw = 0; iw < 4; ++iw)
+    for (int ib = 0; ib < 32; ++ib) {
+      if (poly[iw] & (1u << ib))
+        for (int jw = 0; jw < 4; ++jw) sJump[jw] ^= xs[jw];
+      nextXoshiro(xs);
+    }
+    for (int jw = 0; jw < 4; ++jw) xs[jw] = sJump[jw];
+  }
+  return true;
+
+}
+
+//--------------------------------------------------------------------------
+
 // Pick one option among  vector of (positive) probabilities.
 
 int Rndm::pick(const vector<double>& prob) {
@@ -166,6 +278,8 @@ bool Rndm::dumpState(string fileName) {
   ofs.write((char *) &cd,       sizeof(double));
   ofs.write((char *) &cm,       sizeof(double));
   ofs.write((char *) &u,        sizeof(double) * 97);
+  ofs.write((char *) &engineSave, sizeof(int));
+  ofs.write((char *) &xs,       sizeof(unsigned int) * 4);
 
   // Write confirmation on cout.
   cout << " PYTHIA Rndm::dumpState: seed = " << seedSave
@@ -199,6 +313,14 @@ bool Rndm::readState(string fileName) {
   ifs.read((char *) &cm,       sizeof(double));
   ifs.read((char *) &u,        sizeof(double) *97);
 
+  // Engine choice and xoshiro128++ state, absent in older files.
+  engineSave = 0;
+  int engineIn = 0;
+  if (ifs.read((char *) &engineIn, sizeof(int))
+    && ifs.read((char *) &xs, sizeof(unsigned int) * 4))
+    engineSave = (engineIn == 1) ? 1 : 0;
+  initRndm = true;
+
   // Write confirmation on cout.
   cout << " PYTHIA Rndm::readState: seed " << seedSave
        << ", sequence no = " << sequence << endl;
@@ -405,6 +527,29 @@ void Vec4::bstback(const Vec4& pIn, double mIn) {
 
 //--------------------------------------------------------------------------
 
+// Boost of an array of four-vectors, with given gamma. Same arithmetic
+// as for a single four-vector, but with the boost parameters kept in
+// local variables, so that the compiler can pair the components of
+// each four-vector in SIMD instructions.
+
+void Vec4::bst(Vec4* vIn, int nIn, double betaX, double betaY,
+  double betaZ, double gamma) {
+
+  double gamma1 = 1. + gamma;
+  for (int i = 0; i < nIn; ++i) {
+    double x = vIn[i].xx, y = vIn[i].yy, z = vIn[i].zz, t = vIn[i].tt;
+    double prod1 = betaX * x + betaY * y + betaZ * z;
+    double prod2 = gamma * (gamma * prod1 / gamma1 + t);
+    vIn[i].xx = x + prod2 * betaX;
+    vIn[i].yy = y + prod2 * betaY;
+    vIn[i].zz = z + prod2 * betaZ;
+    vIn[i].tt = gamma * (t + prod1);
+  }
+
+}
+
+//--------------------------------------------------------------------------
+
 // Arbitrary combination of rotations and boosts defined by 4 * 4 matrix.
 
 void Vec4::rotbst(const RotBstMatrix& M) {
@@ -838,6 +983,29 @@ void RotBstMatrix::reset() {
 
 //--------------------------------------------------------------------------
 
+// Apply the matrix to an array of four-vectors. The matrix elements are
+// kept in local variables, so that the compiler can pair the components
+// of each four-vector in SIMD instructions.
+
+void RotBstMatrix::apply(Vec4* vIn, int nIn) const {
+
+  double m00 = M[0][0], m01 = M[0][1], m02 = M[0][2], m03 = M[0][3];
+  double m10 = M[1][0], m11 = M[1][1], m12 = M[1][2], m13 = M[1][3];
+  double m20 = M[2][0], m21 = M[2][1], m22 = M[2][2], m23 = M[2][3];
+  double m30 = M[3][0], m31 = M[3][1], m32 = M[3][2], m33 = M[3][3];
+  for (int i = 0; i < nIn; ++i) {
+    double x = vIn[i].px(), y = vIn[i].py(), z = vIn[i].pz(),
+      t = vIn[i].e();
+    vIn[i].p( m10 * t + m11 * x + m12 * y + m13 * z,
+              m20 * t + m21 * x + m22 * y + m23 * z,
+              m30 * t + m31 * x + m32 * y + m33 * z,
+              m00 * t + m01 * x + m02 * y + m03 * z);
+  }
+
+}
+
+//--------------------------------------------------------------------------
+
 // Crude estimate deviation from unit matrix.
 
 double RotBstMatrix::deviation() const {
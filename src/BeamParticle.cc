@@ -1288,7 +1288,7 @@ bool BeamParticle::roomFor2Remnants(int id1, double x1, double eCM) {
 
 // Check whether room for two remnants in the event. This used by MPI.
 
-bool BeamParticle::roomForRemnants(BeamParticle beamOther) {
+bool BeamParticle::roomForRemnants(BeamParticle& beamOther) {
 
   // Calculate the invariant mass remaining after MPIs.
   double xLeftA   = this->xMax(-1);
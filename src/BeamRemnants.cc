@@ -137,7 +137,7 @@ bool BeamRemnants::add( Event& event, int iFirst, bool doDiffCR) {
   oldSize = event.size();
 
   // Store event as it was before adding anything.
-  Event eventSave = event;
+  eventSave = event;
   BeamParticle beamAsave = (*beamAPtr);
   BeamParticle beamBsave = (*beamBPtr);
   PartonSystems partonSystemsSave = (*partonSystemsPtr);
@@ -151,7 +151,7 @@ bool BeamRemnants::add( Event& event, int iFirst, bool doDiffCR) {
   if (isDIS) return true;
 
   // Store event before doing colour reconnections.
-  Event eventTmpSave = event;
+  eventTmpSave = event;
   bool colCorrect = false;
   for (int i = 0; i < 10; ++i) {
     if (doReconnect && doDiffCR
@@ -305,7 +305,7 @@ bool BeamRemnants::addOld( Event& event) {
 bool BeamRemnants::addNew( Event& event) {
 
    // Start by saving a copy of the event, if the beam remnant fails.
-  Event eventSave = event;
+  eventAddSave = event;
   BeamParticle beamAsave = (*beamAPtr);
   BeamParticle beamBsave = (*beamBPtr);
   PartonSystems partonSystemsSave = (*partonSystemsPtr);
@@ -337,7 +337,7 @@ bool BeamRemnants::addNew( Event& event) {
     // Do the kinematics of the collision subsystems and two beam remnants.
     if (!setKinematics(event)) {
       // If it does not work, try parton level again.
-      event = eventSave;
+      event = eventAddSave;
       (*beamAPtr) = beamAsave;
       (*beamBPtr) = beamBsave;
       (*partonSystemsPtr) = partonSystemsSave;
@@ -357,7 +357,7 @@ bool BeamRemnants::addNew( Event& event) {
     // If failed, restore earlier configuration and try to find new
     // colour structure.
     else {
-      event = eventSave;
+      event = eventAddSave;
       (*beamAPtr) = beamAsave;
       (*beamBPtr) = beamBsave;
       (*partonSystemsPtr) = partonSystemsSave;
@@ -369,7 +369,7 @@ bool BeamRemnants::addNew( Event& event) {
     infoPtr->errorMsg("Error in BeamRemnants::add: "
         "failed to find physical colour structure");
     // Restore event to previous state.
-    event = eventSave;
+    event = eventAddSave;
     (*beamAPtr) = beamAsave;
     (*beamBPtr) = beamBsave;
     (*partonSystemsPtr) = partonSystemsSave;
@@ -1199,10 +1199,8 @@ bool BeamRemnants::setOneRemnKinematics( Event& event, int beamOffset) {
   MforScat.bst( pHadScat, pNewScat);
   int sizeSave = event.size();
   for (int i = 5 + beamOffset; i < sizeSave; ++i)
-    if ( i != iLepScat && event[i].isFinal() ) {
-      int iNew = event.copy( i, 62);
-      event[iNew].rotbst( MforScat, false);
-  }
+    if ( i != iLepScat && event[i].isFinal() ) event.copy( i, 62);
+  event.rotbst( MforScat, sizeSave, event.size(), false);
 
   // Calculate kinematics of remnants and insert into event record.
   double eNewRemn = 0.5 * (w2Tot + w2Remn - w2Scat) / sqrt(w2Tot);
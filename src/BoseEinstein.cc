@@ -11,6 +11,59 @@ namespace Pythia8 {
 
 //==========================================================================
 
+// The BoseEinsteinHadrons class.
+
+//--------------------------------------------------------------------------
+
+// Reset list of hadrons, but keep allocated memory.
+
+void BoseEinsteinHadrons::clear() {
+
+  iPos.resize(0);
+  px.resize(0);
+  py.resize(0);
+  pz.resize(0);
+  e.resize(0);
+  m2.resize(0);
+  y.resize(0);
+  mT.resize(0);
+  sx.resize(0);
+  sy.resize(0);
+  sz.resize(0);
+  cx.resize(0);
+  cy.resize(0);
+  cz.resize(0);
+
+}
+
+//--------------------------------------------------------------------------
+
+// Add a hadron, with rapidity and transverse mass for the pair search.
+// The latter is defined from energy and longitudinal momentum, since it
+// is used for a lower bound on the pair invariant mass.
+
+void BoseEinsteinHadrons::add(int iPosIn, const Particle& particleIn) {
+
+  iPos.push_back( iPosIn);
+  px.push_back( particleIn.px());
+  py.push_back( particleIn.py());
+  pz.push_back( particleIn.pz());
+  e.push_back( particleIn.e());
+  m2.push_back( pow2(particleIn.m()));
+  y.push_back( particleIn.y());
+  mT.push_back( sqrtpos( (particleIn.e() + particleIn.pz())
+    * (particleIn.e() - particleIn.pz()) ) );
+  sx.push_back( 0.);
+  sy.push_back( 0.);
+  sz.push_back( 0.);
+  cx.push_back( 0.);
+  cy.push_back( 0.);
+  cz.push_back( 0.);
+
+}
+
+//==========================================================================
+
 // The BoseEinstein class.
 
 //--------------------------------------------------------------------------
@@ -35,6 +88,14 @@ const double BoseEinstein::COMPRELERR = 1e-10;
 const double BoseEinstein::COMPFACMAX = 1000.;
 const int    BoseEinstein::NCOMPSTEP  = 10;
 
+// Dampening factor 1 - exp(-x) is exactly unity in double precision
+// above this x, so need not be calculated.
+const double BoseEinstein::EXPMAX     = 40.;
+
+// Safety margin in rapidity when searching for pairs below a Q cut,
+// to allow for rounding errors and small offshellness.
+const double BoseEinstein::DYSAFETY   = 1e-6;
+
 //--------------------------------------------------------------------------
 
 // Find settings. Precalculate table used to find momentum shifts.
@@ -54,6 +115,10 @@ bool BoseEinstein::init(Info* infoPtrIn, Settings& settings,
   lambda   = settings.parm("BoseEinstein:lambda");
   QRef     = settings.parm("BoseEinstein:QRef");
 
+  // Pairs with a larger relative momentum are not shifted, if cut is set.
+  QMaxPair  = settings.parm("BoseEinstein:QMaxPair");
+  Q2MaxPair = (QMaxPair > 0.) ? QMaxPair * QMaxPair : 0.;
+
   // Multiples and inverses (= "radii") of distance parameters in Q-space.
   QRef2    = 2. * QRef;
   QRef3    = 3. * QRef;
@@ -120,47 +185,68 @@ bool BoseEinstein::init(Info* infoPtrIn, Settings& settings,
 bool BoseEinstein::shiftEvent( Event& event) {
 
   // Reset list of identical particles.
-  hadronBE.resize(0);
+  hadronBE.clear();
+  for (int iSpecies = 0; iSpecies < 9; ++iSpecies)
+    sortBE[iSpecies].resize(0);
 
-  // Loop over all hadron species with BE effects.
+  // Hadron species with BE effects.
+  bool doSpecies[9];
+  for (int iSpecies = 0; iSpecies < 9; ++iSpecies)
+    doSpecies[iSpecies] = (iSpecies <= 2) ? doPion
+      : ( (iSpecies <= 6) ? doKaon : doEta );
+
+  // Loop once through event record to find all studied hadrons,
+  // with their rapidity for sorting.
+  for (int i = 0; i < event.size(); ++i) {
+    if (!event[i].isFinal()) continue;
+    int idNow = event[i].id();
+    for (int iSpecies = 0; iSpecies < 9; ++iSpecies)
+    if (idNow == IDHADRON[iSpecies]) {
+      if (doSpecies[iSpecies]) sortBE[iSpecies].push_back(
+        make_pair( event[i].y(), i) );
+      break;
+    }
+  }
+
+  // Store copies of each species in turn, ordered in rapidity.
   nStored[0] = 0;
   for (int iSpecies = 0; iSpecies < 9; ++iSpecies) {
-    nStored[iSpecies + 1] = nStored[iSpecies];
-    if (!doPion && iSpecies <= 2) continue;
-    if (!doKaon && iSpecies >= 3 && iSpecies <= 6) continue;
-    if (!doEta  && iSpecies >= 7) continue;
-
-    // Properties of current hadron species.
-    int idNow = IDHADRON[ iSpecies ];
-    int iTab  = ITABLE[ iSpecies ];
-
-    // Loop through event record to store copies of current species.
-    for (int i = 0; i < event.size(); ++i)
-      if ( event[i].id() == idNow && event[i].isFinal() )
-        hadronBE.push_back(
-          BoseEinsteinHadron( idNow, i, event[i].p(), event[i].m() ) );
+    vector< pair<double,int> >& sortNow = sortBE[iSpecies];
+    sort( sortNow.begin(), sortNow.end());
+    for (int i = 0; i < int(sortNow.size()); ++i)
+      hadronBE.add( sortNow[i].second, event[sortNow[i].second]);
     nStored[iSpecies + 1] = hadronBE.size();
 
-    // Loop through pairs of identical particles and find shifts.
-    for (int i1 = nStored[iSpecies]; i1 < nStored[iSpecies+1] - 1; ++i1)
-    for (int i2 = i1 + 1; i2 < nStored[iSpecies+1]; ++i2)
-      shiftPair( i1, i2, iTab);
+    // Find shifts for pairs of identical particles.
+    shiftSpecies( nStored[iSpecies], nStored[iSpecies + 1],
+      ITABLE[iSpecies]);
   }
 
   // Must have at least two pairs to carry out compensation.
   if (nStored[9] < 2) return true;
 
   // Shift momenta and recalculate energies.
+  int     nHad = nStored[9];
+  double* px = &hadronBE.px[0];
+  double* py = &hadronBE.py[0];
+  double* pz = &hadronBE.pz[0];
+  double* e  = &hadronBE.e[0];
+  double* m2 = &hadronBE.m2[0];
+  double* cx = &hadronBE.cx[0];
+  double* cy = &hadronBE.cy[0];
+  double* cz = &hadronBE.cz[0];
   double eSumOriginal = 0.;
   double eSumShifted  = 0.;
   double eDiffByComp  = 0.;
-  for (int i = 0; i < nStored[9]; ++i) {
-    eSumOriginal  += hadronBE[i].p.e();
-    hadronBE[i].p += hadronBE[i].pShift;
-    hadronBE[i].p.e( sqrt( hadronBE[i].p.pAbs2() + hadronBE[i].m2 ) );
-    eSumShifted   += hadronBE[i].p.e();
-    eDiffByComp   += dot3( hadronBE[i].pComp, hadronBE[i].p)
-                     / hadronBE[i].p.e();
+  for (int i = 0; i < nHad; ++i) {
+    eSumOriginal += e[i];
+    px[i]        += hadronBE.sx[i];
+    py[i]        += hadronBE.sy[i];
+    pz[i]        += hadronBE.sz[i];
+    e[i]          = sqrt( px[i] * px[i] + py[i] * py[i] + pz[i] * pz[i]
+                  + m2[i] );
+    eSumShifted  += e[i];
+    eDiffByComp  += (cx[i] * px[i] + cy[i] * py[i] + cz[i] * pz[i]) / e[i];
   }
 
   // Iterate compensation shift until convergence.
@@ -172,12 +258,15 @@ bool BoseEinstein::shiftEvent( Event& event) {
     double compFac   = (eSumOriginal - eSumShifted) / eDiffByComp;
     eSumShifted      = 0.;
     eDiffByComp      = 0.;
-    for (int i = 0; i < nStored[9]; ++i) {
-      hadronBE[i].p += compFac * hadronBE[i].pComp;
-      hadronBE[i].p.e( sqrt( hadronBE[i].p.pAbs2() + hadronBE[i].m2 ) );
-      eSumShifted   += hadronBE[i].p.e();
-      eDiffByComp   += dot3( hadronBE[i].pComp, hadronBE[i].p)
-                       / hadronBE[i].p.e();
+    for (int i = 0; i < nHad; ++i) {
+      px[i]         += compFac * cx[i];
+      py[i]         += compFac * cy[i];
+      pz[i]         += compFac * cz[i];
+      e[i]           = sqrt( px[i] * px[i] + py[i] * py[i] + pz[i] * pz[i]
+                     + m2[i] );
+      eSumShifted   += e[i];
+      eDiffByComp   += (cx[i] * px[i] + cy[i] * py[i] + cz[i] * pz[i])
+                     / e[i];
     }
   }
 
@@ -189,10 +278,19 @@ bool BoseEinstein::shiftEvent( Event& event) {
     return true;
   }
 
-  // Store new particle copies with shifted momenta.
-  for (int i = 0; i < nStored[9]; ++i) {
-    int iNew = event.copy( hadronBE[i].iPos, 99);
-    event[ iNew ].p( hadronBE[i].p );
+  // Store new particle copies with shifted momenta, in the order
+  // of the original event record within each species.
+  for (int iSpecies = 0; iSpecies < 9; ++iSpecies) {
+    vector< pair<double,int> >& sortNow = sortBE[iSpecies];
+    for (int i = 0; i < int(sortNow.size()); ++i)
+      sortNow[i] = make_pair( double(hadronBE.iPos[nStored[iSpecies] + i]),
+        nStored[iSpecies] + i);
+    sort( sortNow.begin(), sortNow.end());
+    for (int i = 0; i < int(sortNow.size()); ++i) {
+      int iHad = sortNow[i].second;
+      int iNew = event.copy( hadronBE.iPos[iHad], 99);
+      event[ iNew ].p( px[iHad], py[iHad], pz[iHad], e[iHad] );
+    }
   }
 
   // Done.
@@ -202,13 +300,77 @@ bool BoseEinstein::shiftEvent( Event& event) {
 
 //--------------------------------------------------------------------------
 
+// Find shifts for all pairs of hadrons of one species, stored in the
+// range [iBeg, iEnd) ordered in rapidity. With a cut on the pair Q the
+// search for partners stops at a rapidity difference where no pair can
+// pass, since Q^2 >= (m1 + m2)^2 - 4 m^2 + 2 mT1 mT2 (cosh(dy) - 1).
+
+void BoseEinstein::shiftSpecies( int iBeg, int iEnd, int iTab) {
+
+  // Need at least two hadrons.
+  if (iEnd - iBeg < 2) return;
+  const double* px = &hadronBE.px[0];
+  const double* py = &hadronBE.py[0];
+  const double* pz = &hadronBE.pz[0];
+  const double* e  = &hadronBE.e[0];
+  const double* y  = &hadronBE.y[0];
+  const double* mT = &hadronBE.mT[0];
+  double m2P = m2Pair[iTab];
+
+  // Smallest transverse mass and invariant mass, for the rapidity range.
+  double mTMin = mT[iBeg];
+  double mMin  = sqrtpos( e[iBeg] * e[iBeg] - px[iBeg] * px[iBeg]
+    - py[iBeg] * py[iBeg] - pz[iBeg] * pz[iBeg] );
+  for (int i = iBeg + 1; i < iEnd; ++i) {
+    mTMin = min( mTMin, mT[i]);
+    mMin  = min( mMin, sqrtpos( e[i] * e[i] - px[i] * px[i]
+      - py[i] * py[i] - pz[i] * pz[i] ) );
+  }
+  double Q2Range = Q2MaxPair + m2P - 4. * mMin * mMin;
+
+  // Loop over first hadron of pair, and find range of partners.
+  for (int i1 = iBeg; i1 < iEnd - 1; ++i1) {
+    int i2End = iEnd;
+    if (Q2MaxPair > 0.) {
+      double coshMax = 1. + max( 0., Q2Range) / (2. * mT[i1] * mTMin);
+      double yMax    = y[i1] + (1. + DYSAFETY) * log( coshMax
+        + sqrt( coshMax * coshMax - 1.) ) + DYSAFETY;
+      i2End = std::upper_bound( y + i1 + 1, y + iEnd, yMax) - y;
+    }
+    int nPair = i2End - i1 - 1;
+    if (nPair <= 0) continue;
+
+    // Pair Q^2 in a simple loop that can be vectorized.
+    if (int(Q2Pair.size()) < nPair) Q2Pair.resize( nPair);
+    double* Q2Now = &Q2Pair[0];
+    const double px1 = px[i1];
+    const double py1 = py[i1];
+    const double pz1 = pz[i1];
+    const double e1  = e[i1];
+    for (int k = 0; k < nPair; ++k) {
+      int    i2  = i1 + 1 + k;
+      double eS  = e1 + e[i2];
+      double pxS = px1 + px[i2];
+      double pyS = py1 + py[i2];
+      double pzS = pz1 + pz[i2];
+      Q2Now[k]   = eS * eS - pxS * pxS - pyS * pyS - pzS * pzS - m2P;
+    }
+
+    // Shifts for pairs inside the allowed range.
+    for (int k = 0; k < nPair; ++k)
+    if (Q2Now[k] >= Q2MIN && (Q2MaxPair <= 0. || Q2Now[k] < Q2MaxPair))
+      shiftPair( i1, i1 + 1 + k, iTab, Q2Now[k]);
+  }
+
+}
+
+//--------------------------------------------------------------------------
+
 // Calculate shift and (unnormalized) compensation for pair.
 
-void BoseEinstein::shiftPair( int i1, int i2, int iTab) {
+void BoseEinstein::shiftPair( int i1, int i2, int iTab, double Q2old) {
 
   // Calculate old relative momentum.
-  double Q2old = m2(hadronBE[i1].p, hadronBE[i2].p) - m2Pair[iTab];
-  if (Q2old < Q2MIN) return;
   double Qold  = sqrt(Q2old);
   double psFac = sqrt(Q2old + m2Pair[iTab]) / Q2old;
 
@@ -226,22 +388,34 @@ void BoseEinstein::shiftPair( int i1, int i2, int iTab) {
   else Qmove = shift[iTab][nStep[iTab]] * psFac;
   double Q2new = Q2old * pow( Qold / (Qold + 3. * lambda * Qmove), 2. / 3.);
 
+  // Momentum differences of the pair.
+  double dpx       = hadronBE.px[i1] - hadronBE.px[i2];
+  double dpy       = hadronBE.py[i1] - hadronBE.py[i2];
+  double dpz       = hadronBE.pz[i1] - hadronBE.pz[i2];
+  double e1        = hadronBE.e[i1];
+  double e2        = hadronBE.e[i2];
+
   // Calculate corresponding three-momentum shift.
   double Q2Diff    = Q2new - Q2old;
-  double p2DiffAbs = (hadronBE[i1].p - hadronBE[i2].p).pAbs2();
-  double p2AbsDiff = hadronBE[i1].p.pAbs2() - hadronBE[i2].p.pAbs2();
-  double eSum      = hadronBE[i1].p.e() + hadronBE[i2].p.e();
-  double eDiff     = hadronBE[i1].p.e() - hadronBE[i2].p.e();
+  double p2DiffAbs = dpx * dpx + dpy * dpy + dpz * dpz;
+  double p2AbsDiff = pow2(hadronBE.px[i1]) + pow2(hadronBE.py[i1])
+    + pow2(hadronBE.pz[i1]) - pow2(hadronBE.px[i2])
+    - pow2(hadronBE.py[i2]) - pow2(hadronBE.pz[i2]);
+  double eSum      = e1 + e2;
+  double eDiff     = e1 - e2;
   double sumQ2E    = Q2Diff + eSum * eSum;
   double rootA     = eSum * eDiff * p2AbsDiff - p2DiffAbs * sumQ2E;
   double rootB     = p2DiffAbs * sumQ2E - p2AbsDiff * p2AbsDiff;
   double factor    = 0.5 * ( rootA + sqrtpos(rootA * rootA
     + Q2Diff * (sumQ2E - eDiff * eDiff) * rootB) ) / rootB;
 
-  // Add shifts to sum. (Energy component dummy.)
-  Vec4   pDiff     = factor * (hadronBE[i1].p - hadronBE[i2].p);
-  hadronBE[i1].pShift += pDiff;
-  hadronBE[i2].pShift -= pDiff;
+  // Add shifts to sum.
+  hadronBE.sx[i1] += factor * dpx;
+  hadronBE.sy[i1] += factor * dpy;
+  hadronBE.sz[i1] += factor * dpz;
+  hadronBE.sx[i2] -= factor * dpx;
+  hadronBE.sy[i2] -= factor * dpy;
+  hadronBE.sz[i2] -= factor * dpz;
 
   // Calculate new relative momentum for compensation shift.
   double Qmove3 = 0.;
@@ -266,12 +440,15 @@ void BoseEinstein::shiftPair( int i1, int i2, int iTab) {
     + Q2Diff * (sumQ2E - eDiff * eDiff) * rootB) ) / rootB;
 
   // Extra dampening factor to go from BE_3 to BE_32.
-  factor   *= 1. - exp(-Q2old * R2Ref2);
-
-  // Add shifts to sum. (Energy component dummy.)
-  pDiff     = factor * (hadronBE[i1].p - hadronBE[i2].p);
-  hadronBE[i1].pComp += pDiff;
-  hadronBE[i2].pComp -= pDiff;
+  if (Q2old * R2Ref2 < EXPMAX) factor *= 1. - exp(-Q2old * R2Ref2);
+
+  // Add shifts to sum.
+  hadronBE.cx[i1] += factor * dpx;
+  hadronBE.cy[i1] += factor * dpy;
+  hadronBE.cz[i1] += factor * dpz;
+  hadronBE.cx[i2] -= factor * dpx;
+  hadronBE.cy[i2] -= factor * dpy;
+  hadronBE.cz[i2] -= factor * dpz;
 
 }
 
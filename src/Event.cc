@@ -184,10 +184,20 @@ int Particle::iBotCopyId( bool simplify) const {
 // Find complete list of mothers.
 
 vector<int> Particle::motherList() const {
-
-  // Vector of all the mothers; created empty. Done if no event pointer.
   vector<int> motherVec;
-  if (evtPtr == 0) return motherVec;
+  motherList( motherVec);
+  return motherVec;
+}
+
+//--------------------------------------------------------------------------
+
+// Find complete list of mothers, stored in an existing vector.
+
+void Particle::motherList(vector<int>& motherVec) const {
+
+  // Vector of all the mothers; emptied. Done if no event pointer.
+  motherVec.resize(0);
+  if (evtPtr == 0) return;
 
   // Special cases in the beginning, where the meaning of zero is unclear.
   int statusSaveAbs = abs(statusSave);
@@ -210,9 +220,6 @@ vector<int> Particle::motherList() const {
     motherVec.push_back( max(mother1Save, mother2Save) );
   }
 
-  // Done.
-  return motherVec;
-
 }
 
 //--------------------------------------------------------------------------
@@ -220,10 +227,20 @@ vector<int> Particle::motherList() const {
 // Find complete list of daughters.
 
 vector<int> Particle::daughterList() const {
-
-  // Vector of all the daughters; created empty. Done if no event pointer.
   vector<int> daughterVec;
-  if (evtPtr == 0) return daughterVec;
+  daughterList( daughterVec);
+  return daughterVec;
+}
+
+//--------------------------------------------------------------------------
+
+// Find complete list of daughters, stored in an existing vector.
+
+void Particle::daughterList(vector<int>& daughterVec) const {
+
+  // Vector of all the daughters; emptied. Done if no event pointer.
+  daughterVec.resize(0);
+  if (evtPtr == 0) return;
 
   // Simple cases: no or one daughter.
   if (daughter1Save == 0 && daughter2Save == 0) ;
@@ -254,9 +271,6 @@ vector<int> Particle::daughterList() const {
     }
   }
 
-  // Done.
-  return daughterVec;
-
 }
 
 //--------------------------------------------------------------------------
@@ -586,6 +600,9 @@ double m2(const Particle& pp1, const Particle& pp2) {
 // Maxmimum number of mothers or daughter indices per line in listing.
 const int Event::IPERLINE = 20;
 
+// Small number to avoid division by zero.
+const double Event::TINY = 1e-20;
+
 //--------------------------------------------------------------------------
 
 // Copy all information from one event record to another.
@@ -601,13 +618,11 @@ Event& Event::operator=( const Event& oldEvent) {
     // Copy particle data table; needed for individual particles.
     particleDataPtr     = oldEvent.particleDataPtr;
 
-    // Copy all the particles one by one.
-    maxColTag = 100;
-    for (int i = 0; i < oldEvent.size(); ++i) append( oldEvent[i] );
-
-    // Copy all the junctions one by one.
-    for (int i = 0; i < oldEvent.sizeJunction(); ++i)
-      appendJunction( oldEvent.getJunction(i) );
+    // Copy all the particles and junctions in one go, reusing the
+    // existing space, and point the particles to this event.
+    entry    = oldEvent.entry;
+    for (int i = 0; i < size(); ++i) entry[i].moveEvtPtr(this);
+    junction = oldEvent.junction;
 
     // Copy all other values.
     startColTag         = oldEvent.startColTag;
@@ -702,6 +717,94 @@ void Event::remove(int iFirst, int iLast, bool shiftHistory) {
 
 //--------------------------------------------------------------------------
 
+// Boost all entries, with gamma factor evaluated once.
+
+void Event::bst(double betaX, double betaY, double betaZ) {
+
+  double beta2 = betaX*betaX + betaY*betaY + betaZ*betaZ;
+  if (beta2 >= 1.) return;
+  transform( 0, betaX, betaY, betaZ, 1. / sqrt(1. - beta2), 0, -1, true);
+
+}
+
+//--------------------------------------------------------------------------
+
+// Boost all entries by the velocity of a four-vector.
+
+void Event::bst(const Vec4& vec) {
+
+  if (abs(vec.e()) < TINY) return;
+  double betaX = vec.px() / vec.e();
+  double betaY = vec.py() / vec.e();
+  double betaZ = vec.pz() / vec.e();
+  bst( betaX, betaY, betaZ);
+
+}
+
+//--------------------------------------------------------------------------
+
+// Rotate and boost a range of entries, by matrix or by boost. The
+// transformation is kept in local variables rather than reloaded for
+// each four-vector, which also lets the compiler pair the components in
+// SIMD instructions. Same arithmetic as for the Vec4 methods.
+
+void Event::transform(const RotBstMatrix* MPtr, double betaX, double betaY,
+  double betaZ, double gamma, int iBeg, int iEnd, bool boostVertices) {
+
+  // Check range.
+  if (iBeg < 0) iBeg = 0;
+  if (iEnd < 0 || iEnd > size()) iEnd = size();
+  double x, y, z, t;
+
+  // Transform by matrix, with a local copy of it.
+  if (MPtr != 0) {
+    double m00 = MPtr->value(0, 0), m01 = MPtr->value(0, 1),
+           m02 = MPtr->value(0, 2), m03 = MPtr->value(0, 3),
+           m10 = MPtr->value(1, 0), m11 = MPtr->value(1, 1),
+           m12 = MPtr->value(1, 2), m13 = MPtr->value(1, 3),
+           m20 = MPtr->value(2, 0), m21 = MPtr->value(2, 1),
+           m22 = MPtr->value(2, 2), m23 = MPtr->value(2, 3),
+           m30 = MPtr->value(3, 0), m31 = MPtr->value(3, 1),
+           m32 = MPtr->value(3, 2), m33 = MPtr->value(3, 3);
+    for (int i = iBeg; i < iEnd; ++i) {
+      Particle& pNow = entry[i];
+      x = pNow.px(); y = pNow.py(); z = pNow.pz(); t = pNow.e();
+      pNow.p( m10 * t + m11 * x + m12 * y + m13 * z,
+              m20 * t + m21 * x + m22 * y + m23 * z,
+              m30 * t + m31 * x + m32 * y + m33 * z,
+              m00 * t + m01 * x + m02 * y + m03 * z);
+      if (!boostVertices || !pNow.hasVertex()) continue;
+      x = pNow.xProd(); y = pNow.yProd(); z = pNow.zProd(); t = pNow.tProd();
+      pNow.vProd( m10 * t + m11 * x + m12 * y + m13 * z,
+                  m20 * t + m21 * x + m22 * y + m23 * z,
+                  m30 * t + m31 * x + m32 * y + m33 * z,
+                  m00 * t + m01 * x + m02 * y + m03 * z);
+    }
+
+  // Transform by boost.
+  } else {
+    double gamma1 = 1. + gamma;
+    double prod1, prod2;
+    for (int i = iBeg; i < iEnd; ++i) {
+      Particle& pNow = entry[i];
+      x = pNow.px(); y = pNow.py(); z = pNow.pz(); t = pNow.e();
+      prod1 = betaX * x + betaY * y + betaZ * z;
+      prod2 = gamma * (gamma * prod1 / gamma1 + t);
+      pNow.p( x + prod2 * betaX, y + prod2 * betaY, z + prod2 * betaZ,
+        gamma * (t + prod1));
+      if (!boostVertices || !pNow.hasVertex()) continue;
+      x = pNow.xProd(); y = pNow.yProd(); z = pNow.zProd(); t = pNow.tProd();
+      prod1 = betaX * x + betaY * y + betaZ * z;
+      prod2 = gamma * (gamma * prod1 / gamma1 + t);
+      pNow.vProd( x + prod2 * betaX, y + prod2 * betaY, z + prod2 * betaZ,
+        gamma * (t + prod1));
+    }
+  }
+
+}
+
+//--------------------------------------------------------------------------
+
 // Print an event.
 
 void Event::list(bool showScaleAndVertex, bool showMothersAndDaughters,
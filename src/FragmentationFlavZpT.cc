@@ -49,14 +49,6 @@ void StringFlav::init(Settings& settings, ParticleData* particleDataPtrIn,
   probSQtoQQ      = settings.parm("StringFlav:probSQtoQQ");
   probQQ1toQQ0    = settings.parm("StringFlav:probQQ1toQQ0");
 
-  // Parameters derived from above.
-  probQandQQ      = 1. + probQQtoQ;
-  probQandS       = 2. + probStoUD;
-  probQandSinQQ   = 2. + probSQtoQQ * probStoUD;
-  probQQ1corr     = 3. * probQQ1toQQ0;
-  probQQ1corrInv  = 1. / probQQ1corr;
-  probQQ1norm     = probQQ1corr / (1. + probQQ1corr);
-
   // Spin parameters for combining two quarks to a diquark.
   vector<double> pQQ1tmp = settings.pvec("StringFlav:probQQ1toQQ0join");
   for (int i = 0; i < 4; ++i)
@@ -157,126 +149,8 @@ void StringFlav::init(Settings& settings, ParticleData* particleDataPtrIn,
   exponentMPI      = settings.parm("StringPT:expMPI");
   exponentNSP      = settings.parm("StringPT:expNSP");
 
-  // Begin calculation of derived parameters for baryon production.
-
-  // Enumerate distinguishable diquark types (in diquark first is popcorn q).
-  enum Diquark {ud0, ud1, uu1, us0, su0, us1, su1, ss1};
-
-  // Maximum SU(6) weight by diquark type.
-  double barCGMax[8];
-  barCGMax[ud0] = baryonCGMax[0];
-  barCGMax[ud1] = baryonCGMax[4];
-  barCGMax[uu1] = baryonCGMax[2];
-  barCGMax[us0] = baryonCGMax[0];
-  barCGMax[su0] = baryonCGMax[0];
-  barCGMax[us1] = baryonCGMax[4];
-  barCGMax[su1] = baryonCGMax[4];
-  barCGMax[ss1] = baryonCGMax[2];
-
-  // Diquark SU(6) survival = Sum_quark (quark tunnel weight) * SU(6).
-  double dMB[8];
-  dMB[ud0] = 2. * baryonCGSum[0] + probStoUD * baryonCGSum[1];
-  dMB[ud1] = 2. * baryonCGSum[4] + probStoUD * baryonCGSum[5];
-  dMB[uu1] = baryonCGSum[2] + (1. + probStoUD) * baryonCGSum[3];
-  dMB[us0] = (1. + probStoUD) * baryonCGSum[0] + baryonCGSum[1];
-  dMB[su0] = dMB[us0];
-  dMB[us1] = (1. + probStoUD) * baryonCGSum[4] + baryonCGSum[5];
-  dMB[su1] = dMB[us1];
-  dMB[ss1] = probStoUD * baryonCGSum[2] + 2. * baryonCGSum[3];
-  for (int i = 1; i < 8; ++i) dMB[i] = dMB[i] / dMB[0];
-
-  // Tunneling factors for diquark production; only half a pair = sqrt.
-  double probStoUDroot    = sqrt(probStoUD);
-  double probSQtoQQroot   = sqrt(probSQtoQQ);
-  double probQQ1toQQ0root = sqrt(probQQ1toQQ0);
-  double qBB[8];
-  qBB[ud1] = probQQ1toQQ0root;
-  qBB[uu1] = probQQ1toQQ0root;
-  qBB[us0] = probSQtoQQroot;
-  qBB[su0] = probStoUDroot * probSQtoQQroot;
-  qBB[us1] = probQQ1toQQ0root * qBB[us0];
-  qBB[su1] = probQQ1toQQ0root * qBB[su0];
-  qBB[ss1] = probStoUDroot * pow2(probSQtoQQroot) * probQQ1toQQ0root;
-
-  // spin * (vertex factor) * (half-tunneling factor above).
-  double qBM[8];
-  qBM[ud1] = 3. * qBB[ud1];
-  qBM[uu1] = 6. * qBB[uu1];
-  qBM[us0] = probStoUD * qBB[us0];
-  qBM[su0] = qBB[su0];
-  qBM[us1] = probStoUD * 3. * qBB[us1];
-  qBM[su1] = 3. * qBB[su1];
-  qBM[ss1] = probStoUD * 6. * qBB[ss1];
-
-  // Combine above two into total diquark weight for q -> B Bbar.
-  for (int i = 1; i < 8; ++i) qBB[i] = qBB[i] * qBM[i];
-
-  // Suppression from having strange popcorn meson.
-  qBM[us0] *= popcornSmeson;
-  qBM[us1] *= popcornSmeson;
-  qBM[ss1] *= popcornSmeson;
-
-  // Suppression for a heavy quark of a diquark to fit into a baryon
-  // on the other side of popcorn meson: (0) s/u for q -> B M;
-  // (1) s/u for rank 0 diquark su -> M B; (2) ditto for s -> c/b.
-  double uNorm = 1. + qBM[ud1] + qBM[uu1] + qBM[us0] + qBM[us1];
-  scbBM[0] = (2. * (qBM[su0] + qBM[su1]) + qBM[ss1]) / uNorm;
-  scbBM[1] = scbBM[0] * popcornSpair * qBM[su0] / qBM[us0];
-  scbBM[2] = (1. + qBM[ud1]) * (2. + qBM[us0]) / uNorm;
-
-  // Include maximum of Clebsch-Gordan coefficients.
-  for (int i = 1; i < 8; ++i) dMB[i] *= qBM[i];
-  for (int i = 1; i < 8; ++i) qBM[i] *= barCGMax[i] / barCGMax[0];
-  for (int i = 1; i < 8; ++i) qBB[i] *= barCGMax[i] / barCGMax[0];
-
-  // Popcorn fraction for normal diquark production.
-  double qNorm = uNorm * popcornRate / 3.;
-  double sNorm = scbBM[0] * popcornSpair;
-  popFrac = qNorm * (1. + qBM[ud1] + qBM[uu1] + qBM[us0] + qBM[us1]
-    + sNorm * (qBM[su0] + qBM[su1] + 0.5 * qBM[ss1])) / (1. +  qBB[ud1]
-    + qBB[uu1] + 2. * (qBB[us0] + qBB[us1]) + 0.5 * qBB[ss1]);
-
-  // Popcorn fraction for rank 0 diquarks, depending on number of s quarks.
-  popS[0] = qNorm * qBM[ud1] / qBB[ud1];
-  popS[1] = qNorm * 0.5 * (qBM[us1] / qBB[us1]
-    + sNorm * qBM[su1] / qBB[su1]);
-  popS[2] = qNorm * sNorm * qBM[ss1] / qBB[ss1];
-
-  // Recombine diquark weights to flavour and spin ratios. Second index:
-  // 0 = s/u popcorn quark ratio.
-  // 1, 2 = s/u ratio for vertex quark if popcorn quark is u/d or s.
-  // 3 = q/q' vertex quark ratio if popcorn quark is light and = q.
-  // 4, 5, 6 = (spin 1)/(spin 0) ratio for su, us and ud.
-
-  // Case 0: q -> B B.
-  dWT[0][0] = (2. * (qBB[su0] + qBB[su1]) + qBB[ss1])
-    / (1. + qBB[ud1] + qBB[uu1] + qBB[us0] + qBB[us1]);
-  dWT[0][1] = 2. * (qBB[us0] + qBB[us1]) / (1. + qBB[ud1] + qBB[uu1]);
-  dWT[0][2] = qBB[ss1] / (qBB[su0] + qBB[su1]);
-  dWT[0][3] = qBB[uu1] / (1. + qBB[ud1] + qBB[uu1]);
-  dWT[0][4] = qBB[su1] / qBB[su0];
-  dWT[0][5] = qBB[us1] / qBB[us0];
-  dWT[0][6] = qBB[ud1];
-
-  // Case 1: q -> B M B.
-  dWT[1][0] = (2. * (qBM[su0] + qBM[su1]) + qBM[ss1])
-    / (1. + qBM[ud1] + qBM[uu1] + qBM[us0] + qBM[us1]);
-  dWT[1][1] = 2. * (qBM[us0] + qBM[us1]) / (1. + qBM[ud1] + qBM[uu1]);
-  dWT[1][2] = qBM[ss1] / (qBM[su0] + qBM[su1]);
-  dWT[1][3] = qBM[uu1] / (1. + qBM[ud1] + qBM[uu1]);
-  dWT[1][4] = qBM[su1] / qBM[su0];
-  dWT[1][5] = qBM[us1] / qBM[us0];
-  dWT[1][6] = qBM[ud1];
-
-  // Case 2: qq -> M B; diquark inside chain.
-  dWT[2][0] = (2. * (dMB[su0] + dMB[su1]) + dMB[ss1])
-    / (1. + dMB[ud1] + dMB[uu1] + dMB[us0] + dMB[us1]);
-  dWT[2][1] = 2. * (dMB[us0] + dMB[us1]) / (1. + dMB[ud1] + dMB[uu1]);
-  dWT[2][2] = dMB[ss1] / (dMB[su0] + dMB[su1]);
-  dWT[2][3] = dMB[uu1] / (1. + dMB[ud1] + dMB[uu1]);
-  dWT[2][4] = dMB[su1] / dMB[su0];
-  dWT[2][5] = dMB[us1] / dMB[us0];
-  dWT[2][6] = dMB[ud1];
+  // Parameters derived from above.
+  initDerived();
 
   // Use thermal model?
   thermalModel = settings.flag("StringPT:thermalModel");
@@ -783,6 +657,164 @@ void StringFlav::init(Settings& settings, ParticleData* particleDataPtrIn,
 
 //--------------------------------------------------------------------------
 
+// Change the main flavour parameters without a full re-initialization,
+// e.g. for rope hadronization. Only the derived quantities are redone.
+
+void StringFlav::setPars(const FlavZpTPars& pars) {
+
+  // Basic parameters for generation of new flavour.
+  probQQtoQ       = pars.probQQtoQ;
+  probStoUD       = pars.probStoUD;
+  probSQtoQQ      = pars.probSQtoQQ;
+  probQQ1toQQ0    = pars.probQQ1toQQ0;
+
+  // Hadron width for mT2 suppression.
+  sigmaHad        = sqrt(2.0) * pars.sigma;
+
+  // Parameters derived from above.
+  initDerived();
+
+}
+
+//--------------------------------------------------------------------------
+
+// Calculate parameters derived from the basic flavour ones.
+
+void StringFlav::initDerived() {
+
+  // Simple combinations of basic parameters.
+  probQandQQ      = 1. + probQQtoQ;
+  probQandS       = 2. + probStoUD;
+  probQandSinQQ   = 2. + probSQtoQQ * probStoUD;
+  probQQ1corr     = 3. * probQQ1toQQ0;
+  probQQ1corrInv  = 1. / probQQ1corr;
+  probQQ1norm     = probQQ1corr / (1. + probQQ1corr);
+
+  // Begin calculation of derived parameters for baryon production.
+
+  // Enumerate distinguishable diquark types (in diquark first is popcorn q).
+  enum Diquark {ud0, ud1, uu1, us0, su0, us1, su1, ss1};
+
+  // Maximum SU(6) weight by diquark type.
+  double barCGMax[8];
+  barCGMax[ud0] = baryonCGMax[0];
+  barCGMax[ud1] = baryonCGMax[4];
+  barCGMax[uu1] = baryonCGMax[2];
+  barCGMax[us0] = baryonCGMax[0];
+  barCGMax[su0] = baryonCGMax[0];
+  barCGMax[us1] = baryonCGMax[4];
+  barCGMax[su1] = baryonCGMax[4];
+  barCGMax[ss1] = baryonCGMax[2];
+
+  // Diquark SU(6) survival = Sum_quark (quark tunnel weight) * SU(6).
+  double dMB[8];
+  dMB[ud0] = 2. * baryonCGSum[0] + probStoUD * baryonCGSum[1];
+  dMB[ud1] = 2. * baryonCGSum[4] + probStoUD * baryonCGSum[5];
+  dMB[uu1] = baryonCGSum[2] + (1. + probStoUD) * baryonCGSum[3];
+  dMB[us0] = (1. + probStoUD) * baryonCGSum[0] + baryonCGSum[1];
+  dMB[su0] = dMB[us0];
+  dMB[us1] = (1. + probStoUD) * baryonCGSum[4] + baryonCGSum[5];
+  dMB[su1] = dMB[us1];
+  dMB[ss1] = probStoUD * baryonCGSum[2] + 2. * baryonCGSum[3];
+  for (int i = 1; i < 8; ++i) dMB[i] = dMB[i] / dMB[0];
+
+  // Tunneling factors for diquark production; only half a pair = sqrt.
+  double probStoUDroot    = sqrt(probStoUD);
+  double probSQtoQQroot   = sqrt(probSQtoQQ);
+  double probQQ1toQQ0root = sqrt(probQQ1toQQ0);
+  double qBB[8];
+  qBB[ud1] = probQQ1toQQ0root;
+  qBB[uu1] = probQQ1toQQ0root;
+  qBB[us0] = probSQtoQQroot;
+  qBB[su0] = probStoUDroot * probSQtoQQroot;
+  qBB[us1] = probQQ1toQQ0root * qBB[us0];
+  qBB[su1] = probQQ1toQQ0root * qBB[su0];
+  qBB[ss1] = probStoUDroot * pow2(probSQtoQQroot) * probQQ1toQQ0root;
+
+  // spin * (vertex factor) * (half-tunneling factor above).
+  double qBM[8];
+  qBM[ud1] = 3. * qBB[ud1];
+  qBM[uu1] = 6. * qBB[uu1];
+  qBM[us0] = probStoUD * qBB[us0];
+  qBM[su0] = qBB[su0];
+  qBM[us1] = probStoUD * 3. * qBB[us1];
+  qBM[su1] = 3. * qBB[su1];
+  qBM[ss1] = probStoUD * 6. * qBB[ss1];
+
+  // Combine above two into total diquark weight for q -> B Bbar.
+  for (int i = 1; i < 8; ++i) qBB[i] = qBB[i] * qBM[i];
+
+  // Suppression from having strange popcorn meson.
+  qBM[us0] *= popcornSmeson;
+  qBM[us1] *= popcornSmeson;
+  qBM[ss1] *= popcornSmeson;
+
+  // Suppression for a heavy quark of a diquark to fit into a baryon
+  // on the other side of popcorn meson: (0) s/u for q -> B M;
+  // (1) s/u for rank 0 diquark su -> M B; (2) ditto for s -> c/b.
+  double uNorm = 1. + qBM[ud1] + qBM[uu1] + qBM[us0] + qBM[us1];
+  scbBM[0] = (2. * (qBM[su0] + qBM[su1]) + qBM[ss1]) / uNorm;
+  scbBM[1] = scbBM[0] * popcornSpair * qBM[su0] / qBM[us0];
+  scbBM[2] = (1. + qBM[ud1]) * (2. + qBM[us0]) / uNorm;
+
+  // Include maximum of Clebsch-Gordan coefficients.
+  for (int i = 1; i < 8; ++i) dMB[i] *= qBM[i];
+  for (int i = 1; i < 8; ++i) qBM[i] *= barCGMax[i] / barCGMax[0];
+  for (int i = 1; i < 8; ++i) qBB[i] *= barCGMax[i] / barCGMax[0];
+
+  // Popcorn fraction for normal diquark production.
+  double qNorm = uNorm * popcornRate / 3.;
+  double sNorm = scbBM[0] * popcornSpair;
+  popFrac = qNorm * (1. + qBM[ud1] + qBM[uu1] + qBM[us0] + qBM[us1]
+    + sNorm * (qBM[su0] + qBM[su1] + 0.5 * qBM[ss1])) / (1. +  qBB[ud1]
+    + qBB[uu1] + 2. * (qBB[us0] + qBB[us1]) + 0.5 * qBB[ss1]);
+
+  // Popcorn fraction for rank 0 diquarks, depending on number of s quarks.
+  popS[0] = qNorm * qBM[ud1] / qBB[ud1];
+  popS[1] = qNorm * 0.5 * (qBM[us1] / qBB[us1]
+    + sNorm * qBM[su1] / qBB[su1]);
+  popS[2] = qNorm * sNorm * qBM[ss1] / qBB[ss1];
+
+  // Recombine diquark weights to flavour and spin ratios. Second index:
+  // 0 = s/u popcorn quark ratio.
+  // 1, 2 = s/u ratio for vertex quark if popcorn quark is u/d or s.
+  // 3 = q/q' vertex quark ratio if popcorn quark is light and = q.
+  // 4, 5, 6 = (spin 1)/(spin 0) ratio for su, us and ud.
+
+  // Case 0: q -> B B.
+  dWT[0][0] = (2. * (qBB[su0] + qBB[su1]) + qBB[ss1])
+    / (1. + qBB[ud1] + qBB[uu1] + qBB[us0] + qBB[us1]);
+  dWT[0][1] = 2. * (qBB[us0] + qBB[us1]) / (1. + qBB[ud1] + qBB[uu1]);
+  dWT[0][2] = qBB[ss1] / (qBB[su0] + qBB[su1]);
+  dWT[0][3] = qBB[uu1] / (1. + qBB[ud1] + qBB[uu1]);
+  dWT[0][4] = qBB[su1] / qBB[su0];
+  dWT[0][5] = qBB[us1] / qBB[us0];
+  dWT[0][6] = qBB[ud1];
+
+  // Case 1: q -> B M B.
+  dWT[1][0] = (2. * (qBM[su0] + qBM[su1]) + qBM[ss1])
+    / (1. + qBM[ud1] + qBM[uu1] + qBM[us0] + qBM[us1]);
+  dWT[1][1] = 2. * (qBM[us0] + qBM[us1]) / (1. + qBM[ud1] + qBM[uu1]);
+  dWT[1][2] = qBM[ss1] / (qBM[su0] + qBM[su1]);
+  dWT[1][3] = qBM[uu1] / (1. + qBM[ud1] + qBM[uu1]);
+  dWT[1][4] = qBM[su1] / qBM[su0];
+  dWT[1][5] = qBM[us1] / qBM[us0];
+  dWT[1][6] = qBM[ud1];
+
+  // Case 2: qq -> M B; diquark inside chain.
+  dWT[2][0] = (2. * (dMB[su0] + dMB[su1]) + dMB[ss1])
+    / (1. + dMB[ud1] + dMB[uu1] + dMB[us0] + dMB[us1]);
+  dWT[2][1] = 2. * (dMB[us0] + dMB[us1]) / (1. + dMB[ud1] + dMB[uu1]);
+  dWT[2][2] = dMB[ss1] / (dMB[su0] + dMB[su1]);
+  dWT[2][3] = dMB[uu1] / (1. + dMB[ud1] + dMB[uu1]);
+  dWT[2][4] = dMB[su1] / dMB[su0];
+  dWT[2][5] = dMB[us1] / dMB[us0];
+  dWT[2][6] = dMB[ud1];
+
+}
+
+//--------------------------------------------------------------------------
+
 // Pick a new flavour (including diquarks) given an incoming one for
 // Gaussian pTq^2 distribution.
 
@@ -1668,9 +1700,13 @@ pair<double, double> StringPT::pxyThermal(int idIn, double nNSP) {
 
 pair<double, double> StringPT::pxyGauss(int idIn, double nNSP) {
 
+  // The three random numbers needed, drawn in one go.
+  double rnd[3];
+  rndmPtr->flat( rnd, 3);
+
   // Normal (classical) width selection.
   double sigma = sigmaQ;
-  if (rndmPtr->flat() < enhancedFraction) sigma *= enhancedWidth;
+  if (rnd[0] < enhancedFraction) sigma *= enhancedWidth;
 
   // Prefactor for strange quarks and diquarks.
   if (useWidthPre) {
@@ -1685,7 +1721,7 @@ pair<double, double> StringPT::pxyGauss(int idIn, double nNSP) {
   }
 
   // Generate (p_x, p_y) pair.
-  pair<double, double> gauss2 = rndmPtr->gauss2();
+  pair<double, double> gauss2 = Rndm::gauss2( rnd[1], rnd[2]);
   return pair<double, double>(sigma * gauss2.first, sigma * gauss2.second);
 
 }
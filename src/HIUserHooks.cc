@@ -290,6 +290,8 @@ bool SubCollisionModel::init() {
   sigErr = settingsPtr->pvec("HeavyIon:SigFitErr");
   sigFuzz = settingsPtr->parm("HeavyIon:SigFitFuzz");
   fitPrint = settingsPtr->flag("HeavyIon:SigFitPrint");
+  reuseMode = settingsPtr->mode("HeavyIon:SigFitReuseInit");
+  cacheFile = settingsPtr->word("HeavyIon:SigFitInitFile");
   // preliminarily set average non-diffractive impact parameter as if
   // black disk.
   avNDb = 2.0*sqrt(sigTarg[1]/M_PI)*
@@ -316,6 +318,98 @@ double SubCollisionModel::Chi2(const SigEst & se, int npar) const {
 }
 
 
+//--------------------------------------------------------------------------
+
+// Calculate the Chi^2 for a given parameter set, temporarily using a
+// random number generator of its own for the numerical integration.
+
+double SubCollisionModel::fitChi2(const vector<double> & parms, int seed) {
+  Rndm rndm(seed);
+  Rndm * rndSave = rndPtr;
+  rndPtr = &rndm;
+  setParm(parms);
+  double chi2 = Chi2(getSig(), parms.size());
+  rndPtr = rndSave;
+  return chi2;
+}
+
+//--------------------------------------------------------------------------
+
+// Calculate the Chi^2 for all parameter sets in a population.
+
+void SubCollisionModel::evalPopulation(const vector< vector<double> > & pop,
+  const vector<int> & seeds, vector<double> & chi2s) {
+  chi2s.resize(pop.size());
+  for ( int i = 0, N = pop.size(); i < N; ++i )
+    chi2s[i] = fitChi2(pop[i], seeds[i]);
+}
+
+//--------------------------------------------------------------------------
+
+// The key identifying a fit in the cache file: the model name, the
+// number of parameters, the collision energy, and the target cross
+// sections with their assumed errors.
+
+string SubCollisionModel::fitCacheKey(int npar) const {
+  ostringstream os;
+  os << name() << " " << npar << scientific << setprecision(9) << " "
+     << 2.0 * sqrt(settingsPtr->parm("Beams:eA")
+                   * settingsPtr->parm("Beams:eB"));
+  for ( int i = 0, N = sigTarg.size(); i < N; ++i ) os << " " << sigTarg[i];
+  for ( int i = 0, N = sigErr.size(); i < N; ++i ) os << " " << sigErr[i];
+  return os.str();
+}
+
+//--------------------------------------------------------------------------
+
+// Look for previously fitted parameters in the cache file. Each line
+// contains a key followed by a colon and the fitted parameters.
+
+bool SubCollisionModel::readFitCache(vector<double> & parms) const {
+  ifstream is(cacheFile.c_str());
+  if ( !is.good() ) return false;
+  string key = fitCacheKey(parms.size());
+  string line;
+  while ( getline(is, line) ) {
+    size_t iColon = line.find(" : ");
+    if ( iColon == string::npos || line.substr(0, iColon) != key ) continue;
+    istringstream ps(line.substr(iColon + 3));
+    vector<double> found;
+    double p;
+    while ( ps >> p ) found.push_back(p);
+    if ( found.size() != parms.size() ) continue;
+    parms = found;
+    return true;
+  }
+  return false;
+}
+
+//--------------------------------------------------------------------------
+
+// Save fitted parameters in the cache file, replacing any earlier fit
+// with the same key.
+
+void SubCollisionModel::writeFitCache(const vector<double> & parms) const {
+  string key = fitCacheKey(parms.size());
+  vector<string> lines;
+  ifstream is(cacheFile.c_str());
+  string line;
+  while ( getline(is, line) )
+    if ( line.substr(0, line.find(" : ")) != key ) lines.push_back(line);
+  is.close();
+  ostringstream ps;
+  ps << key << " :" << setprecision(17);
+  for ( int j = 0, N = parms.size(); j < N; ++j ) ps << " " << parms[j];
+  lines.push_back(ps.str());
+  ofstream os(cacheFile.c_str());
+  if ( !os.good() ) {
+    infoPtr->errorMsg("Warning in SubCollisionModel::writeFitCache: "
+                      "could not write to file", cacheFile);
+    return;
+  }
+  for ( int i = 0, N = lines.size(); i < N; ++i ) os << lines[i] << "\n";
+}
+
 //--------------------------------------------------------------------------
 
 // Anonymous helper function to print out stuff.
@@ -375,22 +469,48 @@ bool SubCollisionModel::evolve() {
     def = settingsPtr->pvec("HI:SigFitDefPar");
   for ( int j = 0; j < dim; ++j )
     pop[0][j] = max(minp[j], min(def[j], maxp[j]));
+
+  // Parameters from an earlier fit with the same key replace the
+  // default ones, and no further fitting is done.
+  int nGen = NGen;
+  bool reused = false;
+  if ( reuseMode >= 2 ) {
+    if ( readFitCache(pop[0]) ) {
+      reused = true;
+      nGen = 0;
+    } else if ( reuseMode == 2 ) {
+      infoPtr->errorMsg("Error in SubCollisionModel::evolve: no fitted "
+                        "parameters found in file", cacheFile);
+      return false;
+    }
+  }
+  if ( fitPrint && reused )
+    cout << " |                                      "
+         << "                               | \n"
+         << " |   Reusing fitted parameters from file"
+         << "                               | \n";
+
   for ( int i = 1; i < NPop; ++i )
     for ( int j = 0; j < dim; ++j )
       pop[i][j] = minp[j] + rndPtr->flat()*(maxp[j] - minp[j]);
 
   // Now we evolve our population for a number of generations.
-  for ( int igen = 0; igen < NGen; ++igen ) {
-    // Calculate Chi2 for each parameter set and order them.
+  vector<int> seeds(NPop);
+  vector<double> chi2s(NPop);
+  for ( int igen = 0; igen < nGen; ++igen ) {
+    // Calculate Chi2 for each parameter set and order them. Each set
+    // has its own random number seed for the integration, so that
+    // they can be evaluated in parallel.
+    for ( int i = 0; i < NPop; ++i )
+      seeds[i] = 1 + int(rndPtr->flat()*(MAXSEED - 1));
+    evalPopulation(pop, seeds, chi2s);
     multimap<double, Parms> chi2map;
     double chi2max = 0.0;
     double chi2sum = 0.0;
     for ( int i = 0; i < NPop; ++i ) {
-      setParm(pop[i]);
-      double chi2 = Chi2(getSig(), dim);
-      chi2map.insert(make_pair(chi2, pop[i]));
-      chi2max = max(chi2max, chi2);
-      chi2sum += chi2;
+      chi2map.insert(make_pair(chi2s[i], pop[i]));
+      chi2max = max(chi2max, chi2s[i]);
+      chi2sum += chi2s[i];
     }
 
     // Keep the best one, and move the other closer to a better one or
@@ -432,6 +552,8 @@ bool SubCollisionModel::evolve() {
   setParm(pop[0]);
   SigEst se = getSig();
   double chi2 = Chi2(se, dim);
+  if ( nGen > 0 && ( reuseMode == 1 || reuseMode == 3 ) )
+    writeFitCache(pop[0]);
   avNDb = se.avNDb*settingsPtr->parm("Angantyr:impactFudge");
   if ( chi2 > 2.0 )
     infoPtr->errorMsg("HeavyIon Warning: Chi^2 in fitting sub-collision "
@@ -487,7 +609,7 @@ bool SubCollisionModel::evolve() {
     cout << " *--- End HeavyIon fitting of parameters in "
          << "nucleon collision model ---* "
          << endl << endl;
-    if ( NGen > 0 ) {
+    if ( nGen > 0 ) {
       cout << "HeavyIon Info: To avoid refitting, use the following settings "
            << "for next run:\n  HeavyIon:SigFitNGen = 0\n  "
            << "HeavyIon:SigFitDefPar = "
@@ -510,10 +632,10 @@ bool SubCollisionModel::evolve() {
 // distance. Should be called in overriding function in subclasses to
 // reset all Nucleon objects.
 
-multiset<SubCollision> SubCollisionModel::
+vector<SubCollision> SubCollisionModel::
 getCollisions(vector<Nucleon> & proj, vector<Nucleon> & targ,
               const Vec4 & bvec, double & T) {
-  multiset<SubCollision> ret;
+  vector<SubCollision> ret;
   T = 0.0;
   // Reset all states.
   for ( int i = 0, N = proj.size(); i < N; ++i ) {
@@ -529,6 +651,81 @@ getCollisions(vector<Nucleon> & proj, vector<Nucleon> & targ,
   return ret;
 }
 
+//--------------------------------------------------------------------------
+
+// Find all pairs of projectile and target nucleons closer than bMax in
+// impact parameter. The target nucleons are sorted into a grid with
+// cells no smaller than bMax, so that only the cells around each
+// projectile nucleon need to be searched.
+
+void SubCollisionModel::findPairs(const vector<Nucleon> & proj,
+  const vector<Nucleon> & targ, double bMax) {
+  nucleonPairs.clear();
+  int Np = proj.size();
+  int Nt = targ.size();
+  if ( Np == 0 || Nt == 0 || !( bMax > 0.0 ) ) return;
+
+  // Set up the grid to cover all target nucleons.
+  double xMin = targ[0].bPos().px();
+  double xMax = xMin;
+  double yMin = targ[0].bPos().py();
+  double yMax = yMin;
+  for ( int it = 1; it < Nt; ++it ) {
+    xMin = min(xMin, targ[it].bPos().px());
+    xMax = max(xMax, targ[it].bPos().px());
+    yMin = min(yMin, targ[it].bPos().py());
+    yMax = max(yMax, targ[it].bPos().py());
+  }
+  double dx = max(bMax, (xMax - xMin)/MAXGRID);
+  double dy = max(bMax, (yMax - yMin)/MAXGRID);
+  int nx = min(MAXGRID, int((xMax - xMin)/dx)) + 1;
+  int ny = min(MAXGRID, int((yMax - yMin)/dy)) + 1;
+
+  // Sort the target nucleons into the cells, keeping their order
+  // within each cell.
+  cellFirst.assign(nx*ny + 1, 0);
+  cellTarg.resize(Nt);
+  for ( int it = 0; it < Nt; ++it )
+    ++cellFirst[1 + min(nx - 1, int((targ[it].bPos().px() - xMin)/dx))*ny
+                + min(ny - 1, int((targ[it].bPos().py() - yMin)/dy))];
+  for ( int ic = 0; ic < nx*ny; ++ic ) cellFirst[ic + 1] += cellFirst[ic];
+  for ( int it = 0; it < Nt; ++it )
+    cellTarg[cellFirst[min(nx - 1, int((targ[it].bPos().px() - xMin)/dx))*ny
+                       + min(ny - 1, int((targ[it].bPos().py() - yMin)/dy))]++]
+      = it;
+  for ( int ic = nx*ny; ic > 0; --ic ) cellFirst[ic] = cellFirst[ic - 1];
+  cellFirst[0] = 0;
+
+  // Search the neighbouring cells of each projectile nucleon, with a
+  // small margin for rounding in the distance.
+  double bMax2 = pow2(bMax)*(1.0 + 1.0e-9);
+  vector<int> close;
+  for ( int ip = 0; ip < Np; ++ip ) {
+    double x = proj[ip].bPos().px();
+    double y = proj[ip].bPos().py();
+    double fx = floor((x - xMin)/dx);
+    double fy = floor((y - yMin)/dy);
+    if ( fx < -1.0 || fx > nx || fy < -1.0 || fy > ny ) continue;
+    int ix = int(fx);
+    int iy = int(fy);
+    close.clear();
+    for ( int jx = max(0, ix - 1), jxMax = min(nx - 1, ix + 1);
+          jx <= jxMax; ++jx )
+      for ( int jy = max(0, iy - 1), jyMax = min(ny - 1, iy + 1);
+            jy <= jyMax; ++jy )
+        for ( int ic = jx*ny + jy, k = cellFirst[ic];
+              k < cellFirst[ic + 1]; ++k ) {
+          const Vec4 & bt = targ[cellTarg[k]].bPos();
+          if ( pow2(x - bt.px()) + pow2(y - bt.py()) <= bMax2 )
+            close.push_back(cellTarg[k]);
+        }
+    sort(close.begin(), close.end());
+    for ( int k = 0, N = close.size(); k < N; ++k )
+      nucleonPairs.push_back(make_pair(ip, close[k]));
+  }
+
+}
+
 
 //==========================================================================
 
@@ -538,31 +735,34 @@ getCollisions(vector<Nucleon> & proj, vector<Nucleon> & targ,
 
 //--------------------------------------------------------------------------
 
-multiset<SubCollision> BlackSubCollisionModel::
+vector<SubCollision> BlackSubCollisionModel::
 getCollisions(vector<Nucleon> & proj, vector<Nucleon> & targ,
               const Vec4 & bvec, double & T) {
   // Always call base class to reset nucleons and shift them into
   // position.
-  multiset<SubCollision> ret =
+  vector<SubCollision> ret =
     SubCollisionModel::getCollisions(proj, targ, bvec, T);
 
   T = 0.0;
-  // Go through all pairs of nucleons
-  for ( int ip = 0, Np = proj.size(); ip < Np; ++ip )
-    for ( int it = 0, Nt = targ.size(); it < Nt; ++it ) {
-      Nucleon & p = proj[ip];
-      Nucleon & t = targ[it];
-      double b = (p.bPos() - t.bPos()).pT();
-      if ( b > sqrt(sigTot()/M_PI) ) continue;
-      T = 0.5; // The naive cross section only gets the total xsec correct.
-      if ( b < sqrt((sigTot() - sigEl())/M_PI) ) {
-        ret.insert(SubCollision(p, t, b, b/avNDb, SubCollision::ABS));
-      }
-      else {
-        ret.insert(SubCollision(p, t, b, b/avNDb, SubCollision::ELASTIC));
-      }
+  // Go through all pairs of nucleons close enough to interact.
+  findPairs(proj, targ, sqrt(sigTot()/M_PI));
+  ret.reserve(nucleonPairs.size());
+  for ( int i = 0, N = nucleonPairs.size(); i < N; ++i ) {
+    Nucleon & p = proj[nucleonPairs[i].first];
+    Nucleon & t = targ[nucleonPairs[i].second];
+    double b = (p.bPos() - t.bPos()).pT();
+    if ( b > sqrt(sigTot()/M_PI) ) continue;
+    T = 0.5; // The naive cross section only gets the total xsec correct.
+    if ( b < sqrt((sigTot() - sigEl())/M_PI) ) {
+      ret.push_back(SubCollision(p, t, b, b/avNDb, SubCollision::ABS));
     }
+    else {
+      ret.push_back(SubCollision(p, t, b, b/avNDb, SubCollision::ELASTIC));
+    }
+  }
 
+  // Order the sub-collisions in impact parameter.
+  stable_sort(ret.begin(), ret.end());
   return ret;
 }
 
@@ -576,44 +776,47 @@ getCollisions(vector<Nucleon> & proj, vector<Nucleon> & targ,
 
 //--------------------------------------------------------------------------
 
-multiset<SubCollision> NaiveSubCollisionModel::
+vector<SubCollision> NaiveSubCollisionModel::
 getCollisions(vector<Nucleon> & proj, vector<Nucleon> & targ,
               const Vec4 & bvec, double & T) {
   // Always call base class to reset nucleons and shift them into
   // position.
-  multiset<SubCollision> ret =
+  vector<SubCollision> ret =
     SubCollisionModel::getCollisions(proj, targ, bvec, T);
 
   T = 0.0;
-  // Go through all pairs of nucleons
-  for ( int ip = 0, Np = proj.size(); ip < Np; ++ip )
-    for ( int it = 0, Nt = targ.size(); it < Nt; ++it ) {
-      Nucleon & p = proj[ip];
-      Nucleon & t = targ[it];
-      double b = (p.bPos() - t.bPos()).pT();
-      if ( b > sqrt(sigTot()/M_PI) ) continue;
-      T = 0.5; // The naive cross section only gets the total xsec correct.
-      if ( b < sqrt(sigND()/M_PI) ) {
-        ret.insert(SubCollision(p, t, b, b/avNDb, SubCollision::ABS));
-      }
-      else if ( b < sqrt((sigND() + sigDDE())/M_PI) ) {
-        ret.insert(SubCollision(p, t, b, b/avNDb, SubCollision::DDE));
-      }
-      else if ( b < sqrt((sigND() + sigSDE() + sigDDE())/M_PI) ) {
-         if ( sigSDEP() > rndPtr->flat()*sigSDE() ) {
-          ret.insert(SubCollision(p, t, b, b/avNDb, SubCollision::SDEP));
-        } else {
-          ret.insert(SubCollision(p, t, b, b/avNDb, SubCollision::SDET));
-        }
-      }
-      else if ( b < sqrt((sigND() + sigSDE() + sigDDE() + sigCDE())/M_PI) ) {
-        ret.insert(SubCollision(p, t, b, b/avNDb, SubCollision::CDE));
-      }
-      else {
-        ret.insert(SubCollision(p, t, b, b/avNDb, SubCollision::ELASTIC));
+  // Go through all pairs of nucleons close enough to interact.
+  findPairs(proj, targ, sqrt(sigTot()/M_PI));
+  ret.reserve(nucleonPairs.size());
+  for ( int i = 0, N = nucleonPairs.size(); i < N; ++i ) {
+    Nucleon & p = proj[nucleonPairs[i].first];
+    Nucleon & t = targ[nucleonPairs[i].second];
+    double b = (p.bPos() - t.bPos()).pT();
+    if ( b > sqrt(sigTot()/M_PI) ) continue;
+    T = 0.5; // The naive cross section only gets the total xsec correct.
+    if ( b < sqrt(sigND()/M_PI) ) {
+      ret.push_back(SubCollision(p, t, b, b/avNDb, SubCollision::ABS));
+    }
+    else if ( b < sqrt((sigND() + sigDDE())/M_PI) ) {
+      ret.push_back(SubCollision(p, t, b, b/avNDb, SubCollision::DDE));
+    }
+    else if ( b < sqrt((sigND() + sigSDE() + sigDDE())/M_PI) ) {
+       if ( sigSDEP() > rndPtr->flat()*sigSDE() ) {
+        ret.push_back(SubCollision(p, t, b, b/avNDb, SubCollision::SDEP));
+      } else {
+        ret.push_back(SubCollision(p, t, b, b/avNDb, SubCollision::SDET));
       }
     }
+    else if ( b < sqrt((sigND() + sigSDE() + sigDDE() + sigCDE())/M_PI) ) {
+      ret.push_back(SubCollision(p, t, b, b/avNDb, SubCollision::CDE));
+    }
+    else {
+      ret.push_back(SubCollision(p, t, b, b/avNDb, SubCollision::ELASTIC));
+    }
+  }
 
+  // Order the sub-collisions in impact parameter.
+  stable_sort(ret.begin(), ret.end());
   return ret;
 }
 
@@ -848,12 +1051,12 @@ void DoubleStrikman::shuffel(double & PEL11, double P11,
 
 // Main function returning the possible sub-collisions.
 
-multiset<SubCollision> DoubleStrikman::
+vector<SubCollision> DoubleStrikman::
 getCollisions(vector<Nucleon> & proj, vector<Nucleon> & targ,
               const Vec4 & bvec, double & T) {
   // Always call base class to reset nucleons and shift them into
   // position.
-  multiset<SubCollision> ret =
+  vector<SubCollision> ret =
     SubCollisionModel::getCollisions(proj, targ, bvec, T);
 
   /// Assign two states to each nucleon
@@ -866,88 +1069,114 @@ getCollisions(vector<Nucleon> & proj, vector<Nucleon> & targ,
     targ[it].addAltState(Nucleon::State(1, gamma()));
   }
 
+  // The largest distance where a pair can interact, for each
+  // projectile nucleon and overall. The interaction range,
+  // sigma/opacity, has no maximum inside an interval of sigma, so it
+  // is enough to check the smallest and largest sum of radii.
+  double rtMin = targ.empty()? 0.0: targ[0].state()[0];
+  double rtMax = rtMin;
+  for ( int it = 0, Nt = targ.size(); it < Nt; ++it ) {
+    rtMin = min(rtMin, min(targ[it].state()[0], targ[it].altState()[0]));
+    rtMax = max(rtMax, max(targ[it].state()[0], targ[it].altState()[0]));
+  }
+  vector<double> bMaxProj(proj.size());
+  double bMax = 0.0;
+  for ( int ip = 0, Np = proj.size(); ip < Np; ++ip ) {
+    double sigMin = M_PI*pow2(rtMin +
+      min(proj[ip].state()[0], proj[ip].altState()[0]));
+    double sigMax = M_PI*pow2(rtMax +
+      max(proj[ip].state()[0], proj[ip].altState()[0]));
+    bMaxProj[ip] = sqrt(max(sigMin/opacity(sigMin), sigMax/opacity(sigMax))
+                        /(2.0*M_PI))*(1.0 + 1.0e-9);
+    bMax = max(bMax, bMaxProj[ip]);
+  }
+
   // The factorising S-matrix.
   double S = 1.0;
 
-  // Go through all pairs of nucleons
-  for ( int ip = 0, Np = proj.size(); ip < Np; ++ip )
-    for ( int it = 0, Nt = targ.size(); it < Nt; ++it ) {
-      Nucleon & p = proj[ip];
-      Nucleon & t = targ[it];
-      double b = (p.bPos() - t.bPos()).pT();
-
-      double T11 = Tpt(p.state(), t.state(), b);
-      double T12 = Tpt(p.state(), t.altState(), b);
-      double T21 = Tpt(p.altState(), t.state(), b);
-      double T22 = Tpt(p.altState(), t.altState(), b);
-      double S11 = 1.0 - T11;
-      double S12 = 1.0 - T12;
-      double S21 = 1.0 - T21;
-      double S22 = 1.0 - T22;
-      S *= S11;
-      double PND11 = 1.0 - pow2(S11);
-      // First and most important, check if this is an absorptive
-      // scattering.
-      if ( PND11 > rndPtr->flat() ) {
-        ret.insert(SubCollision(p, t, b, b/avNDb, SubCollision::ABS));
-        continue;
-      }
-
-      // Now set up calculation for probability of diffractively
-      // wounded nucleons.
-      double PND12 = 1.0 - pow2(S12);
-      double PND21 = 1.0 - pow2(S21);
-      double PWp11 = 1.0 - S11*S21;
-      double PWp21 = 1.0 - S11*S21;
-      shuffle(PND11, PND21, PWp11, PWp21);
-      double PWt11 = 1.0 - S11*S12;
-      double PWt12 = 1.0 - S11*S12;
-      shuffle(PND11, PND12, PWt11, PWt12);
-
-      bool wt = ( PWt11 - PND11 > (1.0 - PND11)*rndPtr->flat() );
-      bool wp = ( PWp11 - PND11 > (1.0 - PND11)*rndPtr->flat() );
-      if ( wt && wp ) {
-        ret.insert(SubCollision(p, t, b, b/avNDb, SubCollision::DDE));
-        continue;
-      }
-      if ( wt ) {
-        ret.insert(SubCollision(p, t, b, b/avNDb, SubCollision::SDET));
-        continue;
-      }
-      if ( wp ) {
-        ret.insert(SubCollision(p, t, b, b/avNDb, SubCollision::SDEP));
-        continue;
-      }
+  // Go through all pairs of nucleons close enough to interact. The
+  // others have S = 1.
+  findPairs(proj, targ, bMax);
+  ret.reserve(nucleonPairs.size());
+  for ( int i = 0, N = nucleonPairs.size(); i < N; ++i ) {
+    Nucleon & p = proj[nucleonPairs[i].first];
+    Nucleon & t = targ[nucleonPairs[i].second];
+    double b = (p.bPos() - t.bPos()).pT();
+    if ( b > bMaxProj[nucleonPairs[i].first] ) continue;
+
+    double T11 = Tpt(p.state(), t.state(), b);
+    double T12 = Tpt(p.state(), t.altState(), b);
+    double T21 = Tpt(p.altState(), t.state(), b);
+    double T22 = Tpt(p.altState(), t.altState(), b);
+    double S11 = 1.0 - T11;
+    double S12 = 1.0 - T12;
+    double S21 = 1.0 - T21;
+    double S22 = 1.0 - T22;
+    S *= S11;
+    double PND11 = 1.0 - pow2(S11);
+    // First and most important, check if this is an absorptive
+    // scattering.
+    if ( PND11 > rndPtr->flat() ) {
+      ret.push_back(SubCollision(p, t, b, b/avNDb, SubCollision::ABS));
+      continue;
+    }
 
-      // Finally set up calculation for elastic scattering. This can
-      // never be exact, but let's do as well as we can.
-
-      double PND22 = 1.0 - pow2(S22);
-      double PWp12 = 1.0 - S12*S22;
-      double PWp22 = 1.0 - S12*S22;
-      shuffle(PND12, PND22, PWp12, PWp22);
-      double PWt21 = 1.0 - S21*S22;
-      double PWt22 = 1.0 - S21*S22;
-      shuffle(PND21, PND22, PWt21, PWt22);
-
-      double PNW11 = PNW(PWp11, PWt11, PND11);
-      double PNW12 = PNW(PWp12, PWt12, PND12);
-      double PNW21 = PNW(PWp21, PWt21, PND21);
-      double PNW22 = PNW(PWp22, PWt22, PND22);
-
-      double PEL = (T12*T21 + T11*T22)/2.0;
-      shuffel(PEL, PNW11, PNW12, PNW21, PNW22);
-      if ( PEL > PNW11*rndPtr->flat() ) {
-        if ( sigCDE() > rndPtr->flat()*(sigCDE() + sigEl()) )
-          ret.insert(SubCollision(p, t, b, b/avNDb, SubCollision::CDE));
-        else
-          ret.insert(SubCollision(p, t, b, b/avNDb, SubCollision::ELASTIC));
-      }
+    // Now set up calculation for probability of diffractively
+    // wounded nucleons.
+    double PND12 = 1.0 - pow2(S12);
+    double PND21 = 1.0 - pow2(S21);
+    double PWp11 = 1.0 - S11*S21;
+    double PWp21 = 1.0 - S11*S21;
+    shuffle(PND11, PND21, PWp11, PWp21);
+    double PWt11 = 1.0 - S11*S12;
+    double PWt12 = 1.0 - S11*S12;
+    shuffle(PND11, PND12, PWt11, PWt12);
+
+    bool wt = ( PWt11 - PND11 > (1.0 - PND11)*rndPtr->flat() );
+    bool wp = ( PWp11 - PND11 > (1.0 - PND11)*rndPtr->flat() );
+    if ( wt && wp ) {
+      ret.push_back(SubCollision(p, t, b, b/avNDb, SubCollision::DDE));
+      continue;
+    }
+    if ( wt ) {
+      ret.push_back(SubCollision(p, t, b, b/avNDb, SubCollision::SDET));
+      continue;
+    }
+    if ( wp ) {
+      ret.push_back(SubCollision(p, t, b, b/avNDb, SubCollision::SDEP));
+      continue;
     }
 
+    // Finally set up calculation for elastic scattering. This can
+    // never be exact, but let's do as well as we can.
+
+    double PND22 = 1.0 - pow2(S22);
+    double PWp12 = 1.0 - S12*S22;
+    double PWp22 = 1.0 - S12*S22;
+    shuffle(PND12, PND22, PWp12, PWp22);
+    double PWt21 = 1.0 - S21*S22;
+    double PWt22 = 1.0 - S21*S22;
+    shuffle(PND21, PND22, PWt21, PWt22);
+
+    double PNW11 = PNW(PWp11, PWt11, PND11);
+    double PNW12 = PNW(PWp12, PWt12, PND12);
+    double PNW21 = PNW(PWp21, PWt21, PND21);
+    double PNW22 = PNW(PWp22, PWt22, PND22);
+
+    double PEL = (T12*T21 + T11*T22)/2.0;
+    shuffel(PEL, PNW11, PNW12, PNW21, PNW22);
+    if ( PEL > PNW11*rndPtr->flat() ) {
+      if ( sigCDE() > rndPtr->flat()*(sigCDE() + sigEl()) )
+        ret.push_back(SubCollision(p, t, b, b/avNDb, SubCollision::CDE));
+      else
+        ret.push_back(SubCollision(p, t, b, b/avNDb, SubCollision::ELASTIC));
+    }
+  }
 
   T = 1.0 - S;
 
+  // Order the sub-collisions in impact parameter.
+  stable_sort(ret.begin(), ret.end());
   return ret;
 }
 
@@ -1083,12 +1312,12 @@ int MultiRadial::choose() const {
 
 // Main function returning the possible sub-collisions.
 
-multiset<SubCollision> MultiRadial::
+vector<SubCollision> MultiRadial::
 getCollisions(vector<Nucleon> & proj, vector<Nucleon> & targ,
               const Vec4 & bvec, double & T) {
   // Always call base class to reset nucleons and shift them into
   // position.
-  multiset<SubCollision> ret =
+  vector<SubCollision> ret =
     SubCollisionModel::getCollisions(proj, targ, bvec, T);
 
   return ret;
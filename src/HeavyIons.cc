@@ -272,8 +272,9 @@ bool HeavyIons::isHeavyIon(Settings & settings) {
 // Constructor.
 
 Angantyr::Angantyr(Pythia & mainPythiaIn)
-  : HeavyIons(mainPythiaIn), hasSignal(true),
-    bGenPtr(0), projPtr(0), targPtr(0), collPtr(0), recoilerMode(1), bMode(0) {
+  : HeavyIons(mainPythiaIn), hasMBIASHooks(false), hasSignal(true),
+    bGenPtr(0), projPtr(0), targPtr(0), collPtr(0), recoilerMode(1), bMode(0),
+    seedSubEvents(false), seedBase(0) {
   pythia.resize(ALL);
   pythiaNames.resize(ALL);
   pythiaNames[HADRON] = "HADRON";
@@ -292,6 +293,10 @@ Angantyr::Angantyr(Pythia & mainPythiaIn)
 
 Angantyr::~Angantyr() {
   for ( int i = MBIAS; i < ALL; ++i ) if ( pythia[i] ) delete pythia[i];
+  for ( int i = 0, N = workerPtrs.size(); i < N; ++i ) {
+    delete workerPtrs[i];
+    delete workerSelectPtrs[i];
+  }
   if ( !( HIHooksPtr && HIHooksPtr->hasImpactParameterGenerator() ) )
     delete bGenPtr;
   if ( !( HIHooksPtr && HIHooksPtr->hasProjectileModel() ) )
@@ -304,28 +309,49 @@ Angantyr::~Angantyr() {
 
 //--------------------------------------------------------------------------
 
-// Add a HIUserHooks object to customise the Angantyr model.
+// Add a HIUserHooks object to customise the Angantyr model. UserHooks
+// for the MBIAS object are not shared with any additional workers,
+// which are then left unused.
 
 bool Angantyr::setUserHooksPtr(PythiaObject sel, UserHooks * uhook) {
   for ( int i = HADRON; i < ALL; ++i )
     if ( ( i == sel || ALL == sel ) && !pythia[i]->setUserHooksPtr(uhook) )
       return false;
+  if ( uhook && ( sel == MBIAS || sel == ALL ) ) {
+    if ( !hasMBIASHooks && !workerPtrs.empty() )
+      mainPythiaPtr->info.errorMsg("Warning in Angantyr::setUserHooksPtr: "
+        "UserHooks are not passed to the workers; minimum bias sub-events "
+        "will be generated sequentially.");
+    hasMBIASHooks = true;
+  }
   return true;
 }
 
 //--------------------------------------------------------------------------
 
+// Print out statistics. Messages from additional workers are counted
+// as coming from the MBIAS object.
+
+void Angantyr::stat() {
+  if ( mainPythiaPtr->flag("Stat:showErrors") )
+    for ( int i = 0, N = workerPtrs.size(); i < N; ++i )
+      sumUpMessages(mainPythiaPtr->info, "(" + pythiaNames[MBIAS] + ")",
+                    workerPtrs[i]->info);
+  HeavyIons::stat();
+}
+
+//--------------------------------------------------------------------------
+
 // Create an EventInfo object connected to a SubCollision from the
 // last event generated by the given PythiaObject.
 
-EventInfo Angantyr::mkEventInfo(Pythia & pyt, const SubCollision * coll) {
+EventInfo Angantyr::mkEventInfo(Pythia & pyt, const SubCollision * coll,
+                               bool doOrdering) {
     EventInfo ei;
     ei.coll = coll;
     ei.event = pyt.event;
     ei.info = pyt.info;
-    ei.ordering = ( ( HIHooksPtr && HIHooksPtr->hasEventOrdering() )?
-                    HIHooksPtr->eventOrdering(ei.event, ei.info):
-                    ei.info.bMPI() );
+    if ( doOrdering ) setEventOrdering(ei);
     if ( coll ) {
       ei.projs[coll->proj] = make_pair(1, ei.event.size());
       ei.targs[coll->targ] = make_pair(2, ei.event.size());
@@ -337,6 +363,29 @@ EventInfo Angantyr::mkEventInfo(Pythia & pyt, const SubCollision * coll) {
 
 //--------------------------------------------------------------------------
 
+// Set the ordering of an EventInfo object. HIUserHooks::eventOrdering
+// is only called from one thread at a time.
+
+void Angantyr::setEventOrdering(EventInfo & ei) {
+  ei.ordering = ( ( HIHooksPtr && HIHooksPtr->hasEventOrdering() )?
+                  HIHooksPtr->eventOrdering(ei.event, ei.info):
+                  ei.info.bMPI() );
+}
+
+//--------------------------------------------------------------------------
+
+// Create the internal SubCollisionModel selected by
+// Angantyr:CollisionModel.
+
+SubCollisionModel * Angantyr::newSubCollisionModel(int model) {
+  if ( model == 1 ) return new DoubleStrikman();
+  if ( model == 2 ) return new DoubleStrikman(1);
+  if ( model == 3 ) return new BlackSubCollisionModel();
+  return new NaiveSubCollisionModel();
+}
+
+//--------------------------------------------------------------------------
+
 // Initialise Angantyr. Called from within Pythia::init().
 
 bool Angantyr::init() {
@@ -371,6 +420,7 @@ bool Angantyr::init() {
 
   recoilerMode = settings.mode("Angantyr:SDRecoil");
   bMode = settings.mode("Angantyr:impactMode");
+  seedSubEvents = settings.flag("Angantyr:seedSubEvents");
 
   int frame = settings.mode("Beams:frameType");
   bool dohad = settings.flag("HadronLevel:all");
@@ -493,14 +543,8 @@ bool Angantyr::init() {
 
   if ( HIHooksPtr && HIHooksPtr->hasSubCollisionModel() )
     collPtr = HIHooksPtr->subCollisionModel();
-  else if ( settings.mode("Angantyr:CollisionModel") == 1 )
-    collPtr = new DoubleStrikman();
-  else if ( settings.mode("Angantyr:CollisionModel") == 2 )
-    collPtr = new DoubleStrikman(1);
-  else if ( settings.mode("Angantyr:CollisionModel") == 3 )
-    collPtr = new BlackSubCollisionModel();
   else
-    collPtr = new NaiveSubCollisionModel();
+    collPtr = newSubCollisionModel(settings.mode("Angantyr:CollisionModel"));
 
   collPtr->initPtr(*projPtr, *targPtr, sigtot, settings,
                    info, mainPythiaPtr->rndm);
@@ -609,16 +653,9 @@ EventInfo Angantyr::getSignal(const SubCollision & coll) {
 }
 
 EventInfo Angantyr::getMBIAS(const SubCollision * coll, int procid) {
-  int itry = MAXTRY;
-  double bp = -1.0;
-  if ( bMode > 0 && procid == 101 ) bp = coll->bp;
-  HoldProcess hold(selectMB, procid, bp);
-  while ( --itry ) {
-    if ( !pythia[MBIAS]->next() ) continue;
-    assert( pythia[MBIAS]->info.code() == procid );
-    return mkEventInfo(*pythia[MBIAS], coll);
-  }
-  return EventInfo();
+  SubEventTask task(coll, procid);
+  if ( genSubEvent(0, task) ) setEventOrdering(task.result);
+  return task.result;
 }
 
 EventInfo Angantyr::getSASD(const SubCollision * coll, int procid) {
@@ -636,29 +673,103 @@ EventInfo Angantyr::getSASD(const SubCollision * coll, int procid) {
 
 //--------------------------------------------------------------------------
 
+// Generate a minimum bias sub-event with the given worker, optionally
+// restarting its random number generator with the seed of the task.
+// The event ordering is set afterwards, outside of any threads.
+
+bool Angantyr::genSubEvent(int iWorker, SubEventTask & task) {
+  Pythia & pyt = ( iWorker > 0? *workerPtrs[iWorker - 1]: *pythia[MBIAS] );
+  ProcessSelectorHook & select =
+    ( iWorker > 0? *workerSelectPtrs[iWorker - 1]: selectMB );
+  if ( task.seed > 0 ) pyt.rndm.init(task.seed);
+  int itry = MAXTRY;
+  double bp = -1.0;
+  if ( bMode > 0 && task.proc == 101 ) bp = task.coll->bp;
+  HoldProcess hold(select, task.proc, bp);
+  while ( --itry ) {
+    if ( !pyt.next() ) continue;
+    assert( pyt.info.code() == task.proc );
+    task.result = mkEventInfo(pyt, task.coll, false);
+    return true;
+  }
+  task.result = EventInfo();
+  return false;
+}
+
+//--------------------------------------------------------------------------
+
+// Generate independent sub-events one after the other with the MBIAS
+// object.
+
+void Angantyr::runSubEventTasks(vector<SubEventTask> & tasks) {
+  for ( int i = 0, N = tasks.size(); i < N; ++i ) genSubEvent(0, tasks[i]);
+}
+
+//--------------------------------------------------------------------------
+
+// Add workers as copies of the MBIAS object, each with its own
+// process selector. Their initialization output is suppressed.
+
+bool Angantyr::addWorkers(int nAdd) {
+  if ( hasMBIASHooks && nAdd > 0 ) {
+    mainPythiaPtr->info.errorMsg("Warning in Angantyr::addWorkers: "
+      "UserHooks are not passed to the workers; minimum bias sub-events "
+      "will be generated sequentially.");
+    return true;
+  }
+  for ( int i = 0; i < nAdd; ++i ) {
+    Pythia * pyt = new Pythia(pythia[MBIAS]->settings,
+                              pythia[MBIAS]->particleData, false);
+    ProcessSelectorHook * select = new ProcessSelectorHook();
+    workerPtrs.push_back(pyt);
+    workerSelectPtrs.push_back(select);
+    pyt->addUserHooksPtr(select);
+    ostringstream oss;
+    Redirect red(cout, oss);
+    if ( !pyt->init() ) {
+      mainPythiaPtr->info.errorMsg("Error in Angantyr::addWorkers: "
+                                   "could not initialize worker.");
+      return false;
+    }
+  }
+  return true;
+}
+
+//--------------------------------------------------------------------------
+
+// The random number seed for a given sub-event task, obtained by
+// hashing the base seed of the current event with the task index.
+
+int Angantyr::subEventSeed(int iTask) const {
+  unsigned int h = seedBase ^ ( 0x9e3779b9u * (unsigned int)(iTask + 1) );
+  h ^= h >> 16;
+  h *= 0x85ebca6bu;
+  h ^= h >> 13;
+  h *= 0xc2b2ae35u;
+  h ^= h >> 16;
+  return 1 + int( h % (unsigned int)(MAXSEED) );
+}
+
+//--------------------------------------------------------------------------
+
 // Generate primary absorptive (non-diffractive) nucleon-nucleon
 // sub-collisions.
 
-bool Angantyr::genAbs(const multiset<SubCollision> & coll,
+bool Angantyr::genAbs(const vector<SubCollision> & coll,
                     list<EventInfo> & subevents) {
   // The fully absorptive
-  vector<multiset<SubCollision>::const_iterator> abscoll;
+  vector<vector<SubCollision>::const_iterator> abscoll;
    // The partly absorptive
-  vector<multiset<SubCollision>::const_iterator> abspart;
+  vector<vector<SubCollision>::const_iterator> abspart;
   // The non-diffractive and signal events
   multiset<EventInfo> ndeve, sigeve;
 
   // Select the primary absorptive sub collisions.
-  for ( multiset<SubCollision>::iterator cit = coll.begin();
+  for ( vector<SubCollision>::const_iterator cit = coll.begin();
         cit != coll.end(); ++cit ) {
     if ( cit->type != SubCollision::ABS ) continue;
     if (!cit->proj->done() && !cit->targ->done() ) {
       abscoll.push_back(cit);
-      if ( bMode > 0 ) {
-        EventInfo ie = getND(*cit);
-        assert( ie.info.code() == 101 );
-        ndeve.insert(ie);
-      }
       cit->proj->select();
       cit->targ->select();
     } else
@@ -670,12 +781,28 @@ bool Angantyr::genAbs(const multiset<SubCollision> & coll,
   int Nabs = abscoll.size();
   int Nadd = abspart.size();
 
-  if ( bMode == 0 ) {
-    for ( int i = 0; i < Nabs + Nadd; ++i ) {
-      EventInfo ie = getND();
-      assert( ie.info.code() == 101 );
-      ndeve.insert(ie);
-    }
+  // The non-diffractive events are independent of each other and are
+  // generated together, one for each primary sub-collision if the
+  // impact parameter is set, otherwise one for each potential one.
+  vector<SubEventTask> tasks;
+  if ( bMode > 0 ) {
+    for ( int i = 0; i < Nabs; ++i )
+      tasks.push_back(SubEventTask(&*abscoll[i], 101));
+  } else
+    tasks.resize(Nabs + Nadd, SubEventTask(0, 101));
+  if ( seedSubEvents )
+    for ( int i = 0, N = tasks.size(); i < N; ++i )
+      tasks[i].seed = subEventSeed(i);
+  runSubEventTasks(tasks);
+
+  // The MBIAS object is restarted so that its later use does not
+  // depend on which of the tasks it happened to generate.
+  if ( seedSubEvents )
+    pythia[MBIAS]->rndm.init(subEventSeed(tasks.size()));
+  for ( int i = 0, N = tasks.size(); i < N; ++i ) {
+    assert( tasks[i].result.info.code() == 101 );
+    setEventOrdering(tasks[i].result);
+    ndeve.insert(tasks[i].result);
   }
   vector<int> Nii(4, 0);
   vector<double> w(4, 0.0);
@@ -740,13 +867,13 @@ bool Angantyr::genAbs(const multiset<SubCollision> & coll,
 
 // Add secondary absorptive sub-collisions to the primary ones.
 
-void Angantyr::addSASD(const multiset<SubCollision> & coll) {
+void Angantyr::addSASD(const vector<SubCollision> & coll) {
   // Collect absorptively wounded nucleons in secondary
   // sub-collisions.
   int ntry = mainPythiaPtr->mode("Angantyr:SDTries");
   if ( mainPythiaPtr->settings.isMode("HI:SDTries") )
     ntry = mainPythiaPtr->mode("HI:SDTries");
-  for ( multiset<SubCollision>::iterator cit = coll.begin();
+  for ( vector<SubCollision>::const_iterator cit = coll.begin();
         cit != coll.end(); ++cit )
     if ( cit->type == SubCollision::ABS ) {
       if ( cit->targ->done() && !cit->proj->done() ) {
@@ -777,10 +904,10 @@ void Angantyr::addSASD(const multiset<SubCollision> & coll) {
 
 // Add primary double diffraction sub-collisions.
 
-bool Angantyr::addDD(const multiset<SubCollision> & coll,
+bool Angantyr::addDD(const vector<SubCollision> & coll,
                    list<EventInfo> & subevents) {
   // Collect full double diffraction collisions.
-  for ( multiset<SubCollision>::iterator cit = coll.begin();
+  for ( vector<SubCollision>::const_iterator cit = coll.begin();
         cit != coll.end(); ++cit )
     if ( cit->type == SubCollision::DDE &&
          !cit->proj->done() && !cit->targ->done() ) {
@@ -796,10 +923,10 @@ bool Angantyr::addDD(const multiset<SubCollision> & coll,
 
 // Add primary single diffraction sub-collisions.
 
-bool Angantyr::addSD(const multiset<SubCollision> & coll,
+bool Angantyr::addSD(const vector<SubCollision> & coll,
                    list<EventInfo> & subevents) {
   // Collect full single diffraction collisions.
-  for ( multiset<SubCollision>::iterator cit = coll.begin();
+  for ( vector<SubCollision>::const_iterator cit = coll.begin();
         cit != coll.end(); ++cit )
     if ( !cit->proj->done() && !cit->targ->done() ) {
       if ( cit->type == SubCollision::SDEP ) {
@@ -823,12 +950,12 @@ bool Angantyr::addSD(const multiset<SubCollision> & coll,
 // Add all secondary single diffractive sub-collisions to primary
 // ones.
 
-void Angantyr::addSDsecond(const multiset<SubCollision> & coll) {
+void Angantyr::addSDsecond(const vector<SubCollision> & coll) {
   // Collect secondary single diffractive sub-collisions.
   int ntry = mainPythiaPtr->mode("Angantyr:SDTries");
   if ( mainPythiaPtr->settings.isMode("HI:SDTries") )
     ntry = mainPythiaPtr->mode("HI:SDTries");
-  for ( multiset<SubCollision>::iterator cit = coll.begin();
+  for ( vector<SubCollision>::const_iterator cit = coll.begin();
         cit != coll.end(); ++cit ) {
     if ( !cit->proj->done() &&
          ( cit->type == SubCollision::SDEP ||
@@ -863,10 +990,10 @@ void Angantyr::addSDsecond(const multiset<SubCollision> & coll) {
 
 // Add all primary central diffraction sub-colliions
 
-bool Angantyr::addCD(const multiset<SubCollision> & coll,
+bool Angantyr::addCD(const vector<SubCollision> & coll,
                    list<EventInfo> & subevents) {
   // Collect full central diffraction collisions.
-  for ( multiset<SubCollision>::iterator cit = coll.begin();
+  for ( vector<SubCollision>::const_iterator cit = coll.begin();
         cit != coll.end(); ++cit )
     if ( cit->type == SubCollision::CDE &&
          !cit->proj->done() && !cit->targ->done() ) {
@@ -883,9 +1010,9 @@ bool Angantyr::addCD(const multiset<SubCollision> & coll,
 // Add all secondary central diffraction sub-colliions to primary
 // ones.
 
-void Angantyr::addCDsecond(const multiset<SubCollision> & coll) {
+void Angantyr::addCDsecond(const vector<SubCollision> & coll) {
   // Collect secondary central diffractive sub-collisions.
-  for ( multiset<SubCollision>::iterator cit = coll.begin();
+  for ( vector<SubCollision>::const_iterator cit = coll.begin();
         cit != coll.end(); ++cit ) {
     if ( !cit->proj->done() && cit->type == SubCollision::CDE ) {
       EventInfo * evp = cit->targ->event();
@@ -908,10 +1035,10 @@ void Angantyr::addCDsecond(const multiset<SubCollision> & coll) {
 
 // Add all primary elastic sub-colliions
 
-bool Angantyr::addEL(const multiset<SubCollision> & coll,
+bool Angantyr::addEL(const vector<SubCollision> & coll,
                    list<EventInfo> & subevents) {
   // Collect full elastic collisions.
-  for ( multiset<SubCollision>::iterator cit = coll.begin();
+  for ( vector<SubCollision>::const_iterator cit = coll.begin();
         cit != coll.end(); ++cit )
     if ( cit->type == SubCollision::ELASTIC &&
          !cit->proj->done() && !cit->targ->done() ) {
@@ -927,9 +1054,9 @@ bool Angantyr::addEL(const multiset<SubCollision> & coll,
 
 // Add all secondary elastic sub-colliions to primary ones.
 
-void Angantyr::addELsecond(const multiset<SubCollision> & coll) {
+void Angantyr::addELsecond(const vector<SubCollision> & coll) {
     // Collect secondary elastic sub-collisions.
-  for ( multiset<SubCollision>::iterator cit = coll.begin();
+  for ( vector<SubCollision>::const_iterator cit = coll.begin();
         cit != coll.end(); ++cit ) {
     if ( !cit->proj->done() && cit->type == SubCollision::ELASTIC ) {
       EventInfo * evp = cit->targ->event();
@@ -1262,6 +1389,7 @@ bool Angantyr::addNucleonExcitation(EventInfo & ei, EventInfo & sub,
   // Add energy to zeroth line and calculate new invariant mass.
   ei.event[0].p( ei.event[0].p() + pbeam );
   ei.event[0].m( ei.event[0].mCalc() );
+  int iFirstCopy = ei.event.size();
   for (int i = nextpos; i < sub.event.size(); ++i) {
     Particle temp = sub.event[i];
 
@@ -1274,11 +1402,13 @@ bool Angantyr::addNucleonExcitation(EventInfo & ei, EventInfo & sub,
     if ( temp.daughter2() > 0 ) temp.daughter2( temp.daughter2() + idoff );
     if ( temp.col() > 0 ) temp.col( temp.col() + coloff );
     if ( temp.acol() > 0 ) temp.acol( temp.acol() + coloff );
-    temp.rotbst(R12.second);
     // Append particle to summed event.
     ei.event.append( temp );
   }
 
+  // Transform the appended particles in one go.
+  ei.event.rotbst(R12.second, iFirstCopy, ei.event.size());
+
   addJunctions(ei.event, sub.event, coloff);
 
   if ( tside )
@@ -1608,6 +1738,9 @@ bool Angantyr::next() {
     }
     if ( subColls.empty() ) continue;
 
+    // Base seed for the independent sub-events of this attempt.
+    if ( seedSubEvents )
+      seedBase = (unsigned int)( MAXSEED * mainPythiaPtr->rndm.flat() );
 
     list<EventInfo> subevents;
 
@@ -8,6 +8,7 @@
 // Clustering and History classes.
 
 #include "Pythia8/History.h"
+#include "Pythia8/Merging.h"
 
 namespace Pythia8 {
 
@@ -33,6 +34,20 @@ void Clustering::list() const {
 
 //==========================================================================
 
+// The TrialShowerTask class.
+
+//--------------------------------------------------------------------------
+
+// Perform the trial shower, with its own random number sequence if a
+// seed is set.
+
+void TrialShowerTask::run(PartonLevel* trial, Rndm* rndmPtr) {
+  if (seed > 0) rndmPtr->init(seed);
+  weight = node->doTrialShower( trial, type, maxscale);
+}
+
+//==========================================================================
+
 // The History class.
 
 // A History object represents an event in a given step in the CKKW-L
@@ -69,11 +84,11 @@ const int History::NTRIAL = 1;
 
 History::History( int depthIn,
          double scalein,
-         Event statein,
-         Clustering c,
+         const Event& statein,
+         const Clustering& c,
          MergingHooks* mergingHooksPtrIn,
-         BeamParticle beamAIn,
-         BeamParticle beamBIn,
+         const BeamParticle& beamAIn,
+         const BeamParticle& beamBIn,
          ParticleData* particleDataPtrIn,
          Info* infoPtrIn,
          PartonLevel* showersIn,
@@ -111,9 +126,23 @@ History::History( int depthIn,
       probMaxSave(-1.),
       depth(depthIn),
       minDepthSave(-1),
-      nMaxOrd(0)
+      nMaxOrd(0),
+      nIncreaseNow(0),
+      nIncreaseMax(0),
+      mergingPtr(0),
+      trialBatchMode(0),
+      iTrialNext(0)
     {
 
+  // Continue the count of increasing clustering scales along the path.
+  if (mother && mother->mother) {
+    double scaleBef = mother->clusterIn.pT();
+    nIncreaseNow    = mother->nIncreaseNow;
+    if (scaleBef < clusterIn.pT()) ++nIncreaseNow;
+    if (scaleBef > clusterIn.pT()) nIncreaseNow = 0;
+    nIncreaseMax    = max( mother->nIncreaseMax, nIncreaseNow);
+  }
+
   // Initialise beam particles
   setupBeams();
 
@@ -2100,18 +2129,16 @@ int History::nClusterings() {
   return w;
 }
 
+// Function to return the maximal number of increasing scales in a row,
+// along the path of clustering scales extended by an input scale.
+// The count up to the current node is kept, so only the last step is new.
+
 int History::nOrdered( double maxscale ) {
-  //return -1;
-  vector<double> s = scales();
-  if (s.empty()) return 0;
-  s.push_back(maxscale);
-  int no(0), nomax(0);
-  for (size_t i=0; i < s.size()-1; ++i) {
-    if (s[i]<s[i+1]) no++;
-    if (s[i]>s[i+1]) no=0;
-    nomax = max(no,nomax);
-  }
-  return nomax;
+  if ( !mother ) return 0;
+  int no = nIncreaseNow;
+  if (clusterIn.pT() < maxscale) no++;
+  if (clusterIn.pT() > maxscale) no = 0;
+  return max(no, nIncreaseMax);
 }
 
 vector<double> History::scales() {
@@ -2358,6 +2385,24 @@ double History::weightTree(PartonLevel* trial, double as0, double aem0,
   AlphaEM * aemFSR, AlphaEM * aemISR, double& asWeight, double& aemWeight,
   double& pdfWeight) {
 
+  // When the trial showers are run in one batch, first collect them along
+  // the path, then run them, and finally pick up their weights.
+  History* initial = initialNode();
+  if (initial->mergingPtr && initial->trialBatchMode == 0) {
+    double asDummy = 1., aemDummy = 1., pdfDummy = 1.;
+    initial->trialBatch.resize(0);
+    initial->trialBatchMode = 1;
+    weightTree( trial, as0, aem0, maxscale, pdfScale, asFSR, asISR, aemFSR,
+      aemISR, asDummy, aemDummy, pdfDummy);
+    initial->mergingPtr->runTrialShowerBatch( initial->trialBatch);
+    initial->trialBatchMode = 2;
+    initial->iTrialNext     = 0;
+    double w = weightTree( trial, as0, aem0, maxscale, pdfScale, asFSR,
+      asISR, aemFSR, aemISR, asWeight, aemWeight, pdfWeight);
+    initial->trialBatchMode = 0;
+    return w;
+  }
+
   // Use correct scale
   double newScale = scale;
 
@@ -2413,7 +2458,7 @@ double History::weightTree(PartonLevel* trial, double as0, double aem0,
   // If up to now, trial shower was not successful, return zero
   if ( w < 1e-12 ) return 0.0;
   // Do trial shower on current state, return zero if not successful
-  w *= doTrialShower(trial, 1, maxscale);
+  w *= trialShower(trial, 1, maxscale);
   if ( w < 1e-12 ) return 0.0;
 
   int emtType = mother->state[clusterIn.emitted].colType();
@@ -2720,6 +2765,21 @@ double History::weightTreePDFs( double maxscale, double pdfScale,
 double History::weightTreeEmissions( PartonLevel* trial, int type,
   int njetMin, int njetMax, double maxscale ) {
 
+  // When the trial showers are run in one batch, first collect them along
+  // the path, then run them, and finally pick up their weights.
+  History* initial = initialNode();
+  if (initial->mergingPtr && initial->trialBatchMode == 0) {
+    initial->trialBatch.resize(0);
+    initial->trialBatchMode = 1;
+    weightTreeEmissions( trial, type, njetMin, njetMax, maxscale);
+    initial->mergingPtr->runTrialShowerBatch( initial->trialBatch);
+    initial->trialBatchMode = 2;
+    initial->iTrialNext     = 0;
+    double w = weightTreeEmissions( trial, type, njetMin, njetMax, maxscale);
+    initial->trialBatchMode = 0;
+    return w;
+  }
+
   // Use correct scale
   double newScale = scale;
   // For ME state, just multiply by PDF ratios
@@ -2736,7 +2796,7 @@ double History::weightTreeEmissions( PartonLevel* trial, int type,
   if (njetNow >= njetMax) return 1.0;
   if (njetNow < njetMin ) w *= 1.0;
   // Do trial shower on current state, return zero if not successful
-  else w *= doTrialShower(trial, type, maxscale);
+  else w *= trialShower(trial, type, maxscale);
 
   if ( w < 1e-12 ) return 0.0;
   // Done
@@ -3121,6 +3181,10 @@ double History::hardRenScale(const Event& event) {
 double History::doTrialShower( PartonLevel* trial, int type,
   double maxscaleIn, double minscaleIn ) {
 
+  // Use the merging hooks of the trial shower object, which are those
+  // of the thread running the trial shower.
+  MergingHooks* hooksPtr = trial->mergingHooksPtr;
+
   // Copy state to local process
   Event process        = state;
   // Set starting scale.
@@ -3128,9 +3192,9 @@ double History::doTrialShower( PartonLevel* trial, int type,
 
   // Careful when setting shower starting scale for pure QCD and prompt
   // photon case.
-  if ( mergingHooksPtr->getNumberOfClusteringSteps(process) == 0
-    && ( mergingHooksPtr->getProcessString().compare("pp>jj") == 0
-         || mergingHooksPtr->getProcessString().compare("pp>aj") == 0
+  if ( hooksPtr->getNumberOfClusteringSteps(process) == 0
+    && ( hooksPtr->getProcessString().compare("pp>jj") == 0
+         || hooksPtr->getProcessString().compare("pp>aj") == 0
          || isQCD2to2(state) ) )
       startingScale = min( startingScale, hardFacScale(process) );
 
@@ -3165,18 +3229,18 @@ double History::doTrialShower( PartonLevel* trial, int type,
     // ensure that the showers can order the next emission correctly in
     // rapidity, if required.
     // NOT CORRECTLY SET FOR HIGHEST MULTIPLICITY STATE!
-    double z = ( mergingHooksPtr->getNumberOfClusteringSteps(state) == 0
+    double z = ( hooksPtr->getNumberOfClusteringSteps(state) == 0
                || !mother )
              ? 0.5
              : mother->getCurrentZ(clusterIn.emittor,clusterIn.recoiler,
                  clusterIn.emitted, clusterIn.flavRadBef);
     // Store z and pT values at which the current state was formed.
-    infoPtr->zNowISR(z);
-    infoPtr->pT2NowISR(pow(startingScale,2));
-    infoPtr->hasHistory(true);
+    trial->infoPtr->zNowISR(z);
+    trial->infoPtr->pT2NowISR(pow(startingScale,2));
+    trial->infoPtr->hasHistory(true);
 
     // Setup weak shower settings.
-    if (mergingHooksPtr->doWeakClustering()) setupSimpleWeakShower(0);
+    if (hooksPtr->doWeakClustering()) setupSimpleWeakShower(0);
 
     // Perform trial shower emission
     trial->next(process,event);
@@ -3195,9 +3259,9 @@ double History::doTrialShower( PartonLevel* trial, int type,
     if ( canEnhanceTrial && pTEnhanced > 0.) pTtrial = pTEnhanced;
 
     // Get veto (merging) scale value
-    double vetoScale  = (mother) ? 0. : mergingHooksPtr->tms();
+    double vetoScale  = (mother) ? 0. : hooksPtr->tms();
     // Get merging scale in current event
-    double tnow = mergingHooksPtr->tmsNow( event );
+    double tnow = hooksPtr->tmsNow( event );
 
     // Done if evolution scale has fallen below minimum
     if ( pTtrial < minScale ) break;
@@ -3208,8 +3272,8 @@ double History::doTrialShower( PartonLevel* trial, int type,
     if ( tnow < vetoScale && vetoScale > 0. ) continue;
 
     // Retry if the trial emission was not allowed.
-    if ( mergingHooksPtr->canVetoTrialEmission()
-      && mergingHooksPtr->doVetoTrialEmission( process, event) ) continue;
+    if ( hooksPtr->canVetoTrialEmission()
+      && hooksPtr->doVetoTrialEmission( process, event) ) continue;
 
     int iRecAft = event.size() - 1;
     int iEmt    = event.size() - 2;
@@ -3249,9 +3313,9 @@ double History::doTrialShower( PartonLevel* trial, int type,
     // above the kinematical pT of the 2 -> 2 state.
     if ( type == -1
       && typeTrial == 1
-      && mergingHooksPtr->getNumberOfClusteringSteps(process) == 0
-      && ( mergingHooksPtr->getProcessString().compare("pp>jj") == 0
-        || mergingHooksPtr->getProcessString().compare("pp>aj") == 0
+      && hooksPtr->getNumberOfClusteringSteps(process) == 0
+      && ( hooksPtr->getProcessString().compare("pp>jj") == 0
+        || hooksPtr->getProcessString().compare("pp>aj") == 0
            || isQCD2to2(state))
       && pTtrial > hardFacScale(process) )
       return 0.0;
@@ -3273,6 +3337,26 @@ double History::doTrialShower( PartonLevel* trial, int type,
 
 //--------------------------------------------------------------------------
 
+// Perform a trial shower, or, when the trial showers of a weight
+// calculation are run in one batch, add it to the batch or pick up its
+// weight from the batch.
+
+double History::trialShower( PartonLevel* trial, int type,
+  double maxscale) {
+
+  History* initial = initialNode();
+  if (initial->trialBatchMode == 1) {
+    initial->trialBatch.push_back( TrialShowerTask( this, type, maxscale) );
+    return 1.;
+  }
+  if (initial->trialBatchMode == 2)
+    return initial->trialBatch[initial->iTrialNext++].weight;
+  return doTrialShower( trial, type, maxscale);
+
+}
+
+//--------------------------------------------------------------------------
+
 // Assume we have a vector of i elements containing indices into
 // another vector with N elements. Update the indices so that all
 // unique combinations (starting from 0,1,2,3, ...) are
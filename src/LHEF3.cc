@@ -22,6 +22,9 @@ namespace Pythia8 {
 // Constants.
 const XMLTag::pos_t XMLTag::end = string::npos;
 
+// Start value of the FNV-1a hashes of the index files.
+const unsigned long Reader::HASHBASIS = 2166136261UL;
+
 //==========================================================================
 
 // The LHAweights struct.
@@ -39,9 +42,9 @@ LHAweights::LHAweights(const XMLTag & tag) {
 
   contents = tag.contents;
 
-  istringstream iss(tag.contents);
+  const char* str = tag.contents.c_str();
   double w;
-  while ( iss >> w ) weights.push_back(w);
+  while ( readNumberLHEF(str, w) ) weights.push_back(w);
 }
 
 //--------------------------------------------------------------------------
@@ -538,6 +541,12 @@ bool Reader::init() {
 
   bool readingHeader = false;
   bool readingInit = false;
+  iEventNext = 0;
+  nEventLeft = -1;
+  eventOffsets.resize(0);
+  keepLine = false;
+  indexFile = "";
+  initHash = HASHBASIS;
 
   // Make sure we are reading a LHEF file:
   getLine();
@@ -711,8 +720,8 @@ bool Reader::readEvent(HEPEUP * peup) {
   weights_detailed_vec.clear();
 
   // Check if the initialization was successful. Otherwise we will
-  // not read any events.
-  if ( heprup.NPRUP < 0 ) return false;
+  // not read any events. Also stop when the event limit is reached.
+  if ( heprup.NPRUP < 0 || nEventLeft == 0 ) return false;
   eventComments = "";
   outsideBlock = "";
   eup.NUP = 0;
@@ -741,22 +750,31 @@ bool Reader::readEvent(HEPEUP * peup) {
 
   // We found an event. The first line determines how many
   // subsequent particle lines we have.
-  istringstream iss(currentLine);
-  if ( !( iss >> eup.NUP >> eup.IDPRUP >> eup.XWGTUP
-              >> eup.SCALUP >> eup.AQEDUP >> eup.AQCDUP ) )
+  const char* str = currentLine.c_str();
+  if ( !( readNumberLHEF(str, eup.NUP)    && readNumberLHEF(str, eup.IDPRUP)
+       && readNumberLHEF(str, eup.XWGTUP) && readNumberLHEF(str, eup.SCALUP)
+       && readNumberLHEF(str, eup.AQEDUP)
+       && readNumberLHEF(str, eup.AQCDUP) ) )
     return false;
   eup.resize();
 
   // Read all particle lines.
   for ( int i = 0; i < eup.NUP; ++i ) {
     if ( !getLine() ) return false;
-    istringstream isss(currentLine);
-    if ( !( isss >> eup.IDUP[i] >> eup.ISTUP[i]
-                >> eup.MOTHUP[i].first >> eup.MOTHUP[i].second
-                >> eup.ICOLUP[i].first >> eup.ICOLUP[i].second
-                >> eup.PUP[i][0] >> eup.PUP[i][1] >> eup.PUP[i][2]
-                >> eup.PUP[i][3] >> eup.PUP[i][4]
-                >> eup.VTIMUP[i] >> eup.SPINUP[i] ) )
+    str = currentLine.c_str();
+    if ( !( readNumberLHEF(str, eup.IDUP[i])
+         && readNumberLHEF(str, eup.ISTUP[i])
+         && readNumberLHEF(str, eup.MOTHUP[i].first)
+         && readNumberLHEF(str, eup.MOTHUP[i].second)
+         && readNumberLHEF(str, eup.ICOLUP[i].first)
+         && readNumberLHEF(str, eup.ICOLUP[i].second)
+         && readNumberLHEF(str, eup.PUP[i][0])
+         && readNumberLHEF(str, eup.PUP[i][1])
+         && readNumberLHEF(str, eup.PUP[i][2])
+         && readNumberLHEF(str, eup.PUP[i][3])
+         && readNumberLHEF(str, eup.PUP[i][4])
+         && readNumberLHEF(str, eup.VTIMUP[i])
+         && readNumberLHEF(str, eup.SPINUP[i]) ) )
       return false;
   }
 
@@ -827,10 +845,257 @@ bool Reader::readEvent(HEPEUP * peup) {
 
   for ( int i = 0, N = tags.size(); i < N; ++i ) if (tags[i]) delete tags[i];
 
+  ++iEventNext;
+  if ( nEventLeft > 0 ) --nEventLeft;
+  return true;
+
+}
+
+//--------------------------------------------------------------------------
+
+// Skip the next event without parsing its contents.
+
+bool Reader::skipEvent() {
+
+  // Check if the initialization was successful, and the event limit.
+  if ( heprup.NPRUP < 0 || nEventLeft == 0 ) return false;
+  outsideBlock = "";
+
+  // Find the start of the event, and the line with the event information.
+  while ( getLine() && currentLine.find("<event") == string::npos )
+    outsideBlock += currentLine + "\n";
+  if ( currentLine == "" || !getLine() ) return false;
+
+  // Skip to the end of the event.
+  while ( getLine() && currentLine.find("</event>") == string::npos ) ;
+  ++iEventNext;
+  if ( nEventLeft > 0 ) --nEventLeft;
+  return true;
+
+}
+
+//--------------------------------------------------------------------------
+
+// Skip a number of events, with a jump in the file if indexed.
+
+bool Reader::skipEvents(long nSkip) {
+  if ( nSkip <= 0 ) return true;
+  if ( !eventOffsets.empty() ) return seekEvent(iEventNext + nSkip);
+  for ( long iSkip = 0; iSkip < nSkip; ++iSkip )
+    if ( !skipEvent() ) return false;
+  return true;
+}
+
+//--------------------------------------------------------------------------
+
+// Index the positions of the events, from an index file if it is
+// valid for the event file, or else by a scan of the event file.
+
+bool Reader::indexEvents(string indexFileIn) {
+
+  // The size of the event file and a hash of its header and init blocks
+  // identify it.
+  if ( filename == "" ) return false;
+  ifstream isRaw(filename.c_str(), ios::in | ios::binary);
+  if ( !isRaw.good() ) return false;
+  isRaw.seekg(0, ios::end);
+  std::streamoff fileSize = isRaw.tellg();
+  isRaw.close();
+  if ( !hashInit() ) return false;
+
+  // Try to read the index file, else scan the event file and save the
+  // index.
+  indexFile = indexFileIn;
+  eventOffsets.resize(0);
+  if ( indexFile != "" && readIndex(fileSize) ) return true;
+  if ( !scanEvents() ) return false;
+  if ( indexFile != "" ) writeIndex(fileSize);
   return true;
 
 }
 
+//--------------------------------------------------------------------------
+
+// Read the index file. The header stores an identifier, the size of the
+// offsets, the size of the event file, the hash of its header and init
+// blocks and the number of events. The offsets are followed by a hash
+// of themselves. The index is only accepted if all of these match, and
+// if the number of events agrees with the length of the index file.
+
+bool Reader::readIndex(std::streamoff fileSize) {
+
+  ifstream isIndex(indexFile.c_str(), ios::in | ios::binary);
+  string idLine;
+  int sizeOffset = 0;
+  std::streamoff fileSizeIndex = -1;
+  unsigned long initHashIndex = 0, offsetHash = HASHBASIS,
+    offsetHashIndex = 0;
+  long nEvent = 0;
+  if ( !getline(isIndex, idLine) || idLine != "PYTHIA8 LHEF index v2"
+    || !isIndex.read((char*)&sizeOffset, sizeof(int))
+    || sizeOffset != int(sizeof(std::streamoff))
+    || !isIndex.read((char*)&fileSizeIndex, sizeof(std::streamoff))
+    || fileSizeIndex != fileSize
+    || !isIndex.read((char*)&initHashIndex, sizeof(unsigned long))
+    || initHashIndex != initHash
+    || !isIndex.read((char*)&nEvent, sizeof(long)) || nEvent <= 0 )
+    return false;
+  std::streamoff posOffsets = isIndex.tellg();
+  isIndex.seekg(0, ios::end);
+  std::streamoff nByteOffsets = std::streamoff(isIndex.tellg()) - posOffsets
+    - std::streamoff(sizeof(unsigned long));
+  std::streamoff sizeOff = sizeof(std::streamoff);
+  if ( posOffsets < 0 || nByteOffsets < 0 || nByteOffsets % sizeOff != 0
+    || nByteOffsets / sizeOff != nEvent ) return false;
+  isIndex.seekg(posOffsets);
+  eventOffsets.resize(nEvent);
+  if ( isIndex.read((char*)&eventOffsets[0], nEvent * sizeof(std::streamoff))
+    && isIndex.read((char*)&offsetHashIndex, sizeof(unsigned long)) )
+    addHash(offsetHash, (const char*)&eventOffsets[0],
+      nEvent * sizeof(std::streamoff));
+  if ( isIndex && offsetHash == offsetHashIndex ) return true;
+  eventOffsets.resize(0);
+  return false;
+
+}
+
+//--------------------------------------------------------------------------
+
+// Write the index file, in the format described in readIndex.
+
+void Reader::writeIndex(std::streamoff fileSize) {
+
+  ofstream osIndex(indexFile.c_str(), ios::out | ios::binary);
+  int sizeOffset = sizeof(std::streamoff);
+  long nEvent = eventOffsets.size();
+  unsigned long offsetHash = HASHBASIS;
+  if ( nEvent > 0 ) addHash(offsetHash, (const char*)&eventOffsets[0],
+    nEvent * sizeof(std::streamoff));
+  osIndex << "PYTHIA8 LHEF index v2\n";
+  osIndex.write((const char*)&sizeOffset, sizeof(int));
+  osIndex.write((const char*)&fileSize, sizeof(std::streamoff));
+  osIndex.write((const char*)&initHash, sizeof(unsigned long));
+  osIndex.write((const char*)&nEvent, sizeof(long));
+  if ( nEvent > 0 ) osIndex.write((const char*)&eventOffsets[0],
+    nEvent * sizeof(std::streamoff));
+  osIndex.write((const char*)&offsetHash, sizeof(unsigned long));
+
+}
+
+//--------------------------------------------------------------------------
+
+// Hash the lines of the event file up to and including the end of the
+// init block.
+
+bool Reader::hashInit() {
+
+  igzstream isHead(filename.c_str());
+  if ( !isHead.good() ) return false;
+  initHash = HASHBASIS;
+  string line;
+  while ( getline(isHead, line) ) {
+    addHash(initHash, line.data(), line.length());
+    if ( line.find("</init>") != string::npos ) return true;
+  }
+  return false;
+
+}
+
+//--------------------------------------------------------------------------
+
+// Scan the event file for the positions of the event start tags, with
+// the same logic as readEvent. For gzipped files the positions are in
+// the uncompressed stream.
+
+bool Reader::scanEvents() {
+
+  igzstream isScan(filename.c_str());
+  if ( !isScan.good() ) return false;
+  eventOffsets.resize(0);
+  string line;
+  std::streamoff pos = 0;
+  bool afterInit = false, inEvent = false;
+  while ( getline(isScan, line) ) {
+    if ( !afterInit ) {
+      if ( line.find("</init>") != string::npos ) afterInit = true;
+    } else if ( !inEvent ) {
+      if ( line.find("<event") != string::npos ) {
+        eventOffsets.push_back(pos);
+        inEvent = true;
+      }
+    } else if ( line.find("</event>") != string::npos ) inEvent = false;
+    pos += line.length() + 1;
+  }
+  return afterInit;
+
+}
+
+//--------------------------------------------------------------------------
+
+// Jump to an indexed event. Events jumped over count against the limit.
+
+bool Reader::seekEvent(long iEvent) {
+
+  // Jumps beyond the last event or the limit end the reading.
+  long nEvent = eventOffsets.size();
+  if ( iEvent < 0 ) return false;
+  if ( iEvent > nEvent || (nEventLeft >= 0
+    && iEvent - iEventNext > nEventLeft) ) {
+    nEventLeft = 0;
+    return false;
+  }
+  if ( nEventLeft >= 0 ) nEventLeft -= max(0L, iEvent - iEventNext);
+  iEventNext = iEvent;
+  if ( iEvent == nEvent ) {
+    nEventLeft = 0;
+    return true;
+  }
+
+  // Move the stream to the start of the event. If the event is not
+  // found there the index is out of date, and is rebuilt and saved.
+  if ( moveToEvent(iEvent) ) return true;
+  if ( !hashInit() || !scanEvents() ) return false;
+  if ( indexFile != "" ) {
+    ifstream isRaw(filename.c_str(), ios::in | ios::binary);
+    isRaw.seekg(0, ios::end);
+    writeIndex(isRaw.tellg());
+  }
+  return moveToEvent(iEvent);
+
+}
+
+//--------------------------------------------------------------------------
+
+// Move the stream to an indexed event, and check that the line there
+// starts with an event tag. The line is then kept for the next read.
+
+bool Reader::moveToEvent(long iEvent) {
+
+  keepLine = false;
+  if ( iEvent >= long(eventOffsets.size()) ) return false;
+  file->clear();
+  file->seekg(eventOffsets[iEvent]);
+  if ( file->fail() || !getLine() ) return false;
+  size_t iTag = currentLine.find_first_not_of(" \t");
+  if ( iTag == string::npos || currentLine.compare(iTag, 6, "<event") != 0 )
+    return false;
+  keepLine = true;
+  return true;
+
+}
+
+//--------------------------------------------------------------------------
+
+// Add a number of bytes to a hash with the FNV-1a algorithm. The hash
+// should start from HASHBASIS.
+
+void Reader::addHash(unsigned long& hash, const char* data, size_t n) {
+  for ( size_t i = 0; i < n; ++i ) {
+    hash ^= (unsigned char)data[i];
+    hash *= 16777619UL;
+  }
+}
+
 //==========================================================================
 
 // The Writer class is initialized with a stream to which to write a
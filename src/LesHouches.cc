@@ -939,20 +939,63 @@ bool LHAupLHEF::setInitLHEF( istream & isIn, bool readHead ) {
 
 //--------------------------------------------------------------------------
 
+// Index the events, with the index in a file next to the event file,
+// and optionally restrict the reading to one shard of the events.
+
+bool LHAupLHEF::indexEvents(int iShard, int nShard) {
+
+  // Check input, and that the events are read from a file.
+  if (nShard < 1 || iShard < 0 || iShard >= nShard) {
+    infoPtr->errorMsg("Error in LHAupLHEF::indexEvents: "
+      "shard number out of range");
+    return false;
+  }
+  if (reader.fileName() == "") {
+    infoPtr->errorMsg("Error in LHAupLHEF::indexEvents: "
+      "events not read from file");
+    return false;
+  }
+
+  // Read the index, or build and save it. Starting at an event other
+  // than the first one is not possible.
+  if (reader.nextEvent() != 0 || !reader.indexEvents(reader.fileName()
+    + ".idx")) {
+    infoPtr->errorMsg("Error in LHAupLHEF::indexEvents: "
+      "could not index the events in", reader.fileName());
+    return false;
+  }
+
+  // Jump to the first event of the shard, and stop at its end.
+  long nEvent = reader.nEventIndex();
+  long iFirst = (nEvent * iShard) / nShard;
+  long iLast  = (nEvent * (iShard + 1)) / nShard;
+  if (!reader.seekEvent(iFirst)) {
+    infoPtr->errorMsg("Error in LHAupLHEF::indexEvents: "
+      "could not find the first event of the shard in", reader.fileName());
+    return false;
+  }
+  reader.setEventLimit(iLast - iFirst);
+  return true;
+
+}
+
+//--------------------------------------------------------------------------
+
 // Routine for doing the job of reading and setting info on next event.
 
 bool LHAupLHEF::setNewEventLHEF() {
 
   // Done if the reader finished preemptively.
-  if(!reader.readEvent()) return false;
+  if (!readEventLHEF()) return false;
+  HEPEUP& hepeup = *hepeupPtr;
 
   // Extract process info and store it.
-  nupSave     = reader.hepeup.NUP;
-  idprupSave  = reader.hepeup.IDPRUP;
-  xwgtupSave  = reader.hepeup.XWGTUP;
-  scalupSave  = reader.hepeup.SCALUP;
-  aqedupSave  = reader.hepeup.AQEDUP;
-  aqcdupSave  = reader.hepeup.AQCDUP;
+  nupSave     = hepeup.NUP;
+  idprupSave  = hepeup.IDPRUP;
+  xwgtupSave  = hepeup.XWGTUP;
+  scalupSave  = hepeup.SCALUP;
+  aqedupSave  = hepeup.AQEDUP;
+  aqcdupSave  = hepeup.AQCDUP;
 
   // Reset particlesSave vector, add slot-0 empty particle.
   particlesSave.clear();
@@ -963,21 +1006,21 @@ bool LHAupLHEF::setNewEventLHEF() {
   // (Recall that process(...) above added empty particle at index 0.)
   int idup, istup, mothup1, mothup2, icolup1, icolup2;
   double pup1, pup2, pup3, pup4, pup5, vtimup, spinup;
-  for ( int i = 0; i < reader.hepeup.NUP; ++i ) {
+  for ( int i = 0; i < hepeup.NUP; ++i ) {
     // Extract information stored in reader.
-    idup     = reader.hepeup.IDUP[i];
-    istup    = reader.hepeup.ISTUP[i];
-    mothup1  = reader.hepeup.MOTHUP[i].first;
-    mothup2  = reader.hepeup.MOTHUP[i].second;
-    icolup1  = reader.hepeup.ICOLUP[i].first;
-    icolup2  = reader.hepeup.ICOLUP[i].second;
-    pup1     = reader.hepeup.PUP[i][0];
-    pup2     = reader.hepeup.PUP[i][1];
-    pup3     = reader.hepeup.PUP[i][2];
-    pup4     = reader.hepeup.PUP[i][3];
-    pup5     = reader.hepeup.PUP[i][4];
-    vtimup   = reader.hepeup.VTIMUP[i];
-    spinup   = reader.hepeup.SPINUP[i];
+    idup     = hepeup.IDUP[i];
+    istup    = hepeup.ISTUP[i];
+    mothup1  = hepeup.MOTHUP[i].first;
+    mothup2  = hepeup.MOTHUP[i].second;
+    icolup1  = hepeup.ICOLUP[i].first;
+    icolup2  = hepeup.ICOLUP[i].second;
+    pup1     = hepeup.PUP[i][0];
+    pup2     = hepeup.PUP[i][1];
+    pup3     = hepeup.PUP[i][2];
+    pup4     = hepeup.PUP[i][3];
+    pup5     = hepeup.PUP[i][4];
+    vtimup   = hepeup.VTIMUP[i];
+    spinup   = hepeup.SPINUP[i];
     particlesSave.push_back( Pythia8::LHAParticle( idup,istup,mothup1,mothup2,
       icolup1, icolup2, pup1, pup2, pup3, pup4, pup5, vtimup, spinup, -1.) );
   }
@@ -990,7 +1033,7 @@ bool LHAupLHEF::setNewEventLHEF() {
 
   // Parse event comments and look for optional info on the way.
   std::string line, tag;
-  std::stringstream ss(reader.eventComments);
+  std::stringstream ss(*eventCommentsPtr);
   getPDFSave      = false;
   getScale        = false;
   getScale        = (setScalesFromLHEF && reader.version == 1) ? false : true;
@@ -1026,8 +1069,8 @@ bool LHAupLHEF::setNewEventLHEF() {
   // Set production scales from <scales> tag.
   if ( setScalesFromLHEF && reader.version > 1 ){
     for ( map<string,double>::const_iterator
-      it  = reader.hepeup.scalesSave.attributes.begin();
-      it != reader.hepeup.scalesSave.attributes.end(); ++it ) {
+      it  = hepeup.scalesSave.attributes.begin();
+      it != hepeup.scalesSave.attributes.end(); ++it ) {
       if ( it->first.find_last_of("_") != string::npos) {
         unsigned iFound = it->first.find_last_of("_") + 1;
         int iPos = atoi(it->first.substr(iFound).c_str());
@@ -1054,14 +1097,14 @@ bool LHAupLHEF::setNewEventLHEF() {
   infoPtr->setLHEF3EventInfo();
   // Set everything for 2.0 and 3.0
   if (reader.version > 1) {
-    infoPtr->setLHEF3EventInfo( &reader.hepeup.attributes,
-      &reader.hepeup.weights_detailed, &reader.hepeup.weights_compressed,
-      &reader.hepeup.scalesSave, &reader.hepeup.weightsSave,
-      &reader.hepeup.rwgtSave, reader.weights_detailed_vector(),
-      reader.eventComments, reader.hepeup.XWGTUP);
+    infoPtr->setLHEF3EventInfo( &hepeup.attributes,
+      &hepeup.weights_detailed, &hepeup.weights_compressed,
+      &hepeup.scalesSave, &hepeup.weightsSave,
+      &hepeup.rwgtSave, *weightsDetailedPtr,
+      *eventCommentsPtr, hepeup.XWGTUP);
   // Try to at least set the event attributes for 1.0
   } else {
-    infoPtr->setLHEF3EventInfo( &reader.hepeup.attributes, 0, 0, 0, 0, 0,
+    infoPtr->setLHEF3EventInfo( &hepeup.attributes, 0, 0, 0, 0, 0,
        vector<double>(), "", 1.0);
   }
 
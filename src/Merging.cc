@@ -20,6 +20,9 @@ namespace Pythia8 {
 // a warning is printed.
 const double Merging::TMSMISMATCH = 1.5;
 
+// Seeds of trial showers are picked below this value.
+const int    Merging::MAXSEED     = 900000000;
+
 //--------------------------------------------------------------------------
 
 // Initialise Merging class
@@ -29,6 +32,48 @@ void Merging::init(){
   // Reset minimal tms value.
   tmsNowMin             = infoPtr->eCM();
 
+  // Trial showers cannot be seeded with an external random number engine.
+  if (settingsPtr->flag("Merging:seedTrialShowers")
+    && rndmPtr->useExternalEngine()) infoPtr->errorMsg("Warning in "
+    "Merging::init: trial showers are not seeded with an external "
+    "random number engine");
+
+}
+
+//--------------------------------------------------------------------------
+
+// Set up handles to the merging settings that are read for each event.
+
+void Merging::initSettingsRefs() {
+
+  // Settings are looked up once, and later read through the handles.
+  allowIncompleteHistoriesInRealRef
+    = settingsPtr->flagRef("Merging:allowIncompleteHistoriesInReal");
+  applyVetoRef = settingsPtr->flagRef("Merging:applyVeto");
+  doCutBasedMergingRef = settingsPtr->flagRef("Merging:doCutBasedMerging");
+  doKTMergingRef = settingsPtr->flagRef("Merging:doKTMerging");
+  doMGMergingRef = settingsPtr->flagRef("Merging:doMGMerging");
+  doNL3LoopRef = settingsPtr->flagRef("Merging:doNL3Loop");
+  doNL3SubtRef = settingsPtr->flagRef("Merging:doNL3Subt");
+  doNL3TreeRef = settingsPtr->flagRef("Merging:doNL3Tree");
+  doPTLundMergingRef = settingsPtr->flagRef("Merging:doPTLundMerging");
+  doUMEPSSubtRef = settingsPtr->flagRef("Merging:doUMEPSSubt");
+  doUMEPSTreeRef = settingsPtr->flagRef("Merging:doUMEPSTree");
+  doUNLOPSLoopRef = settingsPtr->flagRef("Merging:doUNLOPSLoop");
+  doUNLOPSSubtRef = settingsPtr->flagRef("Merging:doUNLOPSSubt");
+  doUNLOPSSubtNLORef = settingsPtr->flagRef("Merging:doUNLOPSSubtNLO");
+  doUNLOPSTildeRef = settingsPtr->flagRef("Merging:doUNLOPSTilde");
+  doUNLOPSTreeRef = settingsPtr->flagRef("Merging:doUNLOPSTree");
+  doUserMergingRef = settingsPtr->flagRef("Merging:doUserMerging");
+  doXSectionEstimateRef = settingsPtr->flagRef("Merging:doXSectionEstimate");
+  enforceCutOnLHERef = settingsPtr->flagRef("Merging:enforceCutOnLHE");
+  runtimeAMCATNLOInterfaceRef
+    = settingsPtr->flagRef("Merging:runtimeAMCATNLOInterface");
+  seedTrialShowersRef = settingsPtr->flagRef("Merging:seedTrialShowers");
+  nReclusterRef = settingsPtr->modeRef("Merging:nRecluster");
+  nRequestedRef = settingsPtr->modeRef("Merging:nRequested");
+  processRef = settingsPtr->wordRef("Merging:Process");
+
 }
 
 //--------------------------------------------------------------------------
@@ -37,7 +82,7 @@ void Merging::init(){
 void Merging::statistics() {
 
   // Recall switch to enfore merging scale cut.
-  bool enforceCutOnLHE  = settingsPtr->flag("Merging:enforceCutOnLHE");
+  bool enforceCutOnLHE  = enforceCutOnLHERef();
   // Recall merging scale value.
   double tmsval         = mergingHooksPtr->tms();
   bool printBanner      = enforceCutOnLHE && tmsNowMin > TMSMISMATCH*tmsval;
@@ -65,6 +110,55 @@ void Merging::statistics() {
 
 //--------------------------------------------------------------------------
 
+// Run the trial showers collected by a History object in one batch. Each
+// gets its own random number seed, so that the result does not depend on
+// the order in which they are run. The state of the main random number
+// generator is restored afterwards. An external random number engine
+// can neither be reseeded nor restored, so then the trial showers are
+// run one after the other with the main generator.
+
+void Merging::runTrialShowerBatch( vector<TrialShowerTask>& tasks) {
+
+  if (tasks.empty()) return;
+  if (rndmPtr->useExternalEngine()) {
+    Merging::runTrialShowers( tasks);
+    return;
+  }
+  seedBase = (unsigned int)( MAXSEED * rndmPtr->flat() );
+  for (int i = 0; i < int(tasks.size()); ++i)
+    tasks[i].seed = trialShowerSeed(i);
+  Rndm rndmSave = *rndmPtr;
+  runTrialShowers( tasks);
+  *rndmPtr = rndmSave;
+
+}
+
+//--------------------------------------------------------------------------
+
+// Run a batch of trial showers one after the other.
+
+void Merging::runTrialShowers( vector<TrialShowerTask>& tasks) {
+  for (int i = 0; i < int(tasks.size()); ++i)
+    tasks[i].run( trialPartonLevelPtr, rndmPtr);
+}
+
+//--------------------------------------------------------------------------
+
+// The random number seed for a given trial shower, obtained by hashing
+// the base seed of the current batch with the task index.
+
+int Merging::trialShowerSeed(int iTask) const {
+  unsigned int h = seedBase ^ ( 0x9e3779b9u * (unsigned int)(iTask + 1) );
+  h ^= h >> 16;
+  h *= 0x85ebca6bu;
+  h ^= h >> 13;
+  h *= 0xc2b2ae35u;
+  h ^= h >> 16;
+  return 1 + int( h % (unsigned int)(MAXSEED) );
+}
+
+//--------------------------------------------------------------------------
+
 // Function to steer different merging prescriptions.
 
 int Merging::mergeProcess(Event& process){
@@ -73,48 +167,33 @@ int Merging::mergeProcess(Event& process){
 
   // Reinitialise hard process.
   mergingHooksPtr->hardProcess->clear();
-  mergingHooksPtr->processNow  = settingsPtr->word("Merging:Process");
+  mergingHooksPtr->processNow  = processRef();
   mergingHooksPtr->hardProcess->initOnProcess(
     mergingHooksPtr->processNow, particleDataPtr);
   settingsPtr->word("Merging:Process", mergingHooksPtr->processSave);
 
-  mergingHooksPtr->doUserMergingSave
-    = settingsPtr->flag("Merging:doUserMerging");
-  mergingHooksPtr->doMGMergingSave
-    = settingsPtr->flag("Merging:doMGMerging");
-  mergingHooksPtr->doKTMergingSave
-    = settingsPtr->flag("Merging:doKTMerging");
-  mergingHooksPtr->doPTLundMergingSave
-    = settingsPtr->flag("Merging:doPTLundMerging");
-  mergingHooksPtr->doCutBasedMergingSave
-    = settingsPtr->flag("Merging:doCutBasedMerging");
-  mergingHooksPtr->doNL3TreeSave
-    = settingsPtr->flag("Merging:doNL3Tree");
-  mergingHooksPtr->doNL3LoopSave
-    = settingsPtr->flag("Merging:doNL3Loop");
-  mergingHooksPtr->doNL3SubtSave
-    = settingsPtr->flag("Merging:doNL3Subt");
-  mergingHooksPtr->doUNLOPSTreeSave
-    = settingsPtr->flag("Merging:doUNLOPSTree");
-  mergingHooksPtr->doUNLOPSLoopSave
-    = settingsPtr->flag("Merging:doUNLOPSLoop");
-  mergingHooksPtr->doUNLOPSSubtSave
-    = settingsPtr->flag("Merging:doUNLOPSSubt");
-  mergingHooksPtr->doUNLOPSSubtNLOSave
-    = settingsPtr->flag("Merging:doUNLOPSSubtNLO");
-  mergingHooksPtr->doUMEPSTreeSave
-    = settingsPtr->flag("Merging:doUMEPSTree");
-  mergingHooksPtr->doUMEPSSubtSave
-    = settingsPtr->flag("Merging:doUMEPSSubt");
-  mergingHooksPtr->nReclusterSave
-    = settingsPtr->mode("Merging:nRecluster");
+  mergingHooksPtr->doUserMergingSave = doUserMergingRef();
+  mergingHooksPtr->doMGMergingSave = doMGMergingRef();
+  mergingHooksPtr->doKTMergingSave = doKTMergingRef();
+  mergingHooksPtr->doPTLundMergingSave = doPTLundMergingRef();
+  mergingHooksPtr->doCutBasedMergingSave = doCutBasedMergingRef();
+  mergingHooksPtr->doNL3TreeSave = doNL3TreeRef();
+  mergingHooksPtr->doNL3LoopSave = doNL3LoopRef();
+  mergingHooksPtr->doNL3SubtSave = doNL3SubtRef();
+  mergingHooksPtr->doUNLOPSTreeSave = doUNLOPSTreeRef();
+  mergingHooksPtr->doUNLOPSLoopSave = doUNLOPSLoopRef();
+  mergingHooksPtr->doUNLOPSSubtSave = doUNLOPSSubtRef();
+  mergingHooksPtr->doUNLOPSSubtNLOSave = doUNLOPSSubtNLORef();
+  mergingHooksPtr->doUMEPSTreeSave = doUMEPSTreeRef();
+  mergingHooksPtr->doUMEPSSubtSave = doUMEPSSubtRef();
+  mergingHooksPtr->nReclusterSave = nReclusterRef();
 
   mergingHooksPtr->hasJetMaxLocal  = false;
   mergingHooksPtr->nJetMaxLocal
     = mergingHooksPtr->nJetMaxSave;
   mergingHooksPtr->nJetMaxNLOLocal
     = mergingHooksPtr->nJetMaxNLOSave;
-  int nRequestedNow = settingsPtr->mode("Merging:nRequested");
+  int nRequestedNow = nRequestedRef();
   if ( mergingHooksPtr->getProcessString().compare("pp>aj") != 0
     && mergingHooksPtr->getProcessString().compare("pp>jj") != 0) {
     int sizeOut1 = mergingHooksPtr->hardProcess->hardOutgoing1.size();
@@ -132,7 +211,7 @@ int Merging::mergeProcess(Event& process){
   bool includeWGT = mergingHooksPtr->includeWGTinXSEC();
 
   // Possibility to apply merging scale to an input event.
-  bool applyTMSCut = settingsPtr->flag("Merging:doXSectionEstimate");
+  bool applyTMSCut = doXSectionEstimateRef();
   if ( applyTMSCut && cutOnProcess(process) ) {
     if (includeWGT) infoPtr->updateWeight(0.);
     return -1;
@@ -142,7 +221,7 @@ int Merging::mergeProcess(Event& process){
 
   // For the runtime interface between aMCatNLO and Pythia, simply
   // reconstruct scale and dead zone information and exit.
-  if (settingsPtr->flag("Merging:runtimeAMCATNLOInterface"))
+  if (runtimeAMCATNLOInterfaceRef())
     return clusterAndStore(process);
 
   // Possibility to perform CKKW-L merging on this event.
@@ -490,7 +569,7 @@ int Merging::mergeProcessCKKWL( Event& process) {
   int nSteps = mergingHooksPtr->getNumberOfClusteringSteps( newProcess, true);
 
   // Check if hard event cut should be applied later.
-  bool applyVeto = settingsPtr->flag("Merging:applyVeto");
+  bool applyVeto = applyVetoRef();
 
   // Too few steps can be possible if a chain of resonance decays has been
   // removed. In this case, reject this event, since it will be handled in
@@ -523,6 +602,9 @@ int Merging::mergeProcessCKKWL( Event& process) {
   History FullHistory( nSteps, 0.0, newProcess, Clustering(), mergingHooksPtr,
             (*beamAPtr), (*beamBPtr), particleDataPtr, infoPtr,
             trialPartonLevelPtr, coupSMPtr, true, true, true, true, 1.0, 0);
+  // Optionally run the trial showers of each weight calculation in one
+  // batch, each with its own random number seed.
+  if (seedTrialShowersRef()) FullHistory.setMergingPtr(this);
 
   // Project histories onto desired branches, e.g. only ordered paths.
   FullHistory.projectOntoDesiredHistories();
@@ -536,7 +618,7 @@ int Merging::mergeProcessCKKWL( Event& process) {
 
   // Enfore merging scale cut if the event did not pass the merging scale
   // criterion.
-  bool enforceCutOnLHE  = settingsPtr->flag("Merging:enforceCutOnLHE");
+  bool enforceCutOnLHE  = enforceCutOnLHERef();
   if ( enforceCutOnLHE && applyCut && tmsnow < tmsval && tmsnow >= 0. ) {
     string message="Warning in Merging::mergeProcessCKKWL: Les Houches Event";
     message+=" fails merging scale cut. Reject event.";
@@ -619,11 +701,11 @@ int Merging::mergeProcessCKKWL( Event& process) {
 int Merging::mergeProcessUMEPS( Event& process) {
 
   // Initialise which part of UMEPS merging is applied.
-  bool doUMEPSTree                = settingsPtr->flag("Merging:doUMEPSTree");
-  bool doUMEPSSubt                = settingsPtr->flag("Merging:doUMEPSSubt");
+  bool doUMEPSTree                = doUMEPSTreeRef();
+  bool doUMEPSSubt                = doUMEPSSubtRef();
   // Save number of looping steps
-  mergingHooksPtr->nReclusterSave = settingsPtr->mode("Merging:nRecluster");
-  int nRecluster                  = settingsPtr->mode("Merging:nRecluster");
+  mergingHooksPtr->nReclusterSave = nReclusterRef();
+  int nRecluster                  = nReclusterRef();
 
   // Ensure that merging hooks does not remove emissions.
   mergingHooksPtr->doIgnoreEmissions(true);
@@ -663,7 +745,7 @@ int Merging::mergeProcessUMEPS( Event& process) {
   int nRequested = mergingHooksPtr->nRequested();
 
   // Check if hard event cut should be applied later.
-  bool applyVeto = settingsPtr->flag("Merging:applyVeto");
+  bool applyVeto = applyVetoRef();
 
   // Too few steps can be possible if a chain of resonance decays has been
   // removed. In this case, reject this event, since it will be handled in
@@ -686,6 +768,9 @@ int Merging::mergeProcessUMEPS( Event& process) {
   History FullHistory( nSteps, 0.0, newProcess, Clustering(), mergingHooksPtr,
             (*beamAPtr), (*beamBPtr), particleDataPtr, infoPtr,
             trialPartonLevelPtr, coupSMPtr, true, true, true, true, 1.0, 0);
+  // Optionally run the trial showers of each weight calculation in one
+  // batch, each with its own random number seed.
+  if (seedTrialShowersRef()) FullHistory.setMergingPtr(this);
   // Project histories onto desired branches, e.g. only ordered paths.
   FullHistory.projectOntoDesiredHistories();
 
@@ -695,7 +780,7 @@ int Merging::mergeProcessUMEPS( Event& process) {
 
   // Enfore merging scale cut if the event did not pass the merging scale
   // criterion.
-  bool enforceCutOnLHE  = settingsPtr->flag("Merging:enforceCutOnLHE");
+  bool enforceCutOnLHE  = enforceCutOnLHERef();
   if ( enforceCutOnLHE && applyCut && tmsnow < tmsval ) {
     string message="Warning in Merging::mergeProcessUMEPS: Les Houches Event";
     message+=" fails merging scale cut. Reject event.";
@@ -799,9 +884,9 @@ int Merging::mergeProcessUMEPS( Event& process) {
 int Merging::mergeProcessNL3( Event& process) {
 
   // Initialise which part of NL3 merging is applied.
-  bool doNL3Tree = settingsPtr->flag("Merging:doNL3Tree");
-  bool doNL3Loop = settingsPtr->flag("Merging:doNL3Loop");
-  bool doNL3Subt = settingsPtr->flag("Merging:doNL3Subt");
+  bool doNL3Tree = doNL3TreeRef();
+  bool doNL3Loop = doNL3LoopRef();
+  bool doNL3Subt = doNL3SubtRef();
 
   // Ensure that hooks (NL3 part) to not remove emissions.
   mergingHooksPtr->doIgnoreEmissions(true);
@@ -851,7 +936,7 @@ int Merging::mergeProcessNL3( Event& process) {
 
   // Enfore merging scale cut if the event did not pass the merging scale
   // criterion.
-  bool enforceCutOnLHE  = settingsPtr->flag("Merging:enforceCutOnLHE");
+  bool enforceCutOnLHE  = enforceCutOnLHERef();
   if ( enforceCutOnLHE && nSteps > 0 && nSteps == nRequested
     && tmsnow < tmsval ) {
     string message="Warning in Merging::mergeProcessNL3: Les Houches Event";
@@ -870,6 +955,9 @@ int Merging::mergeProcessNL3( Event& process) {
   History FullHistory( nSteps, 0.0, newProcess, Clustering(), mergingHooksPtr,
             (*beamAPtr), (*beamBPtr), particleDataPtr, infoPtr,
             trialPartonLevelPtr, coupSMPtr, true, true, true, true, 1.0, 0);
+  // Optionally run the trial showers of each weight calculation in one
+  // batch, each with its own random number seed.
+  if (seedTrialShowersRef()) FullHistory.setMergingPtr(this);
   // Project histories onto desired branches, e.g. only ordered paths.
   FullHistory.projectOntoDesiredHistories();
 
@@ -1023,14 +1111,14 @@ int Merging::mergeProcessNL3( Event& process) {
 int Merging::mergeProcessUNLOPS( Event& process) {
 
   // Initialise which part of UNLOPS merging is applied.
-  bool nloTilde         = settingsPtr->flag("Merging:doUNLOPSTilde");
-  bool doUNLOPSTree     = settingsPtr->flag("Merging:doUNLOPSTree");
-  bool doUNLOPSLoop     = settingsPtr->flag("Merging:doUNLOPSLoop");
-  bool doUNLOPSSubt     = settingsPtr->flag("Merging:doUNLOPSSubt");
-  bool doUNLOPSSubtNLO  = settingsPtr->flag("Merging:doUNLOPSSubtNLO");
+  bool nloTilde         = doUNLOPSTildeRef();
+  bool doUNLOPSTree     = doUNLOPSTreeRef();
+  bool doUNLOPSLoop     = doUNLOPSLoopRef();
+  bool doUNLOPSSubt     = doUNLOPSSubtRef();
+  bool doUNLOPSSubtNLO  = doUNLOPSSubtNLORef();
   // Save number of looping steps
-  mergingHooksPtr->nReclusterSave = settingsPtr->mode("Merging:nRecluster");
-  int nRecluster        = settingsPtr->mode("Merging:nRecluster");
+  mergingHooksPtr->nReclusterSave = nReclusterRef();
+  int nRecluster        = nReclusterRef();
 
   // Ensure that merging hooks to not remove emissions
   mergingHooksPtr->doIgnoreEmissions(true);
@@ -1070,7 +1158,7 @@ int Merging::mergeProcessUNLOPS( Event& process) {
   mergingHooksPtr->nInProcessNow = nSteps;
 
   // Check if hard event cut should be applied later.
-  bool allowReject = settingsPtr->flag("Merging:applyVeto");
+  bool allowReject = applyVetoRef();
 
   // Too few steps can be possible if a chain of resonance decays has been
   // removed. In this case, reject this event, since it will be handled in
@@ -1096,6 +1184,9 @@ int Merging::mergeProcessUNLOPS( Event& process) {
   History FullHistory( nSteps, 0.0, newProcess, Clustering(), mergingHooksPtr,
             (*beamAPtr), (*beamBPtr), particleDataPtr, infoPtr,
             trialPartonLevelPtr, coupSMPtr, true, true, true, true, 1.0, 0);
+  // Optionally run the trial showers of each weight calculation in one
+  // batch, each with its own random number seed.
+  if (seedTrialShowersRef()) FullHistory.setMergingPtr(this);
   // Project histories onto desired branches, e.g. only ordered paths.
   FullHistory.projectOntoDesiredHistories();
 
@@ -1105,7 +1196,7 @@ int Merging::mergeProcessUNLOPS( Event& process) {
 
   // Enfore merging scale cut if the event did not pass the merging scale
   // criterion.
-  bool enforceCutOnLHE  = settingsPtr->flag("Merging:enforceCutOnLHE");
+  bool enforceCutOnLHE  = enforceCutOnLHERef();
   if ( enforceCutOnLHE && applyCut && nSteps == nRequested
     && tmsnow < tmsval ) {
     string message="Warning in Merging::mergeProcessUNLOPS: Les Houches";
@@ -1127,7 +1218,7 @@ int Merging::mergeProcessUNLOPS( Event& process) {
   // the loop sample, since such states will be taken care of by tree-level
   // samples.
   bool allowIncompleteReal =
-    settingsPtr->flag("Merging:allowIncompleteHistoriesInReal");
+    allowIncompleteHistoriesInRealRef();
   if ( doUNLOPSLoop && containsRealKin && !allowIncompleteReal
     && FullHistory.select(RN)->nClusterings() == 0 ) {
     mergingHooksPtr->setWeightCKKWL(0.);
@@ -1367,7 +1458,7 @@ int Merging::mergeProcessUNLOPS( Event& process) {
 bool Merging::cutOnProcess( Event& process) {
 
   // Save number of looping steps
-  mergingHooksPtr->nReclusterSave = settingsPtr->mode("Merging:nRecluster");
+  mergingHooksPtr->nReclusterSave = nReclusterRef();
 
   // For now, prefer construction of ordered histories.
   mergingHooksPtr->orderHistories(true);
@@ -1423,7 +1514,7 @@ bool Merging::cutOnProcess( Event& process) {
   // the loop sample, since such states will be taken care of by tree-level
   // samples.
   bool allowIncompleteReal =
-    settingsPtr->flag("Merging:allowIncompleteHistoriesInReal");
+    allowIncompleteHistoriesInRealRef();
   if ( containsRealKin && !allowIncompleteReal
     && FullHistory.select(RN)->nClusterings() == 0 )
     return true;
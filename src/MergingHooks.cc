@@ -3423,7 +3423,7 @@ double MergingHooks::tmsNow( const Event& event ) {
 
   // Get merging scale in current event.
   double tnow = 0.;
-  int unlopsType = settingsPtr->mode("Merging:unlopsTMSdefinition");
+  int unlopsType = unlopsTMSdefinition();
   // Use KT/Durham merging scale definition.
   if ( doKTMerging()  || doMGMerging() )
     tnow = kTms(event);
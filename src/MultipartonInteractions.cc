@@ -13,6 +13,10 @@
 #include "Pythia8/SigmaEW.h"
 #include "Pythia8/SigmaOnia.h"
 
+// Stdlib headers for cache file handling.
+#include <cstdio>
+#include <ctime>
+
 namespace Pythia8 {
 
 //==========================================================================
@@ -349,6 +353,9 @@ const double MultipartonInteractions::WTACCWARN     = 1.1;
 // Limit below which scientific notation is used for printing.
 const double MultipartonInteractions::SIGMAMBLIMIT  = 1.;
 
+// Version of the format of the initialization cache files.
+const int    MultipartonInteractions::INITCACHEVERSION = 1;
+
 //--------------------------------------------------------------------------
 
 // Initialize the generation process for given beams.
@@ -606,8 +613,36 @@ bool MultipartonInteractions::init( bool doMPIinit, int iDiffSysIn,
     eStepSize   = log( eStepMax / eStepMin) / (nStep - 1.);
   }
 
+  // Optionally read initialization tables from cache instead of
+  // calculating them. Not for photoproduction with Pomerons, where the
+  // loop below leaves the total cross section in a different state.
+  string initCacheDir = settings.word("MultipartonInteractions:initCacheDir");
+  bool useInitCache   = (initCacheDir != "void" && initCacheDir != ""
+                      && !(hasPomeronBeams && hasGamma));
+  string initCacheName, initCacheKeyNow;
+  bool fromCache      = false;
+  if (useInitCache) {
+    initCacheKeyNow = initCacheKey(settings);
+    unsigned int hashA = 2166136261u;
+    unsigned int hashB = 84696351u;
+    for (int i = 0; i < int(initCacheKeyNow.size()); ++i) {
+      hashA = (hashA ^ (unsigned char)(initCacheKeyNow[i])) * 16777619u;
+      hashB = (hashB ^ (unsigned char)(initCacheKeyNow[i])) * 16777619u;
+    }
+    ostringstream osName;
+    osName << initCacheDir << ( (initCacheDir[initCacheDir.size() - 1]
+      == '/') ? "" : "/" ) << "mpi" << std::hex << std::setfill('0') << setw(8)
+      << hashA << setw(8) << hashB << ".cache";
+    initCacheName = osName.str();
+    fromCache = readInitCache( initCacheName, initCacheKeyNow, sigmaMaxViol);
+    if (fromCache && showMPI) cout << fixed << setprecision(2)
+      << " |    pT0 = " << setw(5) << pT0 << " gives sigmaInteraction = "
+      << setw(8) << ((sigmaInt > SIGMAMBLIMIT) ? fixed : scientific)
+      << sigmaInt << " mb: from cache  | \n";
+  }
+
   // Loop over masses for which to initialize generation.
-  for (int iStep = 0; iStep < nStep; ++iStep) {
+  for (int iStep = 0; iStep < nStep && !fromCache; ++iStep) {
     if (nStep > 1) {
       eCM = eStepMin * pow( eStepMax / eStepMin, iStep / (nStep - 1.) );
       sCM = eCM * eCM;
@@ -780,6 +815,10 @@ bool MultipartonInteractions::init( bool doMPIinit, int iDiffSysIn,
   beamAPtr->xPom();
   beamBPtr->xPom();
 
+  // Store newly calculated tables in the cache.
+  if (useInitCache && !fromCache)
+    writeInitCache( initCacheName, initCacheKeyNow, sigmaMaxViol);
+
   // Output details for x-dependent matter profile.
   if (bProfile == 4 && showMPI)
     cout << " |                                              "
@@ -2379,6 +2418,187 @@ void MultipartonInteractions::overlapInit() {
 
 //--------------------------------------------------------------------------
 
+// Collect all settings, beam properties and PDF values that could affect
+// the initialization tables into one string, used as cache key.
+
+string MultipartonInteractions::initCacheKey(Settings& settings) {
+
+  ostringstream os;
+  os << scientific << setprecision(17) << "version "
+     << settings.parm("Pythia:versionNumber") << " format "
+     << INITCACHEVERSION << " iDiffSys " << iDiffSys << " hasGamma "
+     << hasGamma << " idA " << beamAPtr->id() << " idB " << beamBPtr->id()
+     << " eCM " << infoPtr->eCM() << "\n";
+
+  // Settings of relevant groups, in alphabetical order.
+  const int nGroup = 12;
+  string groups[nGroup] = { "MultipartonInteractions:", "PhotonPhoton:",
+    "Diffraction:", "SigmaTotal:", "SigmaDiffractive:", "SigmaElastic:",
+    "PDF:", "Photon:", "StandardModel:", "Beams:", "TimeShower:globalRecoil",
+    "TimeShower:nMaxGlobalRecoil"};
+  for (int iGroup = 0; iGroup < nGroup; ++iGroup) {
+    map<string, Flag> flagMap = settings.getFlagMap(groups[iGroup]);
+    for (map<string, Flag>::iterator it = flagMap.begin();
+      it != flagMap.end(); ++it)
+      if (it->first.find("initcachedir") == string::npos)
+        os << it->first << " " << it->second.valNow << "\n";
+    map<string, Mode> modeMap = settings.getModeMap(groups[iGroup]);
+    for (map<string, Mode>::iterator it = modeMap.begin();
+      it != modeMap.end(); ++it)
+      os << it->first << " " << it->second.valNow << "\n";
+    map<string, Parm> parmMap = settings.getParmMap(groups[iGroup]);
+    for (map<string, Parm>::iterator it = parmMap.begin();
+      it != parmMap.end(); ++it)
+      os << it->first << " " << it->second.valNow << "\n";
+    map<string, Word> wordMap = settings.getWordMap(groups[iGroup]);
+    for (map<string, Word>::iterator it = wordMap.begin();
+      it != wordMap.end(); ++it)
+      if (it->first.find("initcachedir") == string::npos)
+        os << it->first << " " << it->second.valNow << "\n";
+  }
+
+  // Fingerprint of the actual PDFs, to catch externally provided ones.
+  const int nProbe = 4;
+  double xProbe[nProbe]  = { 1e-4, 1e-2, 0.1, 0.5};
+  double Q2Probe[nProbe] = { 2., 10., 100., 1e4};
+  for (int i = 0; i < nProbe; ++i)
+    os << "xf " << beamAPtr->xf( 21, xProbe[i], Q2Probe[i]) << " "
+       << beamAPtr->xf( 2, xProbe[i], Q2Probe[i]) << " "
+       << beamBPtr->xf( 21, xProbe[i], Q2Probe[i]) << " "
+       << beamBPtr->xf( 2, xProbe[i], Q2Probe[i]) << "\n";
+
+  return os.str();
+
+}
+
+//--------------------------------------------------------------------------
+
+// List of all quantities calculated by the initialization loop.
+
+void MultipartonInteractions::initCacheState(vector<double*>& stateVars,
+  double* sigmaMaxViolPtr) {
+
+  // Single values.
+  double* singles[] = { sigmaMaxViolPtr, &eCM, &sCM, &sigmaND, &pTmin, &pT0,
+    &pT20, &pT2min, &pTmax, &pT2max, &pT20R, &pT20minR, &pT20maxR,
+    &pT20min0maxR, &pT2maxmin, &pT4dSigmaMax, &pT4dProbMax, &sigmaInt,
+    &zeroIntCorr, &normOverlap, &nAvg, &kNow, &normPi, &bAvg, &bDiv,
+    &probLowB, &fracAhigh, &fracBhigh, &fracChigh, &fracABChigh, &cDiv,
+    &cMax, &enhanceBavg, &a0now, &a02now, &a2max, &bstepNow};
+  stateVars.resize(0);
+  for (int i = 0; i < int(sizeof(singles) / sizeof(double*)); ++i)
+    stateVars.push_back( singles[i] );
+  for (int j = 0; j <= 100; ++j) stateVars.push_back( &sudExpPT[j] );
+
+  // Tables for interpolation in energy or mass.
+  for (int iStep = 0; iStep < 20; ++iStep) {
+    double* steps[] = { &pT0Save[iStep], &pT4dSigmaMaxSave[iStep],
+      &pT4dProbMaxSave[iStep], &sigmaIntSave[iStep], &zeroIntCorrSave[iStep],
+      &normOverlapSave[iStep], &kNowSave[iStep], &bAvgSave[iStep],
+      &bDivSave[iStep], &probLowBSave[iStep], &fracAhighSave[iStep],
+      &fracBhighSave[iStep], &fracChighSave[iStep], &fracABChighSave[iStep],
+      &cDivSave[iStep], &cMaxSave[iStep]};
+    for (int i = 0; i < int(sizeof(steps) / sizeof(double*)); ++i)
+      stateVars.push_back( steps[i] );
+    for (int j = 0; j <= 100; ++j)
+      stateVars.push_back( &sudExpPTSave[iStep][j] );
+  }
+
+}
+
+//--------------------------------------------------------------------------
+
+// Read initialization tables from a binary cache file. Returns false,
+// with a warning, if the file was found but does not match.
+
+bool MultipartonInteractions::readInitCache(string fileName, string key,
+  double& sigmaMaxViol) {
+
+  // Open file; no message if not yet created.
+  ifstream ifs(fileName.c_str(), ios::binary);
+  if (!ifs.good()) return false;
+
+  // Check that the key stored in the file is the same.
+  int keySize = 0;
+  ifs.read((char *) &keySize, sizeof(int));
+  if (!ifs.good() || keySize != int(key.size())) {
+    infoPtr->errorMsg("Warning in MultipartonInteractions::readInitCache:"
+      " cache file mismatch, recalculating", fileName);
+    return false;
+  }
+  string keyFile(keySize, ' ');
+  if (keySize > 0) ifs.read(&keyFile[0], keySize);
+  if (!ifs.good() || keyFile != key) {
+    infoPtr->errorMsg("Warning in MultipartonInteractions::readInitCache:"
+      " cache file mismatch, recalculating", fileName);
+    return false;
+  }
+
+  // Read values into temporary storage, so a broken file changes nothing.
+  vector<double*> stateVars;
+  initCacheState( stateVars, &sigmaMaxViol);
+  int nState = 0;
+  ifs.read((char *) &nState, sizeof(int));
+  vector<double> values( max(0, nState) );
+  if (nState > 0) ifs.read((char *) &values[0], sizeof(double) * nState);
+  if (!ifs.good() || nState != int(stateVars.size())) {
+    infoPtr->errorMsg("Warning in MultipartonInteractions::readInitCache:"
+      " cache file corrupt, recalculating", fileName);
+    return false;
+  }
+  for (int i = 0; i < nState; ++i) *stateVars[i] = values[i];
+
+  // Restore information passed on during normal initialization.
+  if (bProfile == 4) infoPtr->seta0MPI(a0now * XDEP_SMB2FM);
+  return true;
+
+}
+
+//--------------------------------------------------------------------------
+
+// Write initialization tables to a binary cache file. A temporary file
+// is renamed at the end, so that simultaneous jobs do not clash.
+
+bool MultipartonInteractions::writeInitCache(string fileName, string key,
+  double sigmaMaxViol) {
+
+  // Open temporary file.
+  ostringstream osTmp;
+  osTmp << fileName << ".tmp" << this << "." << time(0);
+  string fileTmp = osTmp.str();
+  ofstream ofs(fileTmp.c_str(), ios::binary);
+  if (!ofs.good()) {
+    infoPtr->errorMsg("Warning in MultipartonInteractions::writeInitCache:"
+      " could not open cache file", fileName);
+    return false;
+  }
+
+  // Write key and values.
+  vector<double*> stateVars;
+  initCacheState( stateVars, &sigmaMaxViol);
+  int keySize = key.size();
+  int nState  = stateVars.size();
+  vector<double> values(nState);
+  for (int i = 0; i < nState; ++i) values[i] = *stateVars[i];
+  ofs.write((char *) &keySize, sizeof(int));
+  ofs.write(key.c_str(), keySize);
+  ofs.write((char *) &nState, sizeof(int));
+  ofs.write((char *) &values[0], sizeof(double) * nState);
+  ofs.close();
+
+  // Move into place.
+  if (!ofs.good() || rename( fileTmp.c_str(), fileName.c_str()) != 0) {
+    remove( fileTmp.c_str() );
+    infoPtr->errorMsg("Warning in MultipartonInteractions::writeInitCache:"
+      " could not write cache file", fileName);
+    return false;
+  }
+  return true;
+
+}
+
+//--------------------------------------------------------------------------
+
 // Pick impact parameter and interaction rate enhancement beforehand,
 // i.e. before even the hardest interaction for minimum-bias events.
 
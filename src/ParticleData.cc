@@ -600,6 +600,81 @@ void ParticleDataEntry::setConstituentMass() {
 
 //--------------------------------------------------------------------------
 
+// Constants: could be changed here if desired, but normally should not.
+// These are of technical nature, as described for each.
+
+// Multiplier 2^32 / golden ratio, used to hash identity codes.
+const unsigned int ParticleData::INDEXHASH = 2654435769u;
+
+// Minimal size of the hash index, and maximal fraction of it filled.
+const int    ParticleData::INDEXMINSIZE = 64;
+const double ParticleData::INDEXMAXLOAD = 0.5;
+
+//--------------------------------------------------------------------------
+
+// Add an existing entry of the map to the hash index.
+// Grow the index by a rebuild when it becomes too densely filled.
+
+void ParticleData::indexParticle(int idAbs) {
+
+  // Step through the slots until the code or an empty slot is found.
+  map<int, ParticleDataEntry>::iterator found = pdt.find(idAbs);
+  if (found == pdt.end()) return;
+  int slot = int( (static_cast<unsigned int>(idAbs) * INDEXHASH)
+    >> indexShift );
+  for ( ; ; slot = (slot + 1) & indexMask) {
+    if (idIndex[slot] == idAbs) {
+      ptrIndex[slot] = &found->second;
+      return;
+    }
+    if (idIndex[slot] < 0) break;
+  }
+
+  // Rebuild if the index would become too full, else fill empty slot.
+  if (nIndexed + 1 > INDEXMAXLOAD * idIndex.size()) {
+    rebuildIndex();
+    return;
+  }
+  idIndex[slot]  = idAbs;
+  ptrIndex[slot] = &found->second;
+  ++nIndexed;
+
+}
+
+//--------------------------------------------------------------------------
+
+// Rebuild the hash index from scratch for the current content of the map.
+// Required after entries have been erased, or the map has been copied.
+
+void ParticleData::rebuildIndex() {
+
+  // Smallest power of two that keeps the index below maximal load.
+  int nSize = 1;
+  indexShift = 32;
+  while (nSize < INDEXMINSIZE || pdt.size() + 1 > INDEXMAXLOAD * nSize) {
+    nSize *= 2;
+    --indexShift;
+  }
+  indexMask = nSize - 1;
+  idIndex.assign( nSize, -1);
+  ptrIndex.assign( nSize, (ParticleDataEntry*)0);
+  nIndexed = 0;
+
+  // Insert all entries, with linear probing on collisions.
+  for (map<int, ParticleDataEntry>::iterator pdtEntry = pdt.begin();
+    pdtEntry != pdt.end(); ++pdtEntry) {
+    int slot = int( (static_cast<unsigned int>(pdtEntry->first) * INDEXHASH)
+      >> indexShift );
+    while (idIndex[slot] >= 0) slot = (slot + 1) & indexMask;
+    idIndex[slot]  = pdtEntry->first;
+    ptrIndex[slot] = &pdtEntry->second;
+    ++nIndexed;
+  }
+
+}
+
+//--------------------------------------------------------------------------
+
 // Get data to be distributed among particles during setup.
 // Note: this routine is called twice. Firstly from init(...), but
 // the data should not be used at that point, so is likely overkill.
@@ -854,6 +929,10 @@ void ParticleData::initWidths( vector<ResonanceWidths*> resonancePtrs) {
     pdtPtrNow->initBWmass();
   }
 
+  // Optionally tabulate widths, once all resonances are initialized.
+  for (int i = 0; i < int(idOrdered.size()); ++i)
+    particleDataEntryPtr( idOrdered[i])->getResonancePtr()->initTables();
+
 }
 
 //--------------------------------------------------------------------------
@@ -896,6 +975,7 @@ bool ParticleData::copyXML(const ParticleData &particleDataIn) {
 
   // First Reset everything.
   pdt.clear();
+  rebuildIndex();
   xmlFileSav.clear();
   readStringHistory.resize(0);
   readStringSubrun.clear();
@@ -917,6 +997,7 @@ bool ParticleData::loadXML(istream& is, bool reset) {
   // Normally reset whole database before beginning.
   if (reset) {
     pdt.clear();
+    rebuildIndex();
     xmlFileSav.clear();
     readStringHistory.resize(0);
     readStringSubrun.clear();
@@ -1014,7 +1095,10 @@ bool ParticleData::processXML(bool reset) {
       double tau0Tmp     = doubleAttributeValue( line, "tau0");
 
       // Erase if particle already exists.
-      if (isParticle(idTmp)) pdt.erase(idTmp);
+      if (isParticle(idTmp)) {
+        pdt.erase(idTmp);
+        rebuildIndex();
+      }
 
       // Store new particle. Save pointer, to be used for decay channels.
       addParticle( idTmp, nameTmp, antiNameTmp, spinTypeTmp, chargeTypeTmp,
@@ -1149,6 +1233,7 @@ bool ParticleData::readFF(istream& is, bool reset) {
   // Normally reset whole database before beginning.
   if (reset) {
     pdt.clear();
+    rebuildIndex();
     readStringHistory.resize(0);
     readStringSubrun.clear();
     isInit = false;
@@ -1198,7 +1283,10 @@ bool ParticleData::readFF(istream& is, bool reset) {
       }
 
       // Erase if particle already exists.
-      if (isParticle(idTmp)) pdt.erase(idTmp);
+      if (isParticle(idTmp)) {
+        pdt.erase(idTmp);
+        rebuildIndex();
+      }
 
       // Store new particle. Save pointer, to be used for decay channels.
       addParticle( idTmp, nameTmp, antiNameTmp, spinTypeTmp, chargeTypeTmp,
@@ -1315,6 +1403,162 @@ void ParticleData::listFF(string outFile) {
 
 //--------------------------------------------------------------------------
 
+// Write the complete database in binary form, in numerical order,
+// including the current state of all decay channels.
+
+bool ParticleData::writeSnapshot(ostream& os) {
+
+  SnapshotWriter out(os);
+  out.write( int(pdt.size()));
+  for (map<int, ParticleDataEntry>::iterator pdtEntry = pdt.begin();
+    pdtEntry != pdt.end(); ++pdtEntry) {
+    const ParticleDataEntry& entry = pdtEntry->second;
+
+    // Particle properties.
+    out.write( entry.idSave);
+    out.write( entry.nameSave);
+    out.write( entry.antiNameSave);
+    out.write( entry.spinTypeSave);
+    out.write( entry.chargeTypeSave);
+    out.write( entry.colTypeSave);
+    out.write( entry.m0Save);
+    out.write( entry.mWidthSave);
+    out.write( entry.mMinSave);
+    out.write( entry.mMaxSave);
+    out.write( entry.tau0Save);
+    out.write( entry.constituentMassSave);
+    out.write( entry.hasAntiSave);
+    out.write( entry.isResonanceSave);
+    out.write( entry.mayDecaySave);
+    out.write( entry.doExternalDecaySave);
+    out.write( entry.isVisibleSave);
+    out.write( entry.doForceWidthSave);
+    out.write( entry.hasChangedSave);
+    out.write( entry.hasChangedMMinSave);
+    out.write( entry.hasChangedMMaxSave);
+    out.write( entry.modeBWnow);
+    out.write( entry.modeTau0now);
+    out.write( entry.atanLow);
+    out.write( entry.atanDif);
+    out.write( entry.mThr);
+    out.write( entry.currentBRSum);
+
+    // Decay channels.
+    out.write( int(entry.channels.size()));
+    for (int i = 0; i < int(entry.channels.size()); ++i) {
+      const DecayChannel& channel = entry.channels[i];
+      out.write( channel.onMode());
+      out.write( channel.bRatio());
+      out.write( channel.currentBR());
+      out.write( channel.onShellWidth());
+      out.write( channel.openSec(1));
+      out.write( channel.openSec(-1));
+      out.write( channel.meMode());
+      out.write( channel.multiplicity());
+      for (int j = 0; j < channel.multiplicity(); ++j)
+        out.write( channel.product(j));
+      out.write( channel.hasChanged());
+    }
+  }
+
+  // Done.
+  return out.good();
+}
+
+//--------------------------------------------------------------------------
+
+// Read the complete database in binary form, as written by writeSnapshot.
+
+bool ParticleData::readSnapshot(istream& is) {
+
+  // Reset whole database, and set common data from Settings.
+  initCommon();
+  pdt.clear();
+  xmlFileSav.clear();
+  readStringHistory.resize(0);
+  readStringSubrun.clear();
+  isInit = false;
+  SnapshotReader in(is);
+  int nParticle;
+  if (!in.read(nParticle)) {
+    rebuildIndex();
+    return false;
+  }
+
+  // Particles come in order, so each is inserted at the end of the map.
+  bool isOK = true;
+  for (int iPart = 0; iPart < nParticle && isOK; ++iPart) {
+    int idTmp;
+    if (!in.read(idTmp)) {
+      isOK = false;
+      break;
+    }
+    ParticleDataEntry& entry = pdt.insert( pdt.end(),
+      make_pair( idTmp, ParticleDataEntry( idTmp)))->second;
+    entry.initPtr(this);
+
+    // Particle properties.
+    isOK = in.read(entry.nameSave) && in.read(entry.antiNameSave)
+      && in.read(entry.spinTypeSave) && in.read(entry.chargeTypeSave)
+      && in.read(entry.colTypeSave) && in.read(entry.m0Save)
+      && in.read(entry.mWidthSave) && in.read(entry.mMinSave)
+      && in.read(entry.mMaxSave) && in.read(entry.tau0Save)
+      && in.read(entry.constituentMassSave) && in.read(entry.hasAntiSave)
+      && in.read(entry.isResonanceSave) && in.read(entry.mayDecaySave)
+      && in.read(entry.doExternalDecaySave) && in.read(entry.isVisibleSave)
+      && in.read(entry.doForceWidthSave) && in.read(entry.hasChangedSave)
+      && in.read(entry.hasChangedMMinSave)
+      && in.read(entry.hasChangedMMaxSave) && in.read(entry.modeBWnow)
+      && in.read(entry.modeTau0now) && in.read(entry.atanLow)
+      && in.read(entry.atanDif) && in.read(entry.mThr)
+      && in.read(entry.currentBRSum);
+
+    // Decay channels.
+    int nChannel = 0;
+    if (!isOK || !in.read(nChannel)) {
+      isOK = false;
+      break;
+    }
+    entry.channels.resize( nChannel);
+    for (int i = 0; i < nChannel && isOK; ++i) {
+      int onMode, meMode, mult;
+      double bRatio, currentBR, onShellWidth, openSecPos, openSecNeg;
+      int prod[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+      bool hasChanged;
+      isOK = in.read(onMode) && in.read(bRatio) && in.read(currentBR)
+        && in.read(onShellWidth) && in.read(openSecPos)
+        && in.read(openSecNeg) && in.read(meMode) && in.read(mult)
+        && mult >= 0 && mult <= 8;
+      for (int j = 0; j < mult && isOK; ++j) isOK = in.read(prod[j]);
+      if (!isOK || !in.read(hasChanged)) {
+        isOK = false;
+        break;
+      }
+      DecayChannel& channel = entry.channels[i];
+      channel = DecayChannel( onMode, bRatio, meMode, prod[0], prod[1],
+        prod[2], prod[3], prod[4], prod[5], prod[6], prod[7]);
+      channel.currentBR( currentBR);
+      channel.onShellWidth( onShellWidth);
+      channel.openSec( 1, openSecPos);
+      channel.openSec( -1, openSecNeg);
+      channel.multiplicity( mult);
+      channel.setHasChanged( hasChanged);
+    }
+  }
+
+  // Done.
+  rebuildIndex();
+  if (!isOK) {
+    pdt.clear();
+    rebuildIndex();
+    return false;
+  }
+  isInit = true;
+  return true;
+}
+
+//--------------------------------------------------------------------------
+
 // Read in updates from a character string, like a line of a file.
 // Is used by readString (and readFile) in Pythia.
 
@@ -1487,7 +1731,10 @@ void ParticleData::listFF(string outFile) {
 
     // Else start over completely from scratch.
     } else {
-      if (isParticle(idTmp)) pdt.erase(idTmp);
+      if (isParticle(idTmp)) {
+        pdt.erase(idTmp);
+        rebuildIndex();
+      }
       addParticle( idTmp, nameTmp, antiNameTmp, spinTypeTmp, chargeTypeTmp,
         colTypeTmp, m0Tmp, mWidthTmp, mMinTmp, mMaxTmp, tau0Tmp);
     }
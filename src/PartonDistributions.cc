@@ -299,6 +299,63 @@ double PDF::xfSea(int id, double x, double Q2) {
 
 }
 
+//--------------------------------------------------------------------------
+
+// Parton densities for a batch of flavours and (x, Q2) points.
+// Default is to evaluate them one by one.
+
+void PDF::xfBatch(const vector<int>& ids, const vector<double>& xVec,
+  const vector<double>& Q2Vec, vector<double>& xfVec) {
+
+  xfVec.resize(ids.size());
+  for (int i = 0; i < int(ids.size()); ++i)
+    xfVec[i] = xf( ids[i], xVec[i], Q2Vec[i]);
+
+}
+
+//--------------------------------------------------------------------------
+
+// Find which of the stored densities that xf would return for a flavour:
+// 0 = xg, 1 = xd, 2 = xdbar, 3 = xu, 4 = xubar, 5 = xs, 6 = xsbar,
+// 7 = xc, 8 = xb, 9 = xgamma, 10 = none. Only for p, n, pi+ and pi-
+// beams and their antiparticles; else -1.
+
+int PDF::xfQuantity(int id) const {
+
+  // Flavour as seen by a particle beam.
+  if (idBeamAbs != 2212 && idBeamAbs != 2112 && idBeamAbs != 211) return -1;
+  int idNow = (idBeam > 0) ? id : -id;
+  int idAbs = abs(id);
+
+  // Common part: gluon and heavier flavours.
+  if (idNow ==  0 || idAbs == 21) return 0;
+  if (idNow ==  3) return 5;
+  if (idNow == -3) return 6;
+  if (idAbs ==  4) return 7;
+  if (idAbs ==  5) return 8;
+  if (idAbs == 22) return 9;
+
+  // Proton, neutron by isospin conjugation, and pi+ with dbar = u.
+  if (idBeamAbs == 2212) {
+    if (idNow ==  1) return 1;
+    if (idNow == -1) return 2;
+    if (idNow ==  2) return 3;
+    if (idNow == -2) return 4;
+  } else if (idBeamAbs == 2112) {
+    if (idNow ==  1) return 3;
+    if (idNow == -1) return 4;
+    if (idNow ==  2) return 1;
+    if (idNow == -2) return 2;
+  } else {
+    if (idNow ==  1) return 4;
+    if (idNow == -1) return 3;
+    if (idNow ==  2) return 3;
+    if (idNow == -2) return 4;
+  }
+  return 10;
+
+}
+
 //==========================================================================
 
 // Gives the GRV 94 L (leading order) parton distribution function set
@@ -1025,6 +1082,53 @@ void MSTWpdf::xfUpdate(int , double x, double Q2) {
 
 //--------------------------------------------------------------------------
 
+// Batch of PDF values. Only the MSTW partons needed for each flavour
+// are evaluated, combined in the same way as in xfUpdate. Points shared
+// by several flavours instead use the full update in xf.
+
+void MSTWpdf::xfBatch(const vector<int>& ids, const vector<double>& xVec,
+  const vector<double>& Q2Vec, vector<double>& xfVec) {
+
+  // Only beams with a known flavour mapping.
+  if (xfQuantity(21) < 0) {
+    PDF::xfBatch( ids, xVec, Q2Vec, xfVec);
+    return;
+  }
+
+  xfVec.resize(ids.size());
+  for (int i = 0; i < int(ids.size()); ++i) {
+
+    // Several flavours at the same point: xf finds all of them at once.
+    if (isSharedPoint( i, xVec, Q2Vec)) {
+      xfVec[i] = xf( ids[i], xVec[i], Q2Vec[i]);
+      continue;
+    }
+
+    // Else only evaluate the partons needed.
+    double x = xVec[i];
+    double q = sqrtpos(Q2Vec[i]);
+    double xfNow = 0.;
+    switch (xfQuantity(ids[i])) {
+    case 0: xfNow = parton( 0, x, q); break;
+    case 1: xfNow = parton( 1, x, q); break;
+    case 2: xfNow = parton( 1, x, q) - parton( 7, x, q); break;
+    case 3: xfNow = parton( 2, x, q); break;
+    case 4: xfNow = parton( 2, x, q) - parton( 8, x, q); break;
+    case 5: xfNow = parton( 3, x, q); break;
+    case 6: xfNow = parton( 3, x, q) - parton( 9, x, q); break;
+    case 7: { double chm = parton( 4, x, q);
+      xfNow = 0.5 * (chm + (chm - parton(10, x, q))); break; }
+    case 8: { double bot = parton( 5, x, q);
+      xfNow = 0.5 * (bot + (bot - parton(11, x, q))); break; }
+    case 9: xfNow = parton(13, x, q); break;
+    }
+    xfVec[i] = max(0., xfNow);
+  }
+
+}
+
+//--------------------------------------------------------------------------
+
 // Returns the PDF value for parton of flavour 'f' at x,q.
 
 double MSTWpdf::parton(int f,double x,double q) {
@@ -1498,6 +1602,57 @@ void CTEQ6pdf::xfUpdate(int , double x, double Q2) {
 
 //--------------------------------------------------------------------------
 
+// Batch of PDF values. Only the CTEQ6 partons needed for each flavour
+// are evaluated, combined in the same way as in xfUpdate. Points shared
+// by several flavours instead use the full update in xf.
+
+void CTEQ6pdf::xfBatch(const vector<int>& ids, const vector<double>& xVec,
+  const vector<double>& Q2Vec, vector<double>& xfVec) {
+
+  // Only beams with a known flavour mapping.
+  if (xfQuantity(21) < 0) {
+    PDF::xfBatch( ids, xVec, Q2Vec, xfVec);
+    return;
+  }
+  if (iFit < 10) rescale = 1.;
+
+  xfVec.resize(ids.size());
+  for (int i = 0; i < int(ids.size()); ++i) {
+
+    // Several flavours at the same point: xf finds all of them at once.
+    if (isSharedPoint( i, xVec, Q2Vec)) {
+      xfVec[i] = xf( ids[i], xVec[i], Q2Vec[i]);
+      continue;
+    }
+
+    // Else only evaluate the partons needed.
+    double xEps = doExtraPol ? xVec[i] : max( xMinEps, xVec[i]);
+    double qEps = max( qMinEps, min( qMaxEps, sqrtpos(Q2Vec[i]) ) );
+    double xfNow = 0.;
+    switch (xfQuantity(ids[i])) {
+    case 0: xfNow = rescale * (xEps * parton6( 0, xEps, qEps)); break;
+    case 1: { double dsea = xEps * parton6(-2, xEps, qEps);
+      double dnv = xEps * parton6( 2, xEps, qEps) - dsea;
+      xfNow = rescale * (dnv + dsea); break; }
+    case 2: xfNow = rescale * (xEps * parton6(-2, xEps, qEps)); break;
+    case 3: { double usea = xEps * parton6(-1, xEps, qEps);
+      double upv = xEps * parton6( 1, xEps, qEps) - usea;
+      xfNow = rescale * (upv + usea); break; }
+    case 4: xfNow = rescale * (xEps * parton6(-1, xEps, qEps)); break;
+    case 5:
+    case 6: xfNow = rescale * (xEps * parton6( 3, xEps, qEps)); break;
+    case 7: if (iFit <= 10) xfNow = rescale
+      * (xEps * parton6( 4, xEps, qEps)); break;
+    case 8: if (iFit <= 10) xfNow = rescale
+      * (xEps * parton6( 5, xEps, qEps)); break;
+    }
+    xfVec[i] = max(0., xfNow);
+  }
+
+}
+
+//--------------------------------------------------------------------------
+
 // Returns the PDF value for parton of flavour iParton at x, q.
 
 double CTEQ6pdf::parton6(int iParton, double x, double q) {
@@ -3546,19 +3701,98 @@ void LHAGrid1::xfUpdate(int , double x, double Q2) {
 
 void LHAGrid1::xfxevolve(double x, double Q2) {
 
+  // Find location in grid. Keep old values above the x range.
+  GridPoint pt;
+  xfxLocate( x, Q2, pt);
+  if (pt.inx == 1) return;
+
+  // Interpolate for each flavour in turn.
+  for (int iid = 0; iid < 12; ++iid) pdfVal[iid] = xfxInterpolate( iid, x, pt);
+
+}
+
+//--------------------------------------------------------------------------
+
+// Batch of PDF values. The grid location and interpolation weights are
+// found for each (x, Q2) point, and then only the grids needed for the
+// requested flavour are interpolated, combined as in xfUpdate. Points
+// shared by several flavours instead use the full update in xf.
+
+void LHAGrid1::xfBatch(const vector<int>& ids, const vector<double>& xVec,
+  const vector<double>& Q2Vec, vector<double>& xfVec) {
+
+  // Only beams with a known flavour mapping.
+  if (!isSet || xfQuantity(21) < 0) {
+    PDF::xfBatch( ids, xVec, Q2Vec, xfVec);
+    return;
+  }
+
+  xfVec.resize(ids.size());
+  GridPoint pt;
+  for (int i = 0; i < int(ids.size()); ++i) {
+
+    // Several flavours at the same point: xf finds all of them at once.
+    if (isSharedPoint( i, xVec, Q2Vec)) {
+      xfVec[i] = xf( ids[i], xVec[i], Q2Vec[i]);
+      continue;
+    }
+    double x  = xVec[i];
+    int    iQ = xfQuantity(ids[i]);
+    if (iQ == 10) {
+      xfVec[i] = 0.;
+      continue;
+    }
+
+    // Location in grid. Above the x range xf keeps the latest values,
+    // so then use it directly.
+    xfxLocate( x, Q2Vec[i], pt);
+    if (pt.inx == 1) {
+      xfVec[i] = xf( ids[i], x, Q2Vec[i]);
+      continue;
+    }
+
+    // Interpolate the relevant grids.
+    double xfNow = 0.;
+    switch (iQ) {
+    case 0: xfNow = xfxInterpolate(  0, x, pt); break;
+    case 1: xfNow = xfxInterpolate(  1, x, pt); break;
+    case 2: xfNow = xfxInterpolate(  6, x, pt); break;
+    case 3: xfNow = xfxInterpolate(  2, x, pt); break;
+    case 4: xfNow = xfxInterpolate(  7, x, pt); break;
+    case 5: xfNow = xfxInterpolate(  3, x, pt); break;
+    case 6: xfNow = xfxInterpolate(  8, x, pt); break;
+    case 7: xfNow = 0.5 * (xfxInterpolate( 4, x, pt)
+      + xfxInterpolate(  9, x, pt)); break;
+    case 8: xfNow = 0.5 * (xfxInterpolate( 5, x, pt)
+      + xfxInterpolate( 10, x, pt)); break;
+    case 9: xfNow = xfxInterpolate( 11, x, pt); break;
+    }
+    xfVec[i] = max(0., xfNow);
+  }
+
+}
+
+//--------------------------------------------------------------------------
+
+// Find the location of an (x, Q2) point in the grid, and the weights
+// for interpolation.
+
+void LHAGrid1::xfxLocate(double x, double Q2, GridPoint& pt) {
+
   // Find if (x, Q) inside our outside grid.
   double q = sqrt(Q2);
-  int inx  = (x <= xMin) ? -1 : ((x >= xMax) ? 1 : 0);
+  pt.inx   = (x <= xMin) ? -1 : ((x >= xMax) ? 1 : 0);
   int inq  = (q <= qMin) ? -1 : ((q >= qMax) ? 1 : 0);
 
   // Set up default for x interpolation.
   int    minx  = 0;
   int    maxx  = nx - 1;
-  int    m3x   = 0;
-  double wx[4] = {1., 1., 1., 1.};
+  pt.m3x       = 0;
+  double* wx   = pt.wx;
+  for (int i3 = 0; i3 < 4; ++i3) wx[i3] = 1.;
 
   // Find grid value on either side of x.
-  if (inx == 0) {
+  if (pt.inx == 0) {
     int midx;
     while (maxx - minx > 1) {
       midx = (minx + maxx) / 2;
@@ -3568,12 +3802,14 @@ void LHAGrid1::xfxevolve(double x, double Q2) {
 
     // Weights for cubic interpolation in ln(x).
     double lnx = log(x);
+    int    m3x = 0;
     if      (minx == 0)      m3x = 0;
     else if (maxx == nx - 1) m3x = nx - 4;
     else                     m3x = minx - 1;
     for (int i3 = 0; i3 < 4; ++i3)
     for (int j = 0; j < 4; ++j) if (j != i3)
       wx[i3] *= (lnx - lnxGrid[m3x+j]) / (lnxGrid[m3x+i3] - lnxGrid[m3x+j]);
+    pt.m3x = m3x;
   }
 
   // Find q subgrid and set up default for q interpolation.
@@ -3585,8 +3821,9 @@ void LHAGrid1::xfxevolve(double x, double Q2) {
   int    minq  = minS;
   int    maxq  = maxS;
   int    n3q   = 4;
-  int    m3q   = 0.;
-  double wq[4] = {1., 1., 1., 1.};
+  int    m3q   = 0;
+  double* wq   = pt.wq;
+  for (int i3 = 0; i3 < 4; ++i3) wq[i3] = 1.;
 
   // Find grid value on either side of q.
   if (inq == 0) {
@@ -3618,33 +3855,41 @@ void LHAGrid1::xfxevolve(double x, double Q2) {
     n3q = 1;
     if (inq == 1) m3q = nq - 1;
   }
+  pt.n3q = n3q;
+  pt.m3q = m3q;
+
+}
+
+//--------------------------------------------------------------------------
+
+// Interpolate between grid elements for one flavour, normally bicubic,
+// or simpler in ln(q). Not to be used above the x range.
 
-  // Interpolate between grid elements, normally bicubic, or simpler in ln(q).
-  if (inx == 0) {
-    for (int iid = 0; iid < 12; ++iid)
+double LHAGrid1::xfxInterpolate(int iid, double x, const GridPoint& pt) {
+
+  // Interpolation inside the x range.
+  const double* wx = pt.wx;
+  const double* wq = pt.wq;
+  if (pt.inx == 0) {
+    double **ppdf = pdfGrid[iid] + pt.m3q;
+    double sum0 = 0;
+    for (int i3q = 0; i3q < pt.n3q; ++i3q)
     {
-      double **ppdf = pdfGrid[iid] + m3q;
-      double sum0 = 0;
-      for (int i3q = 0; i3q < n3q; ++i3q)
-      {
-        double *pdf = ppdf[i3q] + m3x;
-        sum0 +=  wq[i3q] * (wx[0] * pdf[0] +
-                            wx[1] * pdf[1] +
-                            wx[2] * pdf[2] +
-                            wx[3] * pdf[3]  );
-      }
-      pdfVal[iid] = sum0;
+      double *pdf = ppdf[i3q] + pt.m3x;
+      sum0 +=  wq[i3q] * (wx[0] * pdf[0] +
+                          wx[1] * pdf[1] +
+                          wx[2] * pdf[2] +
+                          wx[3] * pdf[3]  );
     }
+    return sum0;
+  }
 
   // Special: extrapolate to small x. (Let vanish at large x, so no such code.)
-  } else if (inx == -1) {
-    for (int iid = 0; iid < 12; ++iid){
-      pdfVal[iid] = 0;
-    for (int i3q = 0; i3q < n3q; ++i3q)
-      pdfVal[iid] += wq[i3q] * pdfGrid[iid][m3q+i3q][0]
-        * (doExtraPol ? pow( x / xMin, pdfSlope[iid][m3q+i3q]) : 1.);
-    }
-  }
+  double sum0 = 0;
+  for (int i3q = 0; i3q < pt.n3q; ++i3q)
+    sum0 += wq[i3q] * pdfGrid[iid][pt.m3q+i3q][0]
+      * (doExtraPol ? pow( x / xMin, pdfSlope[iid][pt.m3q+i3q]) : 1.);
+  return sum0;
 
 }
 
@@ -1089,7 +1089,7 @@ bool PartonLevel::next( Event& process, Event& event) {
 
   // Do colour reconnection for non-diffractive events before resonance decays.
   if (doReconnect && !doDiffCR && reconnectMode > 0) {
-    Event eventSave = event;
+    eventSave = event;
     bool colCorrect = false;
     for (int i = 0; i < 10; ++i) {
       colourReconnection.next(event, 0);
@@ -1135,7 +1135,7 @@ bool PartonLevel::next( Event& process, Event& event) {
   // Do colour reconnection for resonance decays.
   if (!earlyResDec && forceResonanceCR && doReconnect &&
       !doDiffCR && reconnectMode != 0) {
-    Event eventSave = event;
+    eventSave = event;
     bool colCorrect = false;
     for (int i = 0; i < 10; ++i) {
       colourReconnection.next(event, oldSizeEvt);
@@ -1777,13 +1777,11 @@ void PartonLevel::leaveResolvedDiff( int iHardLoop, Event& process,
   MtoCM.fromCMframe( pDiffA, pDiffB);
 
   // Perform rotation and boost on diffractive system.
-  for (int i = sizeProcess; i < process.size(); ++i)
-    process[i].rotbst( MtoCM);
+  process.rotbst( MtoCM, sizeProcess, process.size());
   int iFirst = (iHardLoop == 1) ? 5 + sizeEvent - sizeProcess + gammaOffset
     : sizeEvent;
   if (isDiffC) iFirst = 6 + sizeEvent - sizeProcess;
-  for (int i = iFirst; i < event.size(); ++i)
-    event[i].rotbst( MtoCM);
+  event.rotbst( MtoCM, iFirst, event.size());
 
   // Restore cm energy.
   infoPtr->setECM( eCMsave);
@@ -2037,10 +2035,8 @@ void PartonLevel::leaveHardDiff( Event& process, Event& event,
     MtoCM.fromCMframe( pDiffA, pDiffB);
 
     // Perform rotation and boost on diffractive system.
-    for (int i = 5 + gammaOffset; i < process.size(); ++i)
-      process[i].rotbst( MtoCM);
-    for (int i = 5 + gammaOffset; i < event.size(); ++i)
-      event[i].rotbst( MtoCM);
+    process.rotbst( MtoCM, 5 + gammaOffset, process.size());
+    event.rotbst( MtoCM, 5 + gammaOffset, event.size());
 
     // Reset beam energies.
     beamAPtr->newPzE( event[1 + gammaOffset].pz(), event[1 + gammaOffset].e());
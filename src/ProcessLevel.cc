@@ -3,7 +3,8 @@
 // PYTHIA is licenced under the GNU GPL v2 or later, see COPYING for details.
 // Please respect the MCnet Guidelines, see GUIDELINES for details.
 
-// Function definitions (not found in the header) for the ProcessLevel class.
+// Function definitions (not found in the header) for the ProcessSelector
+// and ProcessLevel classes.
 
 #include "Pythia8/ProcessLevel.h"
 
@@ -11,6 +12,95 @@ namespace Pythia8 {
 
 //==========================================================================
 
+// The ProcessSelector class.
+
+//--------------------------------------------------------------------------
+
+// Set up from the current maxima of the containers.
+
+void ProcessSelector::init(vector<ProcessContainer*>& containerPtrs) {
+
+  // Store maxima, and check whether any is negative.
+  nSize   = containerPtrs.size();
+  useTree = true;
+  sigmaMaxs.resize(nSize);
+  for (int i = 0; i < nSize; ++i) {
+    sigmaMaxs[i] = containerPtrs[i]->sigmaMax();
+    if (sigmaMaxs[i] < 0.) useTree = false;
+  }
+
+  // Build the Fenwick tree in linear time.
+  tree.assign(nSize + 1, 0.);
+  for (int j = 1; j <= nSize; ++j) {
+    tree[j] += sigmaMaxs[j - 1];
+    int jUp  = j + (j & -j);
+    if (jUp <= nSize) tree[jUp] += tree[j];
+  }
+  nHigh = 1;
+  while (2 * nHigh <= nSize) nHigh *= 2;
+
+  // Sum of maxima, in the same order as the linear search.
+  sumNow = 0.;
+  for (int i = 0; i < nSize; ++i) sumNow += sigmaMaxs[i];
+
+}
+
+//--------------------------------------------------------------------------
+
+// Update the maximum of a single container.
+
+void ProcessSelector::update(int i, double sigmaMaxIn) {
+
+  // Propagate the change up through the tree.
+  double delta = sigmaMaxIn - sigmaMaxs[i];
+  sigmaMaxs[i] = sigmaMaxIn;
+  if (sigmaMaxIn < 0.) useTree = false;
+  for (int j = i + 1; j <= nSize; j += (j & -j)) tree[j] += delta;
+
+  // New sum of maxima from the tree, or else by explicit summation.
+  if (useTree) {
+    sumNow = 0.;
+    for (int j = nSize; j > 0; j -= (j & -j)) sumNow += tree[j];
+  } else {
+    sumNow = 0.;
+    for (int k = 0; k < nSize; ++k) sumNow += sigmaMaxs[k];
+  }
+
+}
+
+//--------------------------------------------------------------------------
+
+// Pick a container, given a random number in the range [0, 1).
+// Both methods return the first container where the running sum of
+// maxima reaches the random fraction of the total.
+
+int ProcessSelector::pick(double rndmIn) const {
+
+  // Linear search.
+  double sigmaMaxNow = sumNow * rndmIn;
+  if (!useTree) {
+    int iMax = nSize - 1;
+    int iNow = -1;
+    do sigmaMaxNow -= sigmaMaxs[++iNow];
+    while (sigmaMaxNow > 0. && iNow < iMax);
+    return iNow;
+  }
+
+  // Descend the tree to the last position with running sum below target.
+  int iNow = 0;
+  for (int step = nHigh; step > 0; step /= 2) {
+    int iNext = iNow + step;
+    if (iNext <= nSize && tree[iNext] < sigmaMaxNow) {
+      iNow         = iNext;
+      sigmaMaxNow -= tree[iNext];
+    }
+  }
+  return min( iNow, nSize - 1);
+
+}
+
+//==========================================================================
+
 // The ProcessLevel class.
 
 //--------------------------------------------------------------------------
@@ -214,9 +304,11 @@ bool ProcessLevel::init( Info* infoPtrIn, Settings& settings,
       ++numberOn;
 
   // Sum maxima for Monte Carlo choice.
-  sigmaMaxSum = 0.;
-  for (int i = 0; i < int(containerPtrs.size()); ++i)
-    sigmaMaxSum += containerPtrs[i]->sigmaMax();
+  selector.init(containerPtrs);
+  sigmaMaxSum = selector.sum();
+  nPick       = 0;
+  nPickAcc    = 0;
+  nMaxUpdate  = 0;
 
   // Option to pick a second hard interaction: repeat as above.
   int number2On = 0;
@@ -233,9 +325,8 @@ bool ProcessLevel::init( Info* infoPtrIn, Settings& settings,
         &resonanceDecays, slhaInterfacePtr, userHooksPtr, &gammaKin))
         ++number2On;
 
-    sigma2MaxSum = 0.;
-    for (int i2 = 0; i2 < int(container2Ptrs.size()); ++i2)
-      sigma2MaxSum += container2Ptrs[i2]->sigmaMax();
+    selector2.init(container2Ptrs);
+    sigma2MaxSum = selector2.sum();
   }
 
   // Check whether to create event weight from components.
@@ -610,12 +701,60 @@ void ProcessLevel::statistics(bool reset) {
 
 //--------------------------------------------------------------------------
 
+// Print statistics on the selection between subprocesses, i.e. how
+// many trial picks were needed per selected event.
+
+void ProcessLevel::selectionStatistics(bool reset) {
+
+  // Average number of picks per successful pick.
+  double pickRatio = (nPickAcc > 0) ? double(nPick) / nPickAcc : 0.;
+
+  // Header.
+  cout << "\n *-------  PYTHIA Process Selection Statistics  -----------"
+       << "-----*\n"
+       << " |                                                            "
+       << "  |\n";
+
+  // Selection method and counters.
+  cout << " | Number of process containers:" << setw(12)
+       << containerPtrs.size() << "  "
+       << ( (selector.isTree()) ? "(tree)  " : "(linear)" )
+       << "          |\n"
+       << " | Number of trial picks:       " << setw(12) << nPick
+       << "                    |\n"
+       << " | Number of successful picks:  " << setw(12) << nPickAcc
+       << "                    |\n"
+       << " | Trial picks per success:     " << fixed << setprecision(3)
+       << setw(12) << pickRatio << "                    |\n"
+       << " | Updates of maxima:           " << setw(12) << nMaxUpdate
+       << "                    |\n";
+
+  // Listing finished.
+  cout << " |                                                            "
+       << "  |\n"
+       << " *-------  End PYTHIA Process Selection Statistics  -------"
+       << "-----*" << endl;
+
+  // Optionally reset statistics contants.
+  if (reset) {
+    nPick      = 0;
+    nPickAcc   = 0;
+    nMaxUpdate = 0;
+  }
+
+}
+
+//--------------------------------------------------------------------------
+
 // Reset statistics on cross sections and number of events.
 
 void ProcessLevel::resetStatistics() {
 
   for (int i = 0; i < int(containerPtrs.size()); ++i)
     containerPtrs[i]->reset();
+  nPick      = 0;
+  nPickAcc   = 0;
+  nMaxUpdate = 0;
   if (doSecondHard)
   for (int i2 = 0; i2 < int(container2Ptrs.size()); ++i2)
     container2Ptrs[i2]->reset();
@@ -643,11 +782,8 @@ bool ProcessLevel::nextOne( Event& process) {
     for ( ; ; ) {
 
       // Pick one of the subprocesses.
-      double sigmaMaxNow = sigmaMaxSum * rndmPtr->flat();
-      int iMax = containerPtrs.size() - 1;
-      iContainer = -1;
-      do sigmaMaxNow -= containerPtrs[++iContainer]->sigmaMax();
-      while (sigmaMaxNow > 0. && iContainer < iMax);
+      iContainer = selector.pick( rndmPtr->flat() );
+      ++nPick;
 
       // Do a trial event of this subprocess; accept or not.
       if (containerPtrs[iContainer]->trialProcess()) break;
@@ -657,10 +793,11 @@ bool ProcessLevel::nextOne( Event& process) {
     }
 
     // Update sum of maxima if current maximum violated.
+    ++nPickAcc;
     if (containerPtrs[iContainer]->newSigmaMax()) {
-      sigmaMaxSum = 0.;
-      for (int i = 0; i < int(containerPtrs.size()); ++i)
-        sigmaMaxSum += containerPtrs[i]->sigmaMax();
+      selector.update( iContainer, containerPtrs[iContainer]->sigmaMax());
+      sigmaMaxSum = selector.sum();
+      ++nMaxUpdate;
     }
 
     // Construct kinematics of acceptable process.
@@ -751,11 +888,8 @@ bool ProcessLevel::nextTwo( Event& process) {
       for ( ; ; ) {
 
         // Pick one of the subprocesses.
-        double sigmaMaxNow = sigmaMaxSum * rndmPtr->flat();
-        int iMax = containerPtrs.size() - 1;
-        iContainer = -1;
-        do sigmaMaxNow -= containerPtrs[++iContainer]->sigmaMax();
-        while (sigmaMaxNow > 0. && iContainer < iMax);
+        iContainer = selector.pick( rndmPtr->flat() );
+        ++nPick;
 
         // Do a trial event of this subprocess; accept or not.
         if (containerPtrs[iContainer]->trialProcess()) break;
@@ -765,10 +899,11 @@ bool ProcessLevel::nextTwo( Event& process) {
       }
 
       // Update sum of maxima if current maximum violated. Event weight.
+      ++nPickAcc;
       if (containerPtrs[iContainer]->newSigmaMax()) {
-        sigmaMaxSum = 0.;
-        for (int i = 0; i < int(containerPtrs.size()); ++i)
-          sigmaMaxSum += containerPtrs[i]->sigmaMax();
+        selector.update( iContainer, containerPtrs[iContainer]->sigmaMax());
+        sigmaMaxSum = selector.sum();
+        ++nMaxUpdate;
       }
       wtViol1 = (doWt2) ? infoPtr->weight() : 1.;
 
@@ -776,11 +911,7 @@ bool ProcessLevel::nextTwo( Event& process) {
       for ( ; ; ) {
 
         // Pick one of the subprocesses.
-        double sigma2MaxNow = sigma2MaxSum * rndmPtr->flat();
-        int i2Max = container2Ptrs.size() - 1;
-        i2Container = -1;
-        do sigma2MaxNow -= container2Ptrs[++i2Container]->sigmaMax();
-        while (sigma2MaxNow > 0. && i2Container < i2Max);
+        i2Container = selector2.pick( rndmPtr->flat() );
 
         // Do a trial event of this subprocess; accept or not.
         if (container2Ptrs[i2Container]->trialProcess()) break;
@@ -788,9 +919,9 @@ bool ProcessLevel::nextTwo( Event& process) {
 
       // Update sum of maxima if current maximum violated.
       if (container2Ptrs[i2Container]->newSigmaMax()) {
-        sigma2MaxSum = 0.;
-        for (int i2 = 0; i2 < int(container2Ptrs.size()); ++i2)
-          sigma2MaxSum += container2Ptrs[i2]->sigmaMax();
+        selector2.update( i2Container,
+          container2Ptrs[i2Container]->sigmaMax());
+        sigma2MaxSum = selector2.sum();
       }
       wtViol2 = (doWt2) ? infoPtr->weight() : 1.;
 
@@ -37,6 +37,10 @@ const int Pythia::NTRY          = 10;
 // Negative integer to denote that no subrun has been set.
 const int Pythia::SUBRUNDEFAULT = -999;
 
+// Version of the binary snapshot format, and tag at the start of it.
+const int    Pythia::SNAPSHOTFORMAT = 1;
+const string Pythia::SNAPSHOTTAG    = "PYTHIA8SNAPSHOT";
+
 //--------------------------------------------------------------------------
 
 // Constructor.
@@ -74,47 +78,9 @@ Pythia::Pythia(string xmlDir, bool printBanner) :
   // Initialise / reset pointers and global variables.
   initPtrs();
 
-  // Find path to data files, i.e. xmldoc directory location.
-  // Environment variable takes precedence, then constructor input,
-  // and finally the pre-processor constant XMLDIR.
-  xmlPath = "";
-  const char* PYTHIA8DATA = "PYTHIA8DATA";
-  char* envPath = getenv(PYTHIA8DATA);
-  if (envPath != 0 && *envPath != '\0') {
-    int i = 0;
-    while (*(envPath+i) != '\0') xmlPath += *(envPath+(i++));
-  } else {
-    if (xmlDir[ xmlDir.length() - 1 ] != '/') xmlDir += "/";
-    xmlPath = xmlDir;
-    ifstream xmlFile((xmlPath + "Index.xml").c_str());
-    if (!xmlFile.good()) xmlPath = XMLDIR;
-    xmlFile.close();
-  }
-  if (xmlPath[ xmlPath.length() - 1 ] != '/') xmlPath += "/";
-
-  // Read in files with all flags, modes, parms and words.
-  settings.initPtr( &info);
-  string initFile = xmlPath + "Index.xml";
-  isConstructed = settings.init( initFile);
-  if (!isConstructed) {
-    info.errorMsg("Abort from Pythia::Pythia: settings unavailable");
-    return;
-  }
-
-  // Save XML path in settings.
-  settings.addWord( "xmlPath", xmlPath);
-
-  // Check that XML and header version numbers match code version number.
-  if (!checkVersion()) return;
-
-  // Read in files with all particle data.
-  particleData.initPtr( &info, &settings, &rndm, couplingsPtr);
-  string dataFile = xmlPath + "ParticleData.xml";
-  isConstructed = particleData.init( dataFile);
-  if (!isConstructed) {
-    info.errorMsg("Abort from Pythia::Pythia: particle data unavailable");
-    return;
-  }
+  // Find path to data files and read in all settings and particle data.
+  findXMLPath( xmlDir);
+  if (!readXMLFiles()) return;
 
   // Write the Pythia banner to output.
   if (printBanner) banner();
@@ -123,8 +89,6 @@ Pythia::Pythia(string xmlDir, bool printBanner) :
   isInit = false;
   info.addCounter(0);
 
-  HeavyIons::addSpecialSettings(settings);
-
 }
 
 //--------------------------------------------------------------------------
@@ -269,6 +233,62 @@ Pythia::Pythia( istream& settingsStrings, istream& particleDataStrings,
 
 //--------------------------------------------------------------------------
 
+// Constructor from a binary snapshot of settings and particle data.
+
+Pythia::Pythia( istream& snapshotIn, string xmlDir, bool printBanner) :
+  couplingsPtr(), mergingPtr(),
+  mergingHooksPtr(), heavyIonsPtr(), hiHooksPtr(), doProcessLevel(),
+  doPartonLevel(), doHadronLevel(), doSoftQCDall(), doSoftQCDinel(),
+  doCentralDiff(), doDiffraction(), doSoftQCD(), doVMDsideA(), doVMDsideB(),
+  doHardDiff(), doResDec(), doFSRinRes(), decayRHadrons(), abortIfVeto(),
+  checkEvent(), checkHistory(), nErrList(), epTolErr(), epTolWarn(), mTolErr(),
+  mTolWarn(), beamHasGamma(), beamAisResGamma(), beamBisResGamma(),
+  beamAhasResGamma(), beamBhasResGamma(), gammaMode(), isUnresolvedA(),
+  isUnresolvedB(), showSaV(), showMaD(), doReconnect(), forceHadronLevelCR(),
+  idA(), idB(), frameType(), boostType(), nCount(), nShowLHA(), nShowInfo(),
+  nShowProc(), nShowEvt(), reconnectMode(), mA(), mB(), pxA(), pxB(), pyA(),
+  pyB(), pzA(), pzB(), eA(), eB(), pzAcm(), pzBcm(), eCM(), betaZ(), gammaZ(),
+  nErrEvent(), pdfAPtr(), pdfBPtr(), pdfHardAPtr(), pdfHardBPtr(),
+  pdfPomAPtr(), pdfPomBPtr(), pdfGamAPtr(), pdfGamBPtr(), pdfHardGamAPtr(),
+  pdfHardGamBPtr(), pdfUnresAPtr(), pdfUnresBPtr(), pdfUnresGamAPtr(),
+  pdfUnresGamBPtr(), pdfGamFluxAPtr(), pdfGamFluxBPtr(), pdfVMDAPtr(),
+  pdfVMDBPtr(), useNewPdfA(), useNewPdfB(), useNewPdfHard(), useNewPdfPomA(),
+  useNewPdfPomB(), useNewPdfGamA(), useNewPdfGamB(), useNewPdfHardGamA(),
+  useNewPdfHardGamB(), useNewPdfUnresA(), useNewPdfUnresB(),
+  useNewPdfUnresGamA(), useNewPdfUnresGamB(), useNewPdfVMDA(), useNewPdfVMDB(),
+  hasUserHooksVector(), doLHA(), useNewLHA(), lhaUpPtr(), decayHandlePtr(),
+  userHooksPtr(), hasUserHooks(), doVetoProcess(), doVetoPartons(),
+  retryPartonLevel(), beamShapePtr(), useNewBeamShape(), doMomentumSpread(),
+  doVertexSpread(), doVarEcm(), eMinPert(), eWidthPert(), timesDecPtr(),
+  timesPtr(), spacePtr(), useNewTimesDec(), useNewTimes(), useNewSpace(),
+  partonVertexPtr(), useNewPartonVertex(), hasMerging(), hasOwnMerging(),
+  hasMergingHooks(), hasOwnMergingHooks(), doMerging(), hasHeavyIons(),
+  hasOwnHeavyIons(), doHeavyIons() {
+
+  // Initialise / reset pointers and global variables.
+  initPtrs();
+
+  // Find path to data files. Read the snapshot, or else the XML files.
+  findXMLPath( xmlDir);
+  settings.initPtr( &info);
+  particleData.initPtr( &info, &settings, &rndm, couplingsPtr);
+  if (!readSnapshot( snapshotIn)) {
+    info.errorMsg("Warning in Pythia::Pythia: "
+      "snapshot not usable, so read XML files instead");
+    if (!readXMLFiles()) return;
+  }
+
+  // Write the Pythia banner to output.
+  if (printBanner) banner();
+
+  // Not initialized until at the end of the init() call.
+  isInit = false;
+  info.addCounter(0);
+
+}
+
+//--------------------------------------------------------------------------
+
 // Destructor.
 
 Pythia::~Pythia() {
@@ -445,6 +465,209 @@ bool Pythia::checkVersion() {
 
 //--------------------------------------------------------------------------
 
+// Find path to data files, i.e. xmldoc directory location.
+// Environment variable takes precedence, then constructor input,
+// and finally the pre-processor constant XMLDIR.
+
+void Pythia::findXMLPath(string xmlDir) {
+
+  xmlPath = "";
+  const char* PYTHIA8DATA = "PYTHIA8DATA";
+  char* envPath = getenv(PYTHIA8DATA);
+  if (envPath != 0 && *envPath != '\0') {
+    int i = 0;
+    while (*(envPath+i) != '\0') xmlPath += *(envPath+(i++));
+  } else {
+    if (xmlDir[ xmlDir.length() - 1 ] != '/') xmlDir += "/";
+    xmlPath = xmlDir;
+    ifstream xmlFile((xmlPath + "Index.xml").c_str());
+    if (!xmlFile.good()) xmlPath = XMLDIR;
+    xmlFile.close();
+  }
+  if (xmlPath[ xmlPath.length() - 1 ] != '/') xmlPath += "/";
+
+}
+
+//--------------------------------------------------------------------------
+
+// Read in all settings and particle data from the XML files.
+
+bool Pythia::readXMLFiles() {
+
+  // Read in files with all flags, modes, parms and words.
+  settings.initPtr( &info);
+  string initFile = xmlPath + "Index.xml";
+  isConstructed = settings.init( initFile);
+  if (!isConstructed) {
+    info.errorMsg("Abort from Pythia::Pythia: settings unavailable");
+    return false;
+  }
+
+  // Save XML path in settings.
+  settings.addWord( "xmlPath", xmlPath);
+
+  // Check that XML and header version numbers match code version number.
+  if (!checkVersion()) return false;
+
+  // Read in files with all particle data.
+  particleData.initPtr( &info, &settings, &rndm, couplingsPtr);
+  string dataFile = xmlPath + "ParticleData.xml";
+  isConstructed = particleData.init( dataFile);
+  if (!isConstructed) {
+    info.errorMsg("Abort from Pythia::Pythia: particle data unavailable");
+    return false;
+  }
+
+  // Extra settings for the Angantyr heavy-ion model.
+  HeavyIons::addSpecialSettings(settings);
+  return true;
+
+}
+
+//--------------------------------------------------------------------------
+
+// Write a binary snapshot of the settings and particle data to a file.
+
+bool Pythia::writeSnapshot(string fileName) {
+
+  ofstream os( fileName.c_str(), ios::binary);
+  if (!os.good()) {
+    info.errorMsg("Error in Pythia::writeSnapshot: could not open file",
+      fileName);
+    return false;
+  }
+  return writeSnapshot( os);
+
+}
+
+//--------------------------------------------------------------------------
+
+// Write a binary snapshot of the settings and particle data to a stream.
+// A header with the format and code version numbers, the sizes of basic
+// types, and the length and checksum of the data precedes the data.
+
+bool Pythia::writeSnapshot(ostream& os) {
+
+  // Check that constructor worked.
+  if (!isConstructed) return false;
+
+  // Collect the two databases in memory, to find length and checksum.
+  ostringstream dataStream;
+  if ( !settings.writeSnapshot( dataStream)
+    || !particleData.writeSnapshot( dataStream) ) {
+    info.errorMsg("Error in Pythia::writeSnapshot: could not store data");
+    return false;
+  }
+  string data = dataStream.str();
+
+  // Write header and data.
+  SnapshotWriter out(os);
+  out.write( SNAPSHOTTAG);
+  out.write( SNAPSHOTFORMAT);
+  out.write( VERSIONNUMBERCODE);
+  out.write( int(sizeof(int)));
+  out.write( int(sizeof(double)));
+  out.write( int(data.size()));
+  out.write( int(snapshotChecksum( data)));
+  os.write( data.data(), data.size());
+  if (!out.good()) {
+    info.errorMsg("Error in Pythia::writeSnapshot: could not write data");
+    return false;
+  }
+  return true;
+
+}
+
+//--------------------------------------------------------------------------
+
+// Read a binary snapshot of the settings and particle data from a file.
+
+bool Pythia::readSnapshot(string fileName) {
+
+  ifstream is( fileName.c_str(), ios::binary);
+  if (!is.good()) {
+    info.errorMsg("Error in Pythia::readSnapshot: did not find file",
+      fileName);
+    return false;
+  }
+  return readSnapshot( is);
+
+}
+
+//--------------------------------------------------------------------------
+
+// Read a binary snapshot of the settings and particle data from a stream.
+// The current databases are only overwritten when the header matches
+// this code version and platform, and the checksum of the data is right.
+
+bool Pythia::readSnapshot(istream& is) {
+
+  // Read and check the header.
+  SnapshotReader in(is);
+  string tag;
+  int format = 0, sizeInt = 0, sizeDouble = 0, nData = 0, checksum = 0;
+  double version = 0.;
+  if (!in.read(tag) || tag != SNAPSHOTTAG) {
+    info.errorMsg("Error in Pythia::readSnapshot: not a PYTHIA snapshot");
+    return false;
+  }
+  if ( !in.read(format) || !in.read(version) || format != SNAPSHOTFORMAT
+    || abs(version - VERSIONNUMBERCODE) > 0.0005 ) {
+    info.errorMsg("Error in Pythia::readSnapshot: unmatched version"
+      " numbers");
+    return false;
+  }
+  if ( !in.read(sizeInt) || !in.read(sizeDouble) || !in.read(nData)
+    || !in.read(checksum) || sizeInt != int(sizeof(int))
+    || sizeDouble != int(sizeof(double)) || nData <= 0 ) {
+    info.errorMsg("Error in Pythia::readSnapshot: unmatched platform");
+    return false;
+  }
+
+  // Read the data and compare the checksum.
+  string data( nData, ' ');
+  is.read( &data[0], nData);
+  if (!is.good() || snapshotChecksum( data) != (unsigned int)(checksum)) {
+    info.errorMsg("Error in Pythia::readSnapshot: data is corrupt");
+    return false;
+  }
+
+  // Read the two databases. Use the current XML path.
+  istringstream dataStream( data);
+  isConstructed = settings.readSnapshot( dataStream);
+  if (!isConstructed) {
+    info.errorMsg("Abort from Pythia::readSnapshot: settings unavailable");
+    return false;
+  }
+  settings.addWord( "xmlPath", xmlPath);
+  if (!checkVersion()) return false;
+  isConstructed = particleData.readSnapshot( dataStream);
+  if (!isConstructed) {
+    info.errorMsg("Abort from Pythia::readSnapshot: "
+      "particle data unavailable");
+    return false;
+  }
+  return true;
+
+}
+
+//--------------------------------------------------------------------------
+
+// Checksum of the data part of a snapshot, with the 32-bit FNV-1a hash.
+
+unsigned int Pythia::snapshotChecksum(const string& data) {
+
+  unsigned int hash = 2166136261u;
+  for (int i = 0; i < int(data.size()); ++i) {
+    hash ^= (unsigned char)(data[i]);
+    hash *= 16777619u;
+  }
+  return hash;
+
+}
+
+//--------------------------------------------------------------------------
+
 // Read in one update for a setting or particle data from a single line.
 
 bool Pythia::readString(string line, bool warn) {
@@ -810,6 +1033,7 @@ bool Pythia::init() {
 
   // Check that constructor worked.
   isInit = false;
+  settings.countLookups(false);
   if (!isConstructed) {
     info.errorMsg("Abort from Pythia::init: constructor "
       "initialization failed");
@@ -848,9 +1072,17 @@ bool Pythia::init() {
     return false;
   }
 
-  // Initialize the random number generator.
-  if ( settings.flag("Random:setSeed") )
-    rndm.init( settings.mode("Random:seed") );
+  // Initialize the random number generator, with the chosen engine,
+  // and optionally move to a substream of the xoshiro128++ engine.
+  bool setSeed    = settings.flag("Random:setSeed");
+  int  rndmEngine = settings.mode("Random:engine");
+  if (setSeed || rndmEngine != rndm.engine()) {
+    rndm.init( setSeed ? settings.mode("Random:seed") : -1, rndmEngine);
+    int rndmStream = settings.mode("Random:stream");
+    if (rndmStream > 0 && !rndm.longJump(rndmStream))
+      info.errorMsg("Warning in Pythia::init: Random:stream requires "
+        "Random:engine = 1");
+  }
 
   // Find which frame type to use.
   info.addCounter(1);
@@ -938,6 +1170,9 @@ bool Pythia::init() {
     bool   setScales   = flag("Beams:setProductionScalesFromLHEF");
     bool   skipInit    = flag("Beams:newLHEFsameInit");
     int    nSkipAtInit = mode("Beams:nSkipLHEFatInit");
+    bool   useIndex    = flag("Beams:LHEFindex");
+    int    nShard      = mode("Beams:nLHEFshards");
+    int    iShard      = mode("Beams:iLHEFshard");
 
     // For file input: renew file stream or (re)new Les Houches object.
     if (frameType == 4) {
@@ -982,11 +1217,20 @@ bool Pythia::init() {
     lhaUpPtr->setPtr( &info);
     processLevel.setLHAPtr( lhaUpPtr);
 
+    // Optionally index the events, and only read one shard of them.
+    if ( (useIndex || nShard > 1)
+      && !lhaUpPtr->indexEvents( iShard, nShard) ) {
+      info.errorMsg("Abort from Pythia::init: "
+        "could not index or shard the Les Houches events");
+      return false;
+    }
+
     // If second time around, only with new file, then simplify.
     // Optionally skip ahead a number of events at beginning of file.
     if (skipInit) {
       isInit = true;
       info.addCounter(2);
+      settings.countLookups(true);
       if (nSkipAtInit > 0) lhaUpPtr->skipEvent(nSkipAtInit);
       return true;
     }
@@ -1388,10 +1632,11 @@ bool Pythia::init() {
   reconnectMode      = settings.mode("ColourReconnection:mode");
   forceHadronLevelCR = settings.flag("ColourReconnection:forceHadronLevelCR");
 
-  // Succeeded.
+  // Succeeded. Any later settings lookups may be counted.
   isInit = true;
   info.addCounter(2);
   if (useNewLHA && showPro) lhaUpPtr->listInit();
+  settings.countLookups(true);
   return true;
 
 }
@@ -2075,7 +2320,7 @@ bool Pythia::next() {
     }
 
     // Save spare copy of process record in case of problems.
-    Event processSave = process;
+    processSave = process;
     int sizeMPI       = info.sizeMPIarrays();
     info.addCounter(12);
     for (int i = 14; i < 19; ++i) info.setCounter(i);
@@ -2385,7 +2630,7 @@ bool Pythia::forceHadronLevel(bool findJunctions) {
     }
 
     // save spare copy of event in case of failure.
-    Event spareEvent = event;
+    spareEvent = event;
     bool colCorrect = false;
 
     // Allow up to ten tries for CR.
@@ -2406,7 +2651,7 @@ bool Pythia::forceHadronLevel(bool findJunctions) {
   }
 
   // Save spare copy of event in case of failure.
-  Event spareEvent = event;
+  spareEvent = event;
 
   // Allow up to ten tries for hadron-level processing.
   bool physical = true;
@@ -2591,11 +2836,13 @@ void Pythia::stat() {
   bool showPrL = settings.flag("Stat:showProcessLevel");
   bool showPaL = settings.flag("Stat:showPartonLevel");
   bool showErr = settings.flag("Stat:showErrors");
+  bool showPrS = settings.flag("Stat:showProcessSelection");
   bool reset   = settings.flag("Stat:reset");
 
   // Statistics on cross section and number of events.
   if (doProcessLevel) {
     if (showPrL) processLevel.statistics(false);
+    if (showPrS) processLevel.selectionStatistics(false);
     if (reset)   processLevel.resetStatistics();
   }
 
@@ -2606,6 +2853,9 @@ void Pythia::stat() {
   // Merging statistics.
   if (doMerging) mergingPtr->statistics();
 
+  // Settings lookups after initialization, if compiled to count them.
+  settings.listLookups();
+
   // Summary of which and how many warnings/errors encountered.
   if (showErr) info.errorStatistics();
   if (reset)   info.errorReset();
@@ -3018,6 +3268,9 @@ bool Pythia::check() {
   vector< pair<int,int> > noMotDau;
   if (checkHistory) {
 
+    // Mother and daughter lists, reused for all particles.
+    vector<int> mList, dList, dmList, mdList;
+
     // Loop through the event and check that there are beam particles.
     bool hasBeams = false;
     for (int i = 0; i < event.size(); ++i) {
@@ -3025,8 +3278,8 @@ bool Pythia::check() {
       if (abs(status) == 12) hasBeams = true;
 
       // Check that mother and daughter lists not empty where not expected to.
-      vector<int> mList = event[i].motherList();
-      vector<int> dList = event[i].daughterList();
+      event[i].motherList( mList);
+      event[i].daughterList( dList);
       if (mList.size() == 0 && abs(status) != 11 && abs(status) != 12)
         noMot.push_back(i);
       if (dList.size() == 0 && status < 0 && status != -11)
@@ -3036,7 +3289,7 @@ bool Pythia::check() {
       for (int j = 0; j < int(mList.size()); ++j) {
         if ( event[mList[j]].daughter1() <= i
           && event[mList[j]].daughter2() >= i ) continue;
-        vector<int> dmList = event[mList[j]].daughterList();
+        event[mList[j]].daughterList( dmList);
         bool foundMatch = false;
         for (int k = 0; k < int(dmList.size()); ++k)
         if (dmList[k] == i) {
@@ -3061,7 +3314,7 @@ bool Pythia::check() {
           && event[dList[j]].statusAbs() < 90
           && event[dList[j]].mother1() <= i
           && event[dList[j]].mother2() >= i) continue;
-        vector<int> mdList = event[dList[j]].motherList();
+        event[dList[j]].motherList( mdList);
         bool foundMatch = false;
         for (int k = 0; k < int(mdList.size()); ++k)
         if (mdList[k] == i) {
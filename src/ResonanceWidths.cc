@@ -31,6 +31,21 @@ const double ResonanceWidths::MASSMIN        = 0.1;
 // The sum of product masses must not be too close to the resonance mass.
 const double ResonanceWidths::MASSMARGIN     = 0.1;
 
+// Number of steps in the starting grid of a width table over the full
+// mass range, and number of half widths on each side of the peak mass.
+const int    ResonanceWidths::NTABLE         = 100;
+const int    ResonanceWidths::NTABLEPEAK     = 20;
+
+// Maximum number of masses in a width table.
+const int    ResonanceWidths::NTABLEMAX      = 5000;
+
+// Upper end of a width table, in units of the nominal mass, when the
+// resonance has no upper mass limit.
+const double ResonanceWidths::TABLEMASSMAX   = 10.;
+
+// Smallest mass step of a width table, in units of the nominal mass.
+const double ResonanceWidths::TABLEMINSTEP   = 1e-6;
+
 //--------------------------------------------------------------------------
 
 // Initialize data members.
@@ -48,6 +63,10 @@ bool ResonanceWidths::init(Info* infoPtrIn, Settings* settingsPtrIn,
   // Perform any model dependent initialisations (pure dummy in base class).
   bool isInit = initBSM();
 
+  // Width tables are only set up once all resonances are initialized.
+  useTables    = false;
+  widthTables.clear();
+
   // Minimal decaying-resonance width. Minimal phase space for meMode = 103.
   minWidth     = settingsPtr->parm("ResonanceWidths:minWidth");
   minThreshold = settingsPtr->parm("ResonanceWidths:minThreshold");
@@ -267,14 +286,28 @@ bool ResonanceWidths::init(Info* infoPtrIn, Settings* settingsPtrIn,
 double ResonanceWidths::width(int idSgn, double mHatIn, int idInFlavIn,
   bool openOnly, bool setBR, int idOutFlav1, int idOutFlav2) {
 
+  // Use tabulated widths, if available for this mass. Find interval.
+  ResonanceWidthTable* tablePtr = (useTables) ? &widthTable(idInFlavIn) : 0;
+  if (tablePtr != 0 && (mHatIn < tablePtr->mass.front()
+    || mHatIn > tablePtr->mass.back())) tablePtr = 0;
+  int    iTab = 0;
+  double xTab = 0.;
+  if (tablePtr != 0) {
+    vector<double>& massTab = tablePtr->mass;
+    iTab = upper_bound( massTab.begin(), massTab.end(), mHatIn)
+         - massTab.begin() - 1;
+    iTab = min( iTab, int(massTab.size()) - 2);
+    xTab = (mHatIn - massTab[iTab]) / (massTab[iTab + 1] - massTab[iTab]);
+  }
+
   // Calculate various prefactors for the current mass.
   mHat          = mHatIn;
   idInFlav      = idInFlavIn;
-  if (allowCalcWidth) calcPreFac(false);
+  if (allowCalcWidth && (tablePtr == 0 || checkTables)) calcPreFac(false);
 
-  // Reset quantities to sum. Declare variables inside loop.
+  // Reset quantities to sum.
   double widSum = 0.;
-  double mfSum, psOnShell;
+  double widSumCheck = 0.;
 
   // Loop over all decay channels. Basic properties of channel.
   for (int i = 0; i < particlePtr->sizeChannels(); ++i) {
@@ -301,101 +334,284 @@ double ResonanceWidths::width(int idSgn, double mHatIn, int idInFlavIn,
       if (idSgn < 0 && onMode !=1 && onMode != 3) continue;
     }
 
-    // Channels with meMode < 100 must be implemented in derived classes.
-    if (meMode < 100) {
+    // Calculate the partial width directly.
+    if (tablePtr == 0) channelWidth(i);
 
-      // Read out information on channel: primarily use first two.
-      id1       = particlePtr->channel(i).product(0);
-      id2       = particlePtr->channel(i).product(1);
-      id1Abs    = abs(id1);
-      id2Abs    = abs(id2);
+    // Alternatively interpolate in the table, optionally with a check.
+    else {
+      if (checkTables) {
+        double widCheck = channelWidth(i);
+        if (openOnly) widCheck *= particlePtr->channel(i).openSec(idSgn);
+        if (doForceWidth) widCheck *= forceFactor;
+        widSumCheck += widCheck;
+      }
+      widNow    = (1. - xTab) * tablePtr->widths[iTab][i]
+                + xTab * tablePtr->widths[iTab + 1][i];
+    }
 
-      // Order first two in descending order of absolute values.
-      if (id2Abs > id1Abs) {swap( id1, id2); swap( id1Abs, id2Abs);}
+    // Optionally multiply by secondary widths.
+    if (openOnly) widNow *= particlePtr->channel(i).openSec(idSgn);
 
-      // Allow for third product to be treated in derived classes.
-      if (mult > 2) {
-        id3     = particlePtr->channel(i).product(2);
-        id3Abs  = abs(id3);
+    // Optionally include factor to force to fixed width.
+    if (doForceWidth) widNow *= forceFactor;
 
-        // Also order third into descending order of absolute values.
-        if (id3Abs > id2Abs) {swap( id2, id3); swap( id2Abs, id3Abs);}
-        if (id2Abs > id1Abs) {swap( id1, id2); swap( id1Abs, id2Abs);}
-      }
+    // Optionally multiply by current/nominal resonance mass??
 
-      // Read out masses. Calculate two-body phase space.
-      mf1       = particleDataPtr->m0(id1Abs);
-      mf2       = particleDataPtr->m0(id2Abs);
-      mr1       = pow2(mf1 / mHat);
-      mr2       = pow2(mf2 / mHat);
-      ps        = (mHat < mf1 + mf2 + MASSMARGIN) ? 0.
-                : sqrtpos( pow2(1. - mr1 - mr2) - 4. * mr1 * mr2 );
-      if (mult > 2) {
-        mf3     = particleDataPtr->m0(id3Abs);
-        mr3     = pow2(mf3 / mHat);
-        ps      = (mHat < mf1 + mf2 + mf3 + MASSMARGIN) ? 0. : 1.;
-      }
+    // Sum back up.
+    widSum += widNow;
 
-      // Let derived class calculate width for channel provided.
-      calcWidth(false);
+    // Optionally store partial widths for later decay channel choice.
+    if (setBR) particlePtr->channel(i).currentBR(widNow);
+  }
+
+  // Warn if the tabulated width misses the requested accuracy.
+  if (tablePtr != 0 && checkTables && abs(widSum - widSumCheck)
+    > tableAccuracy * max(widSum, widSumCheck)) {
+    ostringstream osWarn;
+    osWarn << "for id = " << idRes;
+    infoPtr->errorMsg("Warning in ResonanceWidths::width: tabulated"
+      " width outside accuracy", osWarn.str());
+  }
+
+  // Done.
+  return widSum;
+
+}
+
+//--------------------------------------------------------------------------
+
+// Calculate the partial width of a decay channel at the current mass,
+// before secondary open fractions and forced width are included.
+
+double ResonanceWidths::channelWidth(int iChannelIn) {
+
+  // Basic properties of channel.
+  iChannel      = iChannelIn;
+  onMode        = particlePtr->channel(iChannel).onMode();
+  meMode        = particlePtr->channel(iChannel).meMode();
+  mult          = particlePtr->channel(iChannel).multiplicity();
+  widNow        = 0.;
+  double mfSum, psOnShell;
+
+  // Channels with meMode < 100 must be implemented in derived classes.
+  if (meMode < 100) {
+
+    // Read out information on channel: primarily use first two.
+    id1         = particlePtr->channel(iChannel).product(0);
+    id2         = particlePtr->channel(iChannel).product(1);
+    id1Abs      = abs(id1);
+    id2Abs      = abs(id2);
+
+    // Order first two in descending order of absolute values.
+    if (id2Abs > id1Abs) {swap( id1, id2); swap( id1Abs, id2Abs);}
+
+    // Allow for third product to be treated in derived classes.
+    if (mult > 2) {
+      id3       = particlePtr->channel(iChannel).product(2);
+      id3Abs    = abs(id3);
+
+      // Also order third into descending order of absolute values.
+      if (id3Abs > id2Abs) {swap( id2, id3); swap( id2Abs, id3Abs);}
+      if (id2Abs > id1Abs) {swap( id1, id2); swap( id1Abs, id2Abs);}
     }
 
-    // Now on to meMode >= 100. First case: no correction at all.
-    else if (meMode == 100)
-      widNow    = GammaRes * particlePtr->channel(i).bRatio();
-
-    // Correction by step at threshold.
-    else if (meMode == 101) {
-      mfSum     = 0.;
-      for (int j = 0; j < mult; ++j) mfSum
-               += particleDataPtr->m0( particlePtr->channel(i).product(j) );
-      if (mfSum + MASSMARGIN < mHat)
-        widNow  = GammaRes * particlePtr->channel(i).bRatio();
+    // Read out masses. Calculate two-body phase space.
+    mf1         = particleDataPtr->m0(id1Abs);
+    mf2         = particleDataPtr->m0(id2Abs);
+    mr1         = pow2(mf1 / mHat);
+    mr2         = pow2(mf2 / mHat);
+    ps          = (mHat < mf1 + mf2 + MASSMARGIN) ? 0.
+                : sqrtpos( pow2(1. - mr1 - mr2) - 4. * mr1 * mr2 );
+    if (mult > 2) {
+      mf3       = particleDataPtr->m0(id3Abs);
+      mr3       = pow2(mf3 / mHat);
+      ps        = (mHat < mf1 + mf2 + mf3 + MASSMARGIN) ? 0. : 1.;
     }
 
-    // Correction by a phase space factor for two-body decays.
-    else if ( (meMode == 102 || meMode == 103) && mult == 2) {
-      mf1       = particleDataPtr->m0( particlePtr->channel(i).product(0) );
-      mf2       = particleDataPtr->m0( particlePtr->channel(i).product(1) );
-      mr1       = pow2(mf1 / mHat);
-      mr2       = pow2(mf2 / mHat);
-      ps        = (mHat < mf1 + mf2 + MASSMARGIN) ? 0.
+    // Let derived class calculate width for channel provided.
+    calcWidth(false);
+  }
+
+  // Now on to meMode >= 100. First case: no correction at all.
+  else if (meMode == 100)
+    widNow      = GammaRes * particlePtr->channel(iChannel).bRatio();
+
+  // Correction by step at threshold.
+  else if (meMode == 101) {
+    mfSum       = 0.;
+    for (int j = 0; j < mult; ++j) mfSum
+      += particleDataPtr->m0( particlePtr->channel(iChannel).product(j) );
+    if (mfSum + MASSMARGIN < mHat)
+      widNow    = GammaRes * particlePtr->channel(iChannel).bRatio();
+  }
+
+  // Correction by a phase space factor for two-body decays.
+  else if ( (meMode == 102 || meMode == 103) && mult == 2) {
+    mf1 = particleDataPtr->m0( particlePtr->channel(iChannel).product(0) );
+    mf2 = particleDataPtr->m0( particlePtr->channel(iChannel).product(1) );
+    mr1         = pow2(mf1 / mHat);
+    mr2         = pow2(mf2 / mHat);
+    ps          = (mHat < mf1 + mf2 + MASSMARGIN) ? 0.
                 : sqrtpos( pow2(1. - mr1 - mr2) - 4. * mr1 * mr2 );
-      mr1       = pow2(mf1 / mRes);
-      mr2       = pow2(mf2 / mRes);
-      psOnShell = (meMode == 102) ? 1. : max( minThreshold,
+    mr1         = pow2(mf1 / mRes);
+    mr2         = pow2(mf2 / mRes);
+    psOnShell   = (meMode == 102) ? 1. : max( minThreshold,
                   sqrtpos( pow2(1.- mr1 - mr2) - 4. * mr1 * mr2) );
-      widNow = GammaRes * particlePtr->channel(i).bRatio() * ps / psOnShell;
-    }
+    widNow = GammaRes * particlePtr->channel(iChannel).bRatio()
+           * ps / psOnShell;
+  }
 
-    // Correction by simple threshold factor for multibody decay.
-    else if (meMode == 102 || meMode == 103) {
-      mfSum  = 0.;
-      for (int j = 0; j < mult; ++j) mfSum
-               += particleDataPtr->m0( particlePtr->channel(i).product(j) );
-      ps        = sqrtpos(1. - mfSum / mHat);
-      psOnShell = (meMode == 102) ? 1. : max( minThreshold,
+  // Correction by simple threshold factor for multibody decay.
+  else if (meMode == 102 || meMode == 103) {
+    mfSum       = 0.;
+    for (int j = 0; j < mult; ++j) mfSum
+      += particleDataPtr->m0( particlePtr->channel(iChannel).product(j) );
+    ps          = sqrtpos(1. - mfSum / mHat);
+    psOnShell   = (meMode == 102) ? 1. : max( minThreshold,
                   sqrtpos(1. - mfSum / mRes) );
-      widNow = GammaRes * particlePtr->channel(i).bRatio() * ps / psOnShell;
-    }
+    widNow = GammaRes * particlePtr->channel(iChannel).bRatio()
+           * ps / psOnShell;
+  }
 
-    // Optionally multiply by secondary widths.
-    if (openOnly) widNow *= particlePtr->channel(i).openSec(idSgn);
+  // Done.
+  return widNow;
 
-    // Optionally include factor to force to fixed width.
-    if (doForceWidth) widNow *= forceFactor;
+}
 
-    // Optionally multiply by current/nominal resonance mass??
+//--------------------------------------------------------------------------
 
-    // Sum back up.
-    widSum += widNow;
+// Tabulate the partial widths of all channels as a function of mass,
+// for later linear interpolation, if so requested.
 
-    // Optionally store partial widths for later decay channel choice.
-    if (setBR) particlePtr->channel(i).currentBR(widNow);
+void ResonanceWidths::initTables() {
+
+  // Reset tables. Check whether they should be used.
+  widthTables.clear();
+  useTables     = false;
+  if (particlePtr == 0 || settingsPtr == 0) return;
+  if (!settingsPtr->flag("ResonanceWidths:tabulate")) return;
+  if (particlePtr->sizeChannels() == 0 || !particlePtr->mayDecay()) return;
+  checkTables   = settingsPtr->flag("ResonanceWidths:checkTables");
+  tableAccuracy = settingsPtr->parm("ResonanceWidths:tableAccuracy");
+
+  // Tabulate over the allowed mass range, or up to a multiple of the
+  // nominal mass if there is no upper limit.
+  mMinTable     = max( MASSMIN, particlePtr->mMin());
+  mMaxTable     = (particlePtr->mMax() > particlePtr->mMin())
+                ? particlePtr->mMax() : TABLEMASSMAX * mRes;
+  if (mMaxTable < mMinTable + NTABLE * TABLEMINSTEP * mRes) return;
+
+  // Set up the table used when there is no dependence on incoming flavour.
+  useTables     = true;
+  widthTable(0);
+
+}
+
+//--------------------------------------------------------------------------
+
+// Find the width table for an incoming flavour. The first time, start
+// from an even grid of masses, denser around the peak, and then add
+// further masses where needed.
+
+ResonanceWidthTable& ResonanceWidths::widthTable(int idInFlavIn) {
+
+  // Return the existing table, if there is one.
+  int iFlav = tableFlav(idInFlavIn);
+  map<int, ResonanceWidthTable>::iterator tableItr = widthTables.find(iFlav);
+  if (tableItr != widthTables.end()) return tableItr->second;
+  ResonanceWidthTable& table = widthTables[iFlav];
+
+  // Masses of starting grid.
+  vector<double> massGrid;
+  for (int i = 0; i <= NTABLE; ++i) massGrid.push_back( mMinTable
+    + i * (mMaxTable - mMinTable) / NTABLE);
+  for (int i = -NTABLEPEAK; i <= NTABLEPEAK; ++i) {
+    double massNow = mRes + 0.5 * i * GammaRes;
+    if (massNow > mMinTable && massNow < mMaxTable)
+      massGrid.push_back( massNow);
+  }
+  sort( massGrid.begin(), massGrid.end());
+
+  // Fill table at the grid masses, with refinement in between.
+  vector<double> widA, widB;
+  tableWidths( massGrid[0], iFlav, widA);
+  table.mass.push_back( massGrid[0]);
+  table.widths.push_back( widA);
+  for (int i = 1; i < int(massGrid.size()); ++i) {
+    double massA = table.mass.back();
+    if (massGrid[i] < massA + TABLEMINSTEP * mRes) continue;
+    tableWidths( massGrid[i], iFlav, widB);
+    refineTable( table, iFlav, massA, widA, massGrid[i], widB);
+    table.mass.push_back( massGrid[i]);
+    table.widths.push_back( widB);
+    widA.swap( widB);
+  }
+
+  // Warn if the table could not be made accurate enough.
+  if (int(table.mass.size()) >= NTABLEMAX) {
+    ostringstream osWarn;
+    osWarn << "for id = " << idRes;
+    infoPtr->errorMsg("Warning in ResonanceWidths::widthTable: maximum"
+      " table size reached", osWarn.str());
   }
 
   // Done.
-  return widSum;
+  return table;
+
+}
+
+//--------------------------------------------------------------------------
+
+// Calculate the partial widths of all channels at a given mass, for a
+// given incoming flavour, before secondary open fractions.
+
+void ResonanceWidths::tableWidths(double mHatIn, int idInFlavIn,
+  vector<double>& widths) {
+
+  // Calculate various prefactors for the current mass.
+  mHat          = mHatIn;
+  idInFlav      = idInFlavIn;
+  if (allowCalcWidth) calcPreFac(false);
+
+  // Loop over all decay channels.
+  widths.resize( particlePtr->sizeChannels());
+  for (int i = 0; i < particlePtr->sizeChannels(); ++i)
+    widths[i] = channelWidth(i);
+
+}
+
+//--------------------------------------------------------------------------
+
+// Add masses between two tabulated ones, by repeated halving, until
+// linear interpolation gives the widths at the midpoint within the
+// requested accuracy, relative to the total width there.
+
+void ResonanceWidths::refineTable(ResonanceWidthTable& table,
+  int idInFlavIn, double mA, const vector<double>& widA, double mB,
+  const vector<double>& widB) {
+
+  // Widths at the midpoint, and deviation from interpolation.
+  double mC = 0.5 * (mA + mB);
+  vector<double> widC;
+  tableWidths( mC, idInFlavIn, widC);
+  double widSum = 0.;
+  double widDev = 0.;
+  for (int i = 0; i < int(widC.size()); ++i) {
+    widSum += widC[i];
+    widDev += abs(widC[i] - 0.5 * (widA[i] + widB[i]));
+  }
+
+  // Done if accurate enough, or if no further points can be added.
+  // Safety margin, since the deviation need not be largest at midpoint.
+  if (widDev <= 0.5 * tableAccuracy * widSum
+    || mB - mA < TABLEMINSTEP * mRes
+    || int(table.mass.size()) >= NTABLEMAX) return;
+
+  // Else add midpoint, with further refinement on both sides.
+  refineTable( table, idInFlavIn, mA, widA, mC, widC);
+  table.mass.push_back( mC);
+  table.widths.push_back( widC);
+  refineTable( table, idInFlavIn, mC, widC, mB, widB);
 
 }
 
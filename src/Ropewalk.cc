@@ -407,9 +407,10 @@ pair<int, int> RopeDipole::getOverlaps(double yfrac, double m0, double r0) {
   double yL = d1.rap(m0,rotTo);
   double yS = d2.rap(m0,rotTo);
   double yH = yS + (yL - yS) * yfrac;
+  Vec4 bH = bInterpolateDip(yH,m0);
   int m = 0, n = 0;
   for (size_t i = 0; i < overlaps.size(); ++i) {
-    if (overlaps[i].overlap( yfrac, bInterpolateDip(yH,m0), r0)
+    if (overlaps[i].overlap( yfrac, bH, r0)
       && !overlaps[i].hadronized()) {
         if (overlaps[i].dir > 0) ++m;
         else                     ++n;
@@ -473,12 +474,6 @@ void shove(double dpx, double dpy) {
   }
 }
 
-// The push direction as a four vector.
-Vec4 direction() {
-  return dip1->bInterpolateDip(y,m0) -
-    dip2->bInterpolateDip(y,m0);
-}
-
 // Member variables, slice rapidity and small cut-off mass.
 double y;
 double m0;
@@ -493,6 +488,48 @@ RopeDipole* dip2;
 
 //==========================================================================
 
+// DipolePosition class.
+// It is a helper class to Ropewalk, used to store the position of a dipole
+// at the rapidity of a slice, in the dipole rest frame. It is only
+// recalculated when the momenta or vertices of the dipole ends, which
+// may be shared with neighbouring dipoles, have been changed.
+
+//--------------------------------------------------------------------------
+
+struct DipolePosition {
+
+// The constructor.
+DipolePosition() : isSet(false) { }
+
+// Check if two four-vectors are identical.
+static bool same(const Vec4& a, const Vec4& b) {
+  return a.px() == b.px() && a.py() == b.py() && a.pz() == b.pz()
+    && a.e() == b.e();
+}
+
+// The position of the dipole, updated if the dipole ends have changed.
+const Vec4& at(RopeDipole* dip, double y, double m0) {
+  Particle* end1 = dip->d1Ptr()->getParticlePtr();
+  Particle* end2 = dip->d2Ptr()->getParticlePtr();
+  if ( !isSet || !same(p1, end1->p()) || !same(p2, end2->p())
+    || !same(v1, end1->vProd()) || !same(v2, end2->vProd()) ) {
+    b     = dip->bInterpolateDip(y, m0);
+    p1    = end1->p();
+    p2    = end2->p();
+    v1    = end1->vProd();
+    v2    = end2->vProd();
+    isSet = true;
+  }
+  return b;
+}
+
+// Member variables: the position and the state it was calculated for.
+bool isSet;
+Vec4 b, p1, p2, v1, v2;
+};
+
+//==========================================================================
+
 // Ropewalk class.
 // This class keeps track of all the strings making up ropes for shoving
 // as well as flavour enhancement.
@@ -598,14 +635,18 @@ double Ropewalk::getKappaHere(int e1, int e2, double yfrac) {
 //--------------------------------------------------------------------------
 
 // Calculate all overlaps of all dipoles and store as OverlappingRopeDipoles.
+// Overlaps are defined in the rest frame of each dipole, so all pairs must
+// be tested, but rapidities are found from the dipole index before the
+// full OverlappingRopeDipole is constructed.
 
 bool Ropewalk::calculateOverlaps() {
 
   // Go through all dipoles.
-  for (multimap< pair<int,int>, RopeDipole>::iterator itr = dipoles.begin();
-    itr != dipoles.end(); ++itr ) {
-    RopeDipole* d1 = &(itr->second);
-    if (d1->dipoleMomentum().m2Calc() < pow2(m0)) continue;
+  indexDipoles();
+  int nDip = dipIndex.size();
+  for (int i1 = 0; i1 < nDip; ++i1) {
+    if (!dipIsMassive[i1]) continue;
+    RopeDipole* d1 = dipIndex[i1];
 
     // RopeDipoles rapidities in dipole rest frame.
     RotBstMatrix dipoleRestFrame = d1->getDipoleRestFrame();
@@ -614,19 +655,17 @@ bool Ropewalk::calculateOverlaps() {
     if (yc1 <= ya1) continue;
 
     // Go through all possible overlapping dipoles.
-    for (multimap< pair<int,int>, RopeDipole>::iterator itr2 = dipoles.begin();
-      itr2 != dipoles.end(); ++itr2) {
-      RopeDipole* d2 = &(itr2->second);
+    for (int i2 = 0; i2 < nDip; ++i2) {
 
       // Skip self and overlaps with miniscule dipoles.
-      if (d1 == d2) continue;
-      if (d2->dipoleMomentum().m2Calc() < pow2(m0)) continue;
+      if (i2 == i1 || !dipIsMassive[i2]) continue;
 
       // Ignore if not overlapping in rapidity.
-      OverlappingRopeDipole od(d2, m0, dipoleRestFrame);
-      if (min(od.y1, od.y2) > yc1 || max(od.y1, od.y2) < ya1 || od.y1 == od.y2)
-        continue;
+      double y1 = rapInFrame( dipPEnd1[i2], dipM2End1[i2], dipoleRestFrame);
+      double y2 = rapInFrame( dipPEnd2[i2], dipM2End2[i2], dipoleRestFrame);
+      if (min(y1, y2) > yc1 || max(y1, y2) < ya1 || y1 == y2) continue;
 
+      OverlappingRopeDipole od(dipIndex[i2], m0, dipoleRestFrame);
       d1->addOverlappingDipole(od);
 
     }
@@ -634,6 +673,54 @@ bool Ropewalk::calculateOverlaps() {
   return true;
 
 }
+
+//--------------------------------------------------------------------------
+
+// Index the dipoles in flat arrays, in the order of the dipole map.
+
+void Ropewalk::indexDipoles() {
+
+  dipIndex.resize(0);
+  dipIsMassive.resize(0);
+  dipYMin.resize(0);
+  dipYMax.resize(0);
+  dipM2End1.resize(0);
+  dipM2End2.resize(0);
+  dipPEnd1.resize(0);
+  dipPEnd2.resize(0);
+  for (DMap::iterator dItr = dipoles.begin(); dItr != dipoles.end(); ++dItr) {
+    RopeDipole* dip = &(dItr->second);
+    Particle* end1Ptr = dip->d1Ptr()->getParticlePtr();
+    Particle* end2Ptr = dip->d2Ptr()->getParticlePtr();
+    dipIndex.push_back( dip);
+    dipIsMassive.push_back( dip->dipoleMomentum().m2Calc() >= pow2(m0) );
+    dipYMin.push_back( dip->minRapidity(m0) );
+    dipYMax.push_back( dip->maxRapidity(m0) );
+    dipM2End1.push_back( end1Ptr->m2() );
+    dipM2End2.push_back( end2Ptr->m2() );
+    dipPEnd1.push_back( end1Ptr->p() );
+    dipPEnd2.push_back( end2Ptr->p() );
+  }
+
+}
+
+//--------------------------------------------------------------------------
+
+// Rapidity of a dipole end in a given frame, with the same minimal
+// transverse mass m0 as in Particle::y(m0, r).
+
+double Ropewalk::rapInFrame(const Vec4& p, double m2,
+  const RotBstMatrix& r) {
+
+  Vec4 pCopy = p;
+  pCopy.rotbst(r);
+  double mTmin = max( m0, sqrt( m2 + pCopy.pT2()) );
+  double eMin  = sqrt( pow2(mTmin) + pow2(pCopy.pz()) );
+  double temp  = log( ( eMin + abs(pCopy.pz()) ) / mTmin );
+  return (pCopy.pz() > 0.) ? temp : -temp;
+
+}
+
 //--------------------------------------------------------------------------
 
 // Invoke the random walk of colour states.
@@ -699,41 +786,70 @@ void Ropewalk::shoveTheDipoles(Event& event) {
       dItr->second.propagateInit(tInit);
   }
 
-  // The rapidity slices.
-  multimap<double, RopeDipole *> rapDipoles;
-
-  // Order the dipoles in max rapidity.
+  // Index the dipoles, and order them in max and in min rapidity.
+  indexDipoles();
+  int nDip = dipIndex.size();
+  vector< pair<double,int> > byMax, byMin;
   double ymin = 0;
   double ymax = 0;
-  for (DMap::iterator dItr = dipoles.begin(); dItr != dipoles.end(); ++dItr) {
-    RopeDipole* dip = &(dItr->second);
-    // Order the dipoles in max rapidity.
-    rapDipoles.insert( make_pair(dip->maxRapidity(m0), dip) );
+  for (int iDip = 0; iDip < nDip; ++iDip) {
+    byMax.push_back( make_pair( dipYMax[iDip], iDip) );
+    byMin.push_back( make_pair( dipYMin[iDip], iDip) );
     // Find maximal and minimal rapidity to sample.
-    if (dip->minRapidity(m0) < ymin) ymin = dip->minRapidity(m0);
-    if (dip->maxRapidity(m0) > ymax) ymax = dip->maxRapidity(m0);
+    if (dipYMin[iDip] < ymin) ymin = dipYMin[iDip];
+    if (dipYMax[iDip] > ymax) ymax = dipYMax[iDip];
   }
+  sort( byMax.begin(), byMax.end());
+  sort( byMin.begin(), byMin.end());
+  vector<int> rankMax(nDip);
+  for (int iRank = 0; iRank < nDip; ++iRank)
+    rankMax[byMax[iRank].second] = iRank;
 
   // Do the sampling from flat distribution.
   vector<double> rapidities;
   for (double y = ymin; y < ymax; y += deltay) rapidities.push_back(y);
 
-  // For each value of ySample, we have a vector of excitation pairs.
+  // For each value of ySample, we have a vector of excitation pairs,
+  // and the dipoles sampled in that slice.
   map<double, vector<Exc> > exPairs;
+  vector< vector<RopeDipole*> > sliceDipoles( rapidities.size() );
   for (int i = 0, N = eParticles.size(); i < N; ++i) eParticles[i].clear();
   eParticles.clear();
+
+  // Dipoles sharing each parton, since the recoil of one dipole changes
+  // the rapidity range of its neighbours.
+  map<int, vector<int> > dipolesOfParton;
+  for (int iDip = 0; iDip < nDip; ++iDip) {
+    dipolesOfParton[dipIndex[iDip]->d1Ptr()->getNe()].push_back(iDip);
+    dipolesOfParton[dipIndex[iDip]->d2Ptr()->getNe()].push_back(iDip);
+  }
+  vector<bool> isTouched( nDip, false);
+
+  // Sweep through the slices, keeping track of the dipoles that span
+  // the current rapidity, ordered in max rapidity. Dipoles that have
+  // been changed by a recoil are kept, and their min rapidity checked.
+  set<int> active;
+  int iNextMin = 0;
   for (int i = 0, N = rapidities.size(); i < N; ++i) {
   // Construct an empty vector of excitation particles.
   eParticles.push_back( vector<Particle>() );
 
   // Find dipoles sampled in this slice, and store them temporarily.
   double ySample = rapidities[i];
-  vector<RopeDipole*> tmp;
-  for (multimap<double, RopeDipole*>::iterator
-    rItr = rapDipoles.lower_bound(ySample); rItr != rapDipoles.end(); ++rItr) {
-    if (rItr->second->minRapidity(m0) < ySample)
-      tmp.push_back(rItr->second);
+  while (iNextMin < nDip && byMin[iNextMin].first < ySample)
+    active.insert( rankMax[byMin[iNextMin++].second] );
+  while (!active.empty() && byMax[*active.begin()].first < ySample)
+    active.erase( active.begin() );
+  vector<int> iTmp;
+  for (set<int>::iterator aItr = active.begin(); aItr != active.end();
+    ++aItr) {
+    int iDip = byMax[*aItr].second;
+    if (!isTouched[iDip] || dipIndex[iDip]->minRapidity(m0) < ySample)
+      iTmp.push_back( iDip);
   }
+  vector<RopeDipole*>& tmp = sliceDipoles[i];
+  for (int j = 0, M = iTmp.size(); j < M; ++j)
+    tmp.push_back( dipIndex[iTmp[j]] );
 
   // Construct excitation particles, one for each sampled dipole in this slice.
   vector<int> eraseDipoles;
@@ -748,6 +864,7 @@ void Ropewalk::shoveTheDipoles(Event& event) {
   // Erase dipoles which could not bear an excitation.
   for (int j = 0, M = eraseDipoles.size(); j < M; ++j) {
     tmp.erase( tmp.begin() + (eraseDipoles[j]-j) );
+    iTmp.erase( iTmp.begin() + (eraseDipoles[j]-j) );
   }
   // Add the actual excitations, but only if we can create pairs.
   if( int(tmp.size()) > 1)
@@ -755,6 +872,17 @@ void Ropewalk::shoveTheDipoles(Event& event) {
       Vec4 ex;
       // We boost the excitation back from dipole rest frame.
       tmp[j]->recoil(ex,false);
+      // Mark the dipole and its neighbours as changed.
+      for (int iEnd = 0; iEnd < 2; ++iEnd) {
+        int iParton = (iEnd == 0) ? tmp[j]->d1Ptr()->getNe()
+          : tmp[j]->d2Ptr()->getNe();
+        vector<int>& iNeighbours = dipolesOfParton[iParton];
+        for (int iN = 0, NN = iNeighbours.size(); iN < NN; ++iN)
+        if (!isTouched[iNeighbours[iN]]) {
+          isTouched[iNeighbours[iN]] = true;
+          active.insert( rankMax[iNeighbours[iN]] );
+        }
+      }
       Particle pp = Particle(21, 22, 0, 0, 0, 0, 0, 0, ex);
       pp.vProd( FM2MM * tmp[j]->bInterpolateLab(ySample,m0) );
       eParticles[i].push_back(pp);
@@ -779,6 +907,11 @@ void Ropewalk::shoveTheDipoles(Event& event) {
     }
   }
 
+  // Positions of the dipoles in each slice.
+  vector< vector<DipolePosition> > bSlice( rapidities.size() );
+  for (int i = 0, N = rapidities.size(); i < N; ++i)
+    bSlice[i].resize( sliceDipoles[i].size() );
+
   // Shoving loop.
   for (double t = tInit; t < tShove + tInit; t += deltat) {
     // For all slices.
@@ -788,7 +921,8 @@ void Ropewalk::shoveTheDipoles(Event& event) {
       for (int i = 0, N = slItr->second.size(); i < N; ++i) {
         Exc& ep = slItr->second[i];
         // The direction vector is a space-time four-vector.
-        Vec4 direction = ep.direction();
+        Vec4 direction = bSlice[ep.i][ep.j].at( ep.dip1, ep.y, m0)
+          - bSlice[ep.i][ep.k].at( ep.dip2, ep.y, m0);
         // The string radius is time dependent,
         // growing with the speed of light.
         // Minimal string size is 1 / shower cut-off
@@ -886,6 +1020,11 @@ const double RopeFragPars::ACONV = 0.001;
 // Low z cut-off in fragmentation function.
 const double RopeFragPars::ZCUT = 1.0e-4;
 
+// Number of parameter table points per unit of h, and the largest h
+// tabulated. Beyond that parameters are calculated each time.
+const int    RopeFragPars::NTABPERUNIT = 100;
+const double RopeFragPars::HTABMAX     = 100.;
+
 //--------------------------------------------------------------------------
 
 // The init function sets up initial parameters from settings.
@@ -908,38 +1047,58 @@ void RopeFragPars::init(Info* infoPtrIn, Settings& settings) {
     &yIn, &xiIn, &kappaIn};
   for (int i = 0; i < len; ++i) *variables[i] = settings.parm(params[i]);
 
-  // Insert the h = 1 case immediately.
+  // Book the parameter table, and insert the h = 1 case immediately.
+  int nTab = int(HTABMAX * NTABPERUNIT) + 2;
+  parTable.assign( nTab, FlavZpTPars());
+  parFilled.assign( nTab, false);
   sigmaEff = sigmaIn, aEff = aIn, adiqEff = adiqIn, bEff = bIn,
     rhoEff = rhoIn, xEff = xIn, yEff = yIn, xiEff = xiIn, kappaEff = kappaIn;
-  if (!insertEffectiveParameters(1.0)) infoPtr->errorMsg(
-    "Error in RopeFragPars::init: failed to insert defaults.");
+  parTable[NTABPERUNIT]  = effectiveParameters();
+  parFilled[NTABPERUNIT] = true;
+  hExact = -1.;
 
 }
 
 //--------------------------------------------------------------------------
 
-// Return parameters at given string tension, ordered by their
-// name for easy insertion in settings.
-
-map<string,double> RopeFragPars::getEffectiveParameters(double h) {
-
-  map<double, map<string, double> >::iterator parItr = parameters.find(h);
-
-  // If the parameters are already calculated, return them.
-  if ( parItr != parameters.end()) return parItr->second;
+// Return parameters at given string tension. By default interpolated
+// linearly in a dense table, which is filled on demand.
+
+FlavZpTPars RopeFragPars::getEffectiveParameters(double h, bool exact) {
+
+  // Table lookup when inside its range.
+  double hTab = h * NTABPERUNIT;
+  if (!exact && h >= 1. / NTABPERUNIT && h < HTABMAX) {
+    int    iTab = int(hTab);
+    double wt   = hTab - iTab;
+    const FlavZpTPars& lo = tableEntry(iTab);
+    if (wt == 0.) return lo;
+    const FlavZpTPars& hi = tableEntry(iTab + 1);
+    FlavZpTPars par;
+    par.probStoUD     = lo.probStoUD + wt * (hi.probStoUD - lo.probStoUD);
+    par.probSQtoQQ    = lo.probSQtoQQ + wt * (hi.probSQtoQQ - lo.probSQtoQQ);
+    par.probQQ1toQQ0  = lo.probQQ1toQQ0
+                      + wt * (hi.probQQ1toQQ0 - lo.probQQ1toQQ0);
+    par.probQQtoQ     = lo.probQQtoQ + wt * (hi.probQQtoQ - lo.probQQtoQ);
+    par.aLund         = lo.aLund + wt * (hi.aLund - lo.aLund);
+    par.bLund         = lo.bLund + wt * (hi.bLund - lo.bLund);
+    par.aExtraDiquark = lo.aExtraDiquark
+                      + wt * (hi.aExtraDiquark - lo.aExtraDiquark);
+    par.sigma         = lo.sigma + wt * (hi.sigma - lo.sigma);
+    return par;
+  }
 
-  // Otherwise calculate them.
-  if (!calculateEffectiveParameters(h))
+  // Else exact calculation, remembering the latest one.
+  if (h == hExact) return parExact;
+  if (h == 1.) return parTable[NTABPERUNIT];
+  if (!calculateEffectiveParameters(h)) {
     infoPtr->errorMsg("Error in RopeFragPars::getEffectiveParameters:"
       " calculating effective parameters.");
-
-  // And insert them.
-  if (!insertEffectiveParameters(h))
-    infoPtr->errorMsg("Error in RopeFragPars::getEffectiveParameters:"
-      " inserting effective parameters.");
-
-  // And recurse.
-  return getEffectiveParameters(h);
+    return parTable[NTABPERUNIT];
+  }
+  hExact   = h;
+  parExact = effectiveParameters();
+  return parExact;
 
 }
 
@@ -1020,22 +1179,37 @@ bool RopeFragPars::calculateEffectiveParameters(double h) {
 
 //--------------------------------------------------------------------------
 
-// Insert calculated parameters in cache for later (re-)use.
+// Collect the current effective parameters.
 
-bool RopeFragPars::insertEffectiveParameters(double h) {
+FlavZpTPars RopeFragPars::effectiveParameters() {
 
-  map<string,double> p;
-  p["StringPT:sigma"]          = sigmaEff;
-  p["StringZ:bLund"]           = bEff;
-  p["StringFlav:probStoUD"]    = rhoEff;
-  p["StringFlav:probSQtoQQ"]   = xEff;
-  p["StringFlav:probQQ1toQQ0"] = yEff;
-  p["StringFlav:probQQtoQ"]    = xiEff;
-  p["StringZ:aLund"]           = aEff;
-  p["StringZ:aExtraDiquark"]   = adiqEff;
-  p["StringFlav:kappa"]        = kappaEff;
+  FlavZpTPars p;
+  p.sigma         = sigmaEff;
+  p.bLund         = bEff;
+  p.probStoUD     = rhoEff;
+  p.probSQtoQQ    = xEff;
+  p.probQQ1toQQ0  = yEff;
+  p.probQQtoQ     = xiEff;
+  p.aLund         = aEff;
+  p.aExtraDiquark = adiqEff;
+  return p;
 
-  return (parameters.insert( make_pair(h,p)).second );
+}
+
+//--------------------------------------------------------------------------
+
+// Return table entry, calculating it first if needed.
+
+const FlavZpTPars& RopeFragPars::tableEntry(int iTab) {
+
+  if (!parFilled[iTab]) {
+    if (!calculateEffectiveParameters( double(iTab) / NTABPERUNIT))
+      infoPtr->errorMsg("Error in RopeFragPars::tableEntry:"
+        " calculating effective parameters.");
+    parTable[iTab]  = effectiveParameters();
+    parFilled[iTab] = true;
+  }
+  return parTable[iTab];
 
 }
 
@@ -1143,18 +1317,13 @@ bool FlavourRope::doChangeFragPar(StringFlav* flavPtr, StringZ* zPtr,
  StringPT * pTPtr, double m2Had, vector<int> iParton, int endId) {
 
   // The new parameters.
-  map<string, double> newPar;
-  if (doBuffon)
-    newPar = fetchParametersBuffon(m2Had, iParton, endId);
-  else
-    newPar = fetchParameters(m2Had, iParton, endId);
-  // Change settings to new settings.
-  for (map<string, double>::iterator itr = newPar.begin(); itr!=newPar.end();
-    ++itr) settingsPtr->parm( itr->first, itr->second);
-  // Re-initialize flavour, z, and pT selection with new settings.
-  flavPtr->init( *settingsPtr, particleDataPtr, rndmPtr, infoPtr);
-  zPtr->init( *settingsPtr, *particleDataPtr, rndmPtr, infoPtr);
-  pTPtr->init( *settingsPtr, particleDataPtr, rndmPtr, infoPtr);
+  FlavZpTPars newPar = (doBuffon)
+    ? fetchParametersBuffon(m2Had, iParton, endId)
+    : fetchParameters(m2Had, iParton, endId);
+  // Swap them directly into flavour, z, and pT selection.
+  flavPtr->setPars(newPar);
+  zPtr->setPars(newPar);
+  pTPtr->setPars(newPar);
   return true;
 
 }
@@ -1163,10 +1332,10 @@ bool FlavourRope::doChangeFragPar(StringFlav* flavPtr, StringZ* zPtr,
 
 // Find breakup placement and fetch effective parameters using Buffon.
 
-map<string, double> FlavourRope::fetchParametersBuffon(double m2Had,
+FlavZpTPars FlavourRope::fetchParametersBuffon(double m2Had,
   vector<int> iParton, int endId) {
   // If effective string tension is set manually, use that.
-  if (fixedKappa) return fp.getEffectiveParameters(h);
+  if (fixedKappa) return fp.getEffectiveParameters(h, true);
   if (!ePtr) {
     infoPtr->errorMsg("Error in FlavourRope::fetchParametersBuffon:"
       " Event pointer not set in FlavourRope");
@@ -1300,10 +1469,10 @@ map<string, double> FlavourRope::fetchParametersBuffon(double m2Had,
 //--------------------------------------------------------------------------
 // Find breakup placement and fetch effective parameters using Ropewalk.
 
-map<string, double> FlavourRope::fetchParameters(double m2Had,
+FlavZpTPars FlavourRope::fetchParameters(double m2Had,
   vector<int> iParton, int endId) {
   // If effective string tension is set manually, use that.
-  if (fixedKappa) return fp.getEffectiveParameters(h);
+  if (fixedKappa) return fp.getEffectiveParameters(h, true);
   if (!ePtr) {
     infoPtr->errorMsg("Error in FlavourRope::fetchParameters:"
       " Event pointer not set in FlavourRope");
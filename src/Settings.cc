@@ -14,6 +14,28 @@ namespace Pythia8 {
 
 //==========================================================================
 
+// Handles to current values of flags, modes, parms and words.
+
+//--------------------------------------------------------------------------
+
+// Values pointed to by default-constructed handles.
+
+const bool   FlagRef::DEFAULTVAL = false;
+const int    ModeRef::DEFAULTVAL = 0;
+const double ParmRef::DEFAULTVAL = 0.;
+const string WordRef::DEFAULTVAL = " ";
+
+//==========================================================================
+
+// Helper class for reading a binary snapshot.
+
+//--------------------------------------------------------------------------
+
+// Sanity limit on the length of strings and vectors in a snapshot.
+const int SnapshotReader::MAXSIZE = 100000000;
+
+//==========================================================================
+
 // Settings class.
 // This class contains flags, modes, parms and words used in generation.
 
@@ -980,6 +1002,196 @@ bool Settings::writeFileXML(ostream& os) {
 
 //--------------------------------------------------------------------------
 
+// Write the complete database in binary form, map by map, in the
+// order of the keys. Both key and name are stored, to save time.
+
+bool Settings::writeSnapshot(ostream& os) {
+
+  SnapshotWriter out(os);
+  out.write( int(flags.size()));
+  for (map<string, Flag>::iterator it = flags.begin(); it != flags.end();
+    ++it) {
+    out.write( it->first);
+    out.write( it->second.name);
+    out.write( it->second.valNow);
+    out.write( it->second.valDefault);
+  }
+  out.write( int(modes.size()));
+  for (map<string, Mode>::iterator it = modes.begin(); it != modes.end();
+    ++it) {
+    out.write( it->first);
+    out.write( it->second.name);
+    out.write( it->second.valNow);
+    out.write( it->second.valDefault);
+    out.write( it->second.hasMin);
+    out.write( it->second.hasMax);
+    out.write( it->second.valMin);
+    out.write( it->second.valMax);
+    out.write( it->second.optOnly);
+  }
+  out.write( int(parms.size()));
+  for (map<string, Parm>::iterator it = parms.begin(); it != parms.end();
+    ++it) {
+    out.write( it->first);
+    out.write( it->second.name);
+    out.write( it->second.valNow);
+    out.write( it->second.valDefault);
+    out.write( it->second.hasMin);
+    out.write( it->second.hasMax);
+    out.write( it->second.valMin);
+    out.write( it->second.valMax);
+  }
+  out.write( int(words.size()));
+  for (map<string, Word>::iterator it = words.begin(); it != words.end();
+    ++it) {
+    out.write( it->first);
+    out.write( it->second.name);
+    out.write( it->second.valNow);
+    out.write( it->second.valDefault);
+  }
+  out.write( int(fvecs.size()));
+  for (map<string, FVec>::iterator it = fvecs.begin(); it != fvecs.end();
+    ++it) {
+    out.write( it->first);
+    out.write( it->second.name);
+    out.write( it->second.valNow);
+    out.write( it->second.valDefault);
+  }
+  out.write( int(mvecs.size()));
+  for (map<string, MVec>::iterator it = mvecs.begin(); it != mvecs.end();
+    ++it) {
+    out.write( it->first);
+    out.write( it->second.name);
+    out.write( it->second.valNow);
+    out.write( it->second.valDefault);
+    out.write( it->second.hasMin);
+    out.write( it->second.hasMax);
+    out.write( it->second.valMin);
+    out.write( it->second.valMax);
+  }
+  out.write( int(pvecs.size()));
+  for (map<string, PVec>::iterator it = pvecs.begin(); it != pvecs.end();
+    ++it) {
+    out.write( it->first);
+    out.write( it->second.name);
+    out.write( it->second.valNow);
+    out.write( it->second.valDefault);
+    out.write( it->second.hasMin);
+    out.write( it->second.hasMax);
+    out.write( it->second.valMin);
+    out.write( it->second.valMax);
+  }
+  out.write( int(wvecs.size()));
+  for (map<string, WVec>::iterator it = wvecs.begin(); it != wvecs.end();
+    ++it) {
+    out.write( it->first);
+    out.write( it->second.name);
+    out.write( it->second.valNow);
+    out.write( it->second.valDefault);
+  }
+
+  // Done.
+  return out.good();
+}
+
+//--------------------------------------------------------------------------
+
+// Read the complete database in binary form, as written by writeSnapshot.
+// Keys come in order, so each new entry is inserted at the end of a map.
+
+bool Settings::readSnapshot(istream& is) {
+
+  // Reset whole database, including readString history.
+  flags.clear();
+  modes.clear();
+  parms.clear();
+  words.clear();
+  fvecs.clear();
+  mvecs.clear();
+  pvecs.clear();
+  wvecs.clear();
+  readStringHistory.resize(0);
+  readStringSubrun.clear();
+  isInit = false;
+  SnapshotReader in(is);
+  string key;
+  int n;
+
+  // Read flags, modes, parms and words.
+  if (!in.read(n)) return false;
+  for (int i = 0; i < n; ++i) {
+    Flag entry;
+    if ( !in.read(key) || !in.read(entry.name) || !in.read(entry.valNow)
+      || !in.read(entry.valDefault) ) return false;
+    flags.insert( flags.end(), make_pair( key, entry));
+  }
+  if (!in.read(n)) return false;
+  for (int i = 0; i < n; ++i) {
+    Mode entry;
+    if ( !in.read(key) || !in.read(entry.name) || !in.read(entry.valNow)
+      || !in.read(entry.valDefault) || !in.read(entry.hasMin)
+      || !in.read(entry.hasMax) || !in.read(entry.valMin)
+      || !in.read(entry.valMax) || !in.read(entry.optOnly) ) return false;
+    modes.insert( modes.end(), make_pair( key, entry));
+  }
+  if (!in.read(n)) return false;
+  for (int i = 0; i < n; ++i) {
+    Parm entry;
+    if ( !in.read(key) || !in.read(entry.name) || !in.read(entry.valNow)
+      || !in.read(entry.valDefault) || !in.read(entry.hasMin)
+      || !in.read(entry.hasMax) || !in.read(entry.valMin)
+      || !in.read(entry.valMax) ) return false;
+    parms.insert( parms.end(), make_pair( key, entry));
+  }
+  if (!in.read(n)) return false;
+  for (int i = 0; i < n; ++i) {
+    Word entry;
+    if ( !in.read(key) || !in.read(entry.name) || !in.read(entry.valNow)
+      || !in.read(entry.valDefault) ) return false;
+    words.insert( words.end(), make_pair( key, entry));
+  }
+
+  // Read vectors of flags, modes, parms and words.
+  if (!in.read(n)) return false;
+  for (int i = 0; i < n; ++i) {
+    FVec entry;
+    if ( !in.read(key) || !in.read(entry.name) || !in.read(entry.valNow)
+      || !in.read(entry.valDefault) ) return false;
+    fvecs.insert( fvecs.end(), make_pair( key, entry));
+  }
+  if (!in.read(n)) return false;
+  for (int i = 0; i < n; ++i) {
+    MVec entry;
+    if ( !in.read(key) || !in.read(entry.name) || !in.read(entry.valNow)
+      || !in.read(entry.valDefault) || !in.read(entry.hasMin)
+      || !in.read(entry.hasMax) || !in.read(entry.valMin)
+      || !in.read(entry.valMax) ) return false;
+    mvecs.insert( mvecs.end(), make_pair( key, entry));
+  }
+  if (!in.read(n)) return false;
+  for (int i = 0; i < n; ++i) {
+    PVec entry;
+    if ( !in.read(key) || !in.read(entry.name) || !in.read(entry.valNow)
+      || !in.read(entry.valDefault) || !in.read(entry.hasMin)
+      || !in.read(entry.hasMax) || !in.read(entry.valMin)
+      || !in.read(entry.valMax) ) return false;
+    pvecs.insert( pvecs.end(), make_pair( key, entry));
+  }
+  if (!in.read(n)) return false;
+  for (int i = 0; i < n; ++i) {
+    WVec entry;
+    if ( !in.read(key) || !in.read(entry.name) || !in.read(entry.valNow)
+      || !in.read(entry.valDefault) ) return false;
+    wvecs.insert( wvecs.end(), make_pair( key, entry));
+  }
+
+  // Done.
+  isInit = true;
+  return true;
+}
+
+//--------------------------------------------------------------------------
+
 // Print out table of database in lexigraphical order.
 
 void Settings::list(bool doListAll,  bool doListString, string match) {
@@ -1406,25 +1618,45 @@ void Settings::resetAll() {
 // Give back current value, with check that key exists.
 
 bool Settings::flag(string keyIn) {
-  if (isFlag(keyIn)) return flags[toLower(keyIn)].valNow;
+  string keyLower = toLower(keyIn);
+#ifdef PYTHIA8_COUNT_LOOKUPS
+  if (countLookupsNow) ++lookupCounts[keyLower];
+#endif
+  map<string, Flag>::iterator flagEntry = flags.find(keyLower);
+  if (flagEntry != flags.end()) return flagEntry->second.valNow;
   infoPtr->errorMsg("Error in Settings::flag: unknown key", keyIn);
   return false;
 }
 
 int Settings::mode(string keyIn) {
-  if (isMode(keyIn)) return modes[toLower(keyIn)].valNow;
+  string keyLower = toLower(keyIn);
+#ifdef PYTHIA8_COUNT_LOOKUPS
+  if (countLookupsNow) ++lookupCounts[keyLower];
+#endif
+  map<string, Mode>::iterator modeEntry = modes.find(keyLower);
+  if (modeEntry != modes.end()) return modeEntry->second.valNow;
   infoPtr->errorMsg("Error in Settings::mode: unknown key", keyIn);
   return 0;
 }
 
 double Settings::parm(string keyIn) {
-  if (isParm(keyIn)) return parms[toLower(keyIn)].valNow;
+  string keyLower = toLower(keyIn);
+#ifdef PYTHIA8_COUNT_LOOKUPS
+  if (countLookupsNow) ++lookupCounts[keyLower];
+#endif
+  map<string, Parm>::iterator parmEntry = parms.find(keyLower);
+  if (parmEntry != parms.end()) return parmEntry->second.valNow;
   infoPtr->errorMsg("Error in Settings::parm: unknown key", keyIn);
   return 0.;
 }
 
 string Settings::word(string keyIn) {
-  if (isWord(keyIn)) return words[toLower(keyIn)].valNow;
+  string keyLower = toLower(keyIn);
+#ifdef PYTHIA8_COUNT_LOOKUPS
+  if (countLookupsNow) ++lookupCounts[keyLower];
+#endif
+  map<string, Word>::iterator wordEntry = words.find(keyLower);
+  if (wordEntry != words.end()) return wordEntry->second.valNow;
   infoPtr->errorMsg("Error in Settings::word: unknown key", keyIn);
   return " ";
 }
@@ -1455,6 +1687,39 @@ vector<string> Settings::wvec(string keyIn) {
 
 //--------------------------------------------------------------------------
 
+// Give back handle to current value, with check that key exists.
+// Unknown keys give a handle to a default value.
+
+FlagRef Settings::flagRef(string keyIn) {
+  map<string, Flag>::iterator flagEntry = flags.find(toLower(keyIn));
+  if (flagEntry != flags.end()) return FlagRef(&flagEntry->second.valNow);
+  infoPtr->errorMsg("Error in Settings::flagRef: unknown key", keyIn);
+  return FlagRef();
+}
+
+ModeRef Settings::modeRef(string keyIn) {
+  map<string, Mode>::iterator modeEntry = modes.find(toLower(keyIn));
+  if (modeEntry != modes.end()) return ModeRef(&modeEntry->second.valNow);
+  infoPtr->errorMsg("Error in Settings::modeRef: unknown key", keyIn);
+  return ModeRef();
+}
+
+ParmRef Settings::parmRef(string keyIn) {
+  map<string, Parm>::iterator parmEntry = parms.find(toLower(keyIn));
+  if (parmEntry != parms.end()) return ParmRef(&parmEntry->second.valNow);
+  infoPtr->errorMsg("Error in Settings::parmRef: unknown key", keyIn);
+  return ParmRef();
+}
+
+WordRef Settings::wordRef(string keyIn) {
+  map<string, Word>::iterator wordEntry = words.find(toLower(keyIn));
+  if (wordEntry != words.end()) return WordRef(&wordEntry->second.valNow);
+  infoPtr->errorMsg("Error in Settings::wordRef: unknown key", keyIn);
+  return WordRef();
+}
+
+//--------------------------------------------------------------------------
+
 // Give back default value, with check that key exists.
 
 bool Settings::flagDefault(string keyIn) {
@@ -1763,6 +2028,50 @@ void Settings::resetWVec(string keyIn) {
 
 //--------------------------------------------------------------------------
 
+// List the string-keyed value lookups made while counting was on,
+// most frequent first. Only available when compiled for it.
+
+void Settings::listLookups() {
+
+#ifdef PYTHIA8_COUNT_LOOKUPS
+  // Sort keys by number of lookups.
+  multimap<long, string> sorted;
+  long nSum = 0;
+  for (map<string, long>::iterator lookupEntry = lookupCounts.begin();
+    lookupEntry != lookupCounts.end(); ++lookupEntry) {
+    sorted.insert( make_pair(lookupEntry->second, lookupEntry->first) );
+    nSum += lookupEntry->second;
+  }
+
+  // Header.
+  cout << "\n *-------  PYTHIA Settings Lookup Statistics  -------------"
+       << "------*\n"
+       << " |                                                            "
+       << "   |\n"
+       << " |      times   key                                           "
+       << "   |\n"
+       << " |                                                            "
+       << "   |\n";
+
+  // Print keys, most frequent first.
+  for (multimap<long, string>::reverse_iterator sortEntry = sorted.rbegin();
+    sortEntry != sorted.rend(); ++sortEntry)
+    cout << " | " << setw(10) << sortEntry->first << "   " << left
+         << setw(48) << sortEntry->second << right << " |\n";
+  cout << " | " << setw(10) << nSum << "   " << left << setw(48) << "sum"
+       << right << " |\n";
+
+  // Listing finished.
+  cout << " |                                                            "
+       << "   |\n"
+       << " *-------  End PYTHIA Settings Lookup Statistics  ---------"
+       << "------*" << endl;
+#endif
+
+}
+
+//--------------------------------------------------------------------------
+
 // Check whether any other processes than SoftQCD are switched on.
 
 bool Settings::onlySoftQCD() {
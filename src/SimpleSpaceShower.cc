@@ -116,6 +116,10 @@ void SimpleSpaceShower::init( BeamParticle* beamAPtrIn,
   pTmaxFudgeMPI   = settingsPtr->parm("SpaceShower:pTmaxFudgeMPI");
   pTdampFudge     = settingsPtr->parm("SpaceShower:pTdampFudge");
 
+  // Setting read during the evolution. Dire settings may be absent.
+  if (settingsPtr->isParm("Dire:Sudakov:Min"))
+    sudakovMin = settingsPtr->parmRef("Dire:Sudakov:Min");
+
   // Optionally force emissions to be ordered in rapidity/angle.
   doRapidityOrder    = settingsPtr->flag("SpaceShower:rapidityOrder");
   doRapidityOrderMPI = settingsPtr->flag("SpaceShower:rapidityOrderMPI");
@@ -812,7 +816,7 @@ double SimpleSpaceShower::noEmissionProbability( double pTbegAll,
 
   // Calculate the value of the no-emssion probabilty.
   wt /= nTrials;
-  if (wt < settingsPtr->parm("Dire:Sudakov:Min")) wt = 0.;
+  if (wt < sudakovMin()) wt = 0.;
 
   // Clean up, done.
   beamAPtr->clear();
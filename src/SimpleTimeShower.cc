@@ -109,6 +109,13 @@ void SimpleTimeShower::init( BeamParticle* beamAPtrIn,
   pTmaxFudgeMPI      = settingsPtr->parm("TimeShower:pTmaxFudgeMPI");
   pTdampFudge        = settingsPtr->parm("TimeShower:pTdampFudge");
 
+  // Settings read during the evolution. Dire settings may be absent.
+  setScalesFromLHEF
+    = settingsPtr->flagRef("Beams:setProductionScalesFromLHEF");
+  nPartonsInBorn     = settingsPtr->modeRef("TimeShower:nPartonsInBorn");
+  if (settingsPtr->isParm("Dire:Sudakov:Min"))
+    sudakovMin = settingsPtr->parmRef("Dire:Sudakov:Min");
+
   // Charm and bottom mass thresholds.
   mc                 = max( MCMIN, particleDataPtr->m0(4));
   mb                 = max( MBMIN, particleDataPtr->m0(5));
@@ -201,6 +208,11 @@ void SimpleTimeShower::init( BeamParticle* beamAPtrIn,
   // Flag to allow to start from a scale smaller than scalup.
   limitMUQ           = settingsPtr->flag("TimeShower:limitPTmaxGlobal");
 
+  // Reuse of trial emissions for dipole ends unchanged by a branching.
+  cacheTrials        = settingsPtr->flag("TimeShower:cacheTrials");
+  useTrialCache      = false;
+  nBeamChange        = 0;
+
   // Fraction and colour factor of gluon emission off onium octat state.
   octetOniumFraction = settingsPtr->parm("TimeShower:octetOniumFraction");
   octetOniumColFac   = settingsPtr->parm("TimeShower:octetOniumColFac");
@@ -604,7 +616,7 @@ void SimpleTimeShower::prepareGlobal( Event& event) {
   nHard      = 0;
   nProposed.clear();
   hardPartons.resize(0);
-  nFinalBorn = settingsPtr->mode("TimeShower:nPartonsInBorn");
+  nFinalBorn = nPartonsInBorn();
 
   // Global recoils: store positions of hard outgoing partons.
   // No global recoil for H events.
@@ -643,6 +655,9 @@ void SimpleTimeShower::prepare( int iSys, Event& event, bool limitPTmaxIn) {
   // Reset W/Z radiation flag at first call for new event.
   if (iSys == 0) hasWeaklyRadiated = false;
 
+  // A new system may change the beams seen by existing dipole ends.
+  ++nBeamChange;
+
   // Reset dipole-ends list for first interaction and for resonance decays.
   int iInA = partonSystemsPtr->getInA(iSys);
   int iInB = partonSystemsPtr->getInB(iSys);
@@ -948,6 +963,9 @@ void SimpleTimeShower::rescatterUpdate( int iSys, Event& event) {
 
   void SimpleTimeShower::update( int iSys, Event& event, bool hasWeakRad) {
 
+  // The initial-state branching has changed the beams.
+  ++nBeamChange;
+
   // Start list of rescatterers that gave further changed systems in ISR.
   vector<int> iRescatterer;
 
@@ -1467,7 +1485,7 @@ void SimpleTimeShower::setupQCDdip( int iSys, int i, int colTag, int colSign,
 
     // If requested, force maximal pT to LHEF input value.
     if ( abs(event[iRad].status()) > 20 &&  abs(event[iRad].status()) < 24
-      && settingsPtr->flag("Beams:setProductionScalesFromLHEF")
+      && setScalesFromLHEF()
       && event[iRad].scale() > 0.)
       pTmax = event[iRad].scale();
 
@@ -2015,6 +2033,18 @@ double SimpleTimeShower::pTnext( Event& event, double pTbegAll,
   enhanceFactors.clear();
   if (hasUserHooks) userHooksPtr->setEnhancedTrial(0., 1.);
 
+  // Optionally reuse the trial emissions of dipole ends unchanged since
+  // the previous call. Not for global recoil, enhanced emissions or
+  // uncertainty variations, where the trials depend on further state.
+  useTrialCache = cacheTrials && !globalRecoil && !canEnhanceET
+               && !doUncertainties;
+
+  // Event properties for global recoil are found when first needed.
+  nFinalColNow = -1;
+  hasHardFinal = false;
+  hardDescendant.clear();
+  iHardFinal.clear();
+
   for (int iDip = 0; iDip < int(dipEnd.size()); ++iDip) {
     TimeDipoleEnd& dip = dipEnd[iDip];
     dip.pAccept        = 1.0;
@@ -2031,9 +2061,8 @@ double SimpleTimeShower::pTnext( Event& event, double pTbegAll,
     // Do not use global recoil if the radiator line has already branched.
     if (globalRecoilMode == 1 && isQCD) {
       if (globalRecoil && hardSystem) useLocalRecoilNow = true;
-      for (int iHard = 0; iHard < int(hardPartons.size()); ++iHard)
-        if ( event[dip.iRadiator].isAncestor(hardPartons[iHard]) )
-          useLocalRecoilNow = false;
+      if ( isHardDescendant( event, dip.iRadiator) )
+        useLocalRecoilNow = false;
       // Check if global recoil should be used.
       if ( !globalRecoil || nGlobal >= nMaxGlobalBranch )
         useLocalRecoilNow = true;
@@ -2042,10 +2071,12 @@ double SimpleTimeShower::pTnext( Event& event, double pTbegAll,
       useLocalRecoilNow = !(globalRecoil && hardSystem
         && nProposed.find(dip.system) != nProposed.end()
         && nProposed[dip.system]-infoPtr->getCounter(40) == 0);
-      int nFinal = 0;
-      for (int k = 0; k < int(event.size()); ++k)
-        if ( event[k].isFinal() && event[k].colType() != 0) nFinal++;
-      bool isFirst = (nHard == nFinal);
+      if (nFinalColNow < 0) {
+        nFinalColNow = 0;
+        for (int k = 0; k < int(event.size()); ++k)
+          if ( event[k].isFinal() && event[k].colType() != 0) nFinalColNow++;
+      }
+      bool isFirst = (nHard == nFinalColNow);
 
       // Switch off global recoil after first emission
       if ( globalRecoil && doInterleave && !isFirst )
@@ -2063,23 +2094,27 @@ double SimpleTimeShower::pTnext( Event& event, double pTbegAll,
 
     // Dipole properties, alternative global recoil. Squares.
     } else {
-      Vec4 pSumGlobal;
       // Include all particles in all hard systems (hard production system,
       // systems of resonance decay products) in the global recoil momentum.
-      for (int iS = 0; iS < partonSystemsPtr->sizeSys(); ++iS) {
-        for (int i = 0; i < partonSystemsPtr->sizeOut(iS); ++i) {
-          int ii = partonSystemsPtr->getOut( iS, i);
-          bool hasHardAncestor = event[ii].statusAbs() < 23;
-          for (int iHard = 0; iHard < int(hardPartons.size()); ++iHard) {
-            if ( event[ii].isAncestor(hardPartons[iHard])
-              || ii == hardPartons[iHard]
-              || (event[ii].status() == 23 && event[ii].colType() == 0) )
-              hasHardAncestor = true;
+      // They are the same for all dipole ends, except for the radiator.
+      if (!hasHardFinal) {
+        for (int iS = 0; iS < partonSystemsPtr->sizeSys(); ++iS) {
+          for (int i = 0; i < partonSystemsPtr->sizeOut(iS); ++i) {
+            int ii = partonSystemsPtr->getOut( iS, i);
+            bool hasHardAncestor = event[ii].statusAbs() < 23
+              || (!hardPartons.empty() && event[ii].status() == 23
+                && event[ii].colType() == 0)
+              || isHardDescendant( event, ii);
+            if (hasHardAncestor && event[ii].isFinal())
+              iHardFinal.push_back(ii);
           }
-          if (hasHardAncestor && ii !=  dip.iRadiator && event[ii].isFinal() )
-            pSumGlobal += event[ii].p();
         }
+        hasHardFinal = true;
       }
+      Vec4 pSumGlobal;
+      for (int i = 0; i < int(iHardFinal.size()); ++i)
+        if (iHardFinal[i] != dip.iRadiator)
+          pSumGlobal += event[iHardFinal[i]].p();
       dip.mRec = pSumGlobal.mCalc();
       dip.mDip = m( event[dip.iRadiator].p(), pSumGlobal);
     }
@@ -2109,6 +2144,23 @@ double SimpleTimeShower::pTnext( Event& event, double pTbegAll,
       pT2begDip = min( pow2(muQ), min(pow2(pTbegDip), 0.25 * m2DC) );
     }
 
+    // Reuse a trial emission that is still valid for this dipole end.
+    // Else resume the evolution from where the last one was stopped.
+    double pT2resume = pT2begDip;
+    if (useTrialCache && hasValidTrial( dip, pT2begDip)) {
+      if (dip.pT2 > 0.) {
+        if (dip.pT2 > pT2sel) {
+          pT2sel  = dip.pT2;
+          dipSel  = &dip;
+          iDipSel = iDip;
+          splittingNameSel = "";
+        }
+        continue;
+      }
+      pT2resume = min( pT2begDip, dip.pT2endTrial);
+      pT2begDip = dip.pT2begTrial;
+    }
+
     // Do not try splitting if the corrected dipole mass is negative.
     dip.pT2 = 0.;
     if (dip.m2DipCorr < 0.) {
@@ -2118,26 +2170,32 @@ double SimpleTimeShower::pTnext( Event& event, double pTbegAll,
     }
 
     // Do QCD, QED, weak or HV evolution if it makes sense.
-    if (pT2begDip > pT2sel) {
+    if (pT2resume > pT2sel) {
       if      (dip.colType != 0)
-        pT2nextQCD(pT2begDip, pT2sel, dip, event);
+        pT2nextQCD(pT2resume, pT2sel, dip, event);
       else if (dip.chgType != 0 || dip.gamType != 0)
-        pT2nextQED(pT2begDip, pT2sel, dip, event);
+        pT2nextQED(pT2resume, pT2sel, dip, event);
       else if (dip.weakType != 0)
-        pT2nextWeak(pT2begDip, pT2sel, dip, event);
+        pT2nextWeak(pT2resume, pT2sel, dip, event);
       else if (dip.colvType != 0)
-        pT2nextHV(pT2begDip, pT2sel, dip, event);
-
-      // Update if found larger pT than current maximum.
-      if (dip.pT2 > pT2sel) {
-        pT2sel  = dip.pT2;
-        dipSel  = &dip;
-        iDipSel = iDip;
-        splittingNameSel = splittingNameNow;
-      }
+        pT2nextHV(pT2resume, pT2sel, dip, event);
+    }
+    if (useTrialCache)
+      storeTrial( dip, pT2begDip, min( pT2resume, pT2sel));
+
+    // Update if found larger pT than current maximum.
+    if (dip.pT2 > pT2sel) {
+      pT2sel  = dip.pT2;
+      dipSel  = &dip;
+      iDipSel = iDip;
+      splittingNameSel = splittingNameNow;
     }
   }
 
+  // The selected trial is used up, whether the branching is accepted
+  // or not, and the other trials remain valid below its scale.
+  if (dipSel != 0) dipSel->hasTrial = false;
+
   // Update the number of proposed timelike emissions.
   if (dipSel != 0 && nProposed.find(dipSel->system) != nProposed.end())
     ++nProposed[dipSel->system];
@@ -2149,6 +2207,123 @@ double SimpleTimeShower::pTnext( Event& event, double pTbegAll,
 
 //--------------------------------------------------------------------------
 
+// Check whether an entry is one of the hard partons or descends from one,
+// as Particle::isAncestor would find. The answer is stored for all entries
+// along the chain of unique mothers traced, so that each entry of the
+// event record is traced at most once per call of pTnext.
+
+bool SimpleTimeShower::isHardDescendant( const Event& event, int i) {
+
+  // Trace upwards until an entry with known answer is reached.
+  int sizeNow = event.size();
+  if (int(hardDescendant.size()) < sizeNow)
+    hardDescendant.resize( sizeNow, -1);
+  iChainHard.clear();
+  int iUp    = i;
+  int result = 0;
+  for ( ; ; ) {
+    if (iUp <= 0 || iUp >= sizeNow) break;
+    if (hardDescendant[iUp] >= 0) {
+      result = hardDescendant[iUp];
+      break;
+    }
+    iChainHard.push_back(iUp);
+    bool isHard = false;
+    for (int iHard = 0; iHard < int(hardPartons.size()); ++iHard)
+      if (iUp == hardPartons[iHard]) isHard = true;
+    if (isHard) {
+      result = 1;
+      break;
+    }
+
+    // Unique mother: move up the chain. Else trace as before.
+    int mother1 = event[iUp].mother1();
+    int mother2 = event[iUp].mother2();
+    if (mother2 == mother1 || mother2 == 0) {
+      iUp = mother1;
+      continue;
+    }
+    for (int iHard = 0; iHard < int(hardPartons.size()); ++iHard)
+      if (event[iUp].isAncestor(hardPartons[iHard])) result = 1;
+    break;
+  }
+
+  // Store the answer for the whole chain.
+  for (int j = 0; j < int(iChainHard.size()); ++j)
+    hardDescendant[iChainHard[j]] = result;
+  return (result == 1);
+
+}
+
+//--------------------------------------------------------------------------
+
+// Properties of a dipole end that its trial emissions depend on.
+
+void SimpleTimeShower::trialKey( const TimeDipoleEnd& dip, double* key)
+  const {
+
+  key[0]  = dip.iRadiator;
+  key[1]  = dip.iRecoiler;
+  key[2]  = dip.pTmax;
+  key[3]  = dip.colType;
+  key[4]  = dip.chgType;
+  key[5]  = dip.gamType;
+  key[6]  = dip.weakType;
+  key[7]  = dip.colvType;
+  key[8]  = dip.isrType;
+  key[9]  = dip.systemRec;
+  key[10] = dip.MEtype;
+  key[11] = (dip.isFlexible) ? dip.flexFactor : -1.;
+  key[12] = dip.m2Rad;
+  key[13] = dip.m2Dip;
+  key[14] = dip.m2DipCorr;
+  // Any change of the beams, also by another system, starts afresh.
+  key[15] = nBeamChange;
+
+}
+
+//--------------------------------------------------------------------------
+
+// Check whether the stored trial evolution of a dipole end can be reused.
+// By the Markovian nature of the evolution, a trial emission below the
+// new start scale is distributed as a new one would be, and a trial
+// evolution without emission can be continued from where it stopped,
+// if the dipole end is unchanged.
+
+bool SimpleTimeShower::hasValidTrial( const TimeDipoleEnd& dip,
+  double pT2begDip) const {
+
+  // The trial must have been found from at least the current start scale.
+  if (!dip.hasTrial || pT2begDip > dip.pT2begTrial) return false;
+
+  // The dipole end must be unchanged.
+  double key[TimeDipoleEnd::NKEYTRIAL];
+  trialKey( dip, key);
+  for (int i = 0; i < TimeDipoleEnd::NKEYTRIAL; ++i)
+    if (key[i] != dip.keyTrial[i]) return false;
+
+  // A trial emission must lie below the current start scale.
+  return (dip.pT2 < pT2begDip);
+
+}
+
+//--------------------------------------------------------------------------
+
+// Store the trial evolution of a dipole end, for later reuse. Without
+// a trial emission it is only conclusive down to the lower scale used.
+
+void SimpleTimeShower::storeTrial( TimeDipoleEnd& dip, double pT2begDip,
+  double pT2endDip) {
+
+  dip.hasTrial    = true;
+  dip.pT2begTrial = pT2begDip;
+  dip.pT2endTrial = pT2endDip;
+  trialKey( dip, dip.keyTrial);
+
+}
+
+//--------------------------------------------------------------------------
+
 // Function to directly extract the probability of no emission between two
 // scales. This function is not used in the Pythia core code, but can be used
 // by external programs to extract no-emission probabilities from Pythia.
@@ -2302,7 +2477,7 @@ double SimpleTimeShower::noEmissionProbability( double pTbegAll,
 
   // Calculate the value of the no-emssion probabilty.
   wt /= nTrials;
-  if (wt < settingsPtr->parm("Dire:Sudakov:Min")) wt = 0.;
+  if (wt < sudakovMin()) wt = 0.;
 
   // Clean up, done.
   beamAPtr->clear();
@@ -3833,6 +4008,7 @@ bool SimpleTimeShower::branch( Event& event, bool isInterleaved) {
     double xRec = 2. * pRec.e() / (beamAPtr->e() + beamBPtr->e());
     beamRec[iSysSelRec].iPos( iRec);
     beamRec[iSysSelRec].x( xRec);
+    ++nBeamChange;
     partonSystemsPtr->setSHat( iSysSelRec,
     partonSystemsPtr->getSHat(iSysSelRec) * xRec / xOld);
   }
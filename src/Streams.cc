@@ -123,6 +123,36 @@ int gzstreambuf::sync() {
     return 0;
 }
 
+//--------------------------------------------------------------------------
+
+// Positioning of an input stream, in the uncompressed data. Moving
+// forward decompresses the data in between, while moving backward
+// restarts from the beginning of the file. Only used for reading.
+
+std::streampos gzstreambuf::seekoff( std::streamoff off,
+    std::ios_base::seekdir way, std::ios_base::openmode) {
+    if ( ! (mode & std::ios::in) || ! opened)
+        return std::streampos( std::streamoff(-1));
+    std::streamoff cur = gztell( file) - (egptr() - gptr());
+    if ( way == std::ios_base::cur)
+        off += cur;
+    else if ( way == std::ios_base::end)
+        return std::streampos( std::streamoff(-1));
+    if ( off == cur)
+        return std::streampos( off);
+    if ( gzseek( file, off, SEEK_SET) < 0)
+        return std::streampos( std::streamoff(-1));
+    setg( buffer + 4, buffer + 4, buffer + 4);
+    return std::streampos( off);
+}
+
+//--------------------------------------------------------------------------
+
+std::streampos gzstreambuf::seekpos( std::streampos pos,
+    std::ios_base::openmode which) {
+    return seekoff( std::streamoff( pos), std::ios_base::beg, which);
+}
+
 //==========================================================================
 
 // The gzstreambase class.
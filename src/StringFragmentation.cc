@@ -1993,12 +1993,12 @@ bool StringFragmentation::fragmentToJunction(Event& event) {
 
   // Temporarily copy the partons on the low-energy legs, into the JRF,
   // in reverse order, so (anti)quark leg end first.
+  int iFirstCopy = event.size();
   vector<int> iPartonMin;
   iPartonMinLeg.clear();
   for (int i = legEnd[legMin]; i >= legBeg[legMin]; --i) {
     if (setVertices) iPartonMinLeg.push_back( iParton[i] );
     int iNew = event.append( event[ iParton[i] ] );
-    event[iNew].rotbst(MtoJRF);
     iPartonMin.push_back( iNew );
   }
   vector<int> iPartonMid;
@@ -2006,9 +2006,9 @@ bool StringFragmentation::fragmentToJunction(Event& event) {
   for (int i = legEnd[legMid]; i >= legBeg[legMid]; --i) {
     if (setVertices) iPartonMidLeg.push_back( iParton[i] );
     int iNew = event.append( event[ iParton[i] ] );
-    event[iNew].rotbst(MtoJRF);
     iPartonMid.push_back( iNew );
   }
+  event.rotbst( MtoJRF, iFirstCopy, event.size());
 
   // Find final weighted sum of momenta on each of the two legs.
   double eWeight = 0.;